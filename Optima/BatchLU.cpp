@@ -0,0 +1,385 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BatchLU.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+
+namespace Optima {
+namespace {
+
+//======================================================================
+// The kernels below operate on a group of W interleaved matrices, with
+// the W values of each entry stored contiguously. These W values are
+// operated on as a fixed-size Eigen array (one matrix per SIMD lane),
+// so that the arithmetic of the decomposition and solution is carried
+// out with vector instructions for the whole group. The pivots of the
+// full pivoting strategy differ from lane to lane, so only the row and
+// column swaps are performed one lane at a time.
+//======================================================================
+
+/// The values of one entry of a group of W interleaved matrices or vectors.
+template<int W>
+using Lanes = Eigen::Map<Eigen::Array<double, W, 1>>;
+
+/// The constant values of one entry of a group of W interleaved matrices or vectors.
+template<int W>
+using LanesConst = Eigen::Map<const Eigen::Array<double, W, 1>>;
+
+/// Return the number of matrices interleaved in each group for a batch of *m* matrices with dimension *n*.
+auto chooseLanes(Index m, Index n) -> Index
+{
+    // Prefer the widest group that the batch fills and whose matrices fit together in a typical L1 cache of 32 KiB
+    for(Index w : { 16, 8 })
+        if(m >= w && w*n*n*Index(sizeof(double)) <= 32*1024)
+            return w;
+    return 4;
+}
+
+/// Compute the LU decompositions with full pivoting of a group of W interleaved matrices with dimension *n*.
+/// The row and column transpositions are stored as in Eigen::FullPivLU (i.e., row *k* was swapped with row `rowt[k]`).
+template<int W>
+auto decomposeGroup(double* a, Index* rowt, Index* colt, Index n) -> void
+{
+    auto at = [&](Index i, Index j) { return a + (i + j*n)*W; };
+
+    Eigen::Array<double, W, 1> big, colmax, pivot, ukj;
+    Index jcol[W];
+
+    for(Index k = 0; k < n; ++k)
+    {
+        // Find the entry with largest magnitude in the bottom-right corner of each matrix, the first one in column-major order
+        // among ties as in Eigen::FullPivLU. The largest magnitudes along the columns are found with vector instructions, and
+        // only the position of the largest entry in the column that contains it is then found one lane at a time.
+        big.setConstant(-1.0);
+        for(int l = 0; l < W; ++l) jcol[l] = k;
+
+        for(Index j = k; j < n; ++j)
+        {
+            colmax = LanesConst<W>(at(k, j)).abs();
+            for(Index i = k + 1; i < n; ++i)
+                colmax = colmax.max(LanesConst<W>(at(i, j)).abs());
+            for(int l = 0; l < W; ++l)
+            {
+                if(colmax[l] > big[l])
+                {
+                    big[l] = colmax[l];
+                    jcol[l] = j;
+                }
+            }
+        }
+
+        // Swap rows and columns so that the pivot moves to the diagonal (no swaps if the rest of the matrix is zero)
+        for(int l = 0; l < W; ++l)
+        {
+            if(!(big[l] > 0.0))
+            {
+                rowt[k*W + l] = colt[k*W + l] = k;
+                continue;
+            }
+
+            const auto icol = jcol[l];
+            auto irow = k;
+            while(irow + 1 < n && std::abs(at(irow, icol)[l]) != big[l])
+                ++irow;
+
+            rowt[k*W + l] = irow;
+            colt[k*W + l] = icol;
+
+            if(irow != k)
+                for(Index j = 0; j < n; ++j)
+                    std::swap(at(k, j)[l], at(irow, j)[l]);
+
+            if(icol != k)
+                for(Index i = 0; i < n; ++i)
+                    std::swap(at(i, k)[l], at(i, icol)[l]);
+        }
+
+        // The remaining entries of a matrix with zero pivot are all zero and stay so if divided by one
+        const auto akk = at(k, k);
+        for(int l = 0; l < W; ++l)
+            pivot[l] = big[l] > 0.0 ? akk[l] : 1.0;
+
+        for(Index i = k + 1; i < n; ++i)
+            Lanes<W>(at(i, k)) /= pivot;
+
+        // Apply the rank-one update to the bottom-right corner of each matrix
+        for(Index j = k + 1; j < n; ++j)
+        {
+            ukj = Lanes<W>(at(k, j));
+            for(Index i = k + 1; i < n; ++i)
+                Lanes<W>(at(i, j)) -= Lanes<W>(at(i, k)) * ukj;
+        }
+    }
+}
+
+/// Solve the linear systems of a group of W interleaved matrices with dimension *n* decomposed with @ref decomposeGroup.
+/// The right-hand side vectors are given in *x*, interleaved in the same way, and are overwritten by the solution vectors.
+/// As in LU::solve, an equation whose pivot is negligible compared to its right-hand side is discarded, and its unknown set to zero.
+template<int W>
+auto solveGroup(const double* a, const Index* rowt, const Index* colt, Index n, double* x) -> void
+{
+    auto at = [&](Index i, Index j) { return a + (i + j*n)*W; };
+    auto xi = [&](Index i) { return x + i*W; };
+
+    const auto eps = std::numeric_limits<double>::epsilon();
+
+    // Compute P*b
+    for(Index k = 0; k < n; ++k)
+        for(int l = 0; l < W; ++l)
+            if(rowt[k*W + l] != k)
+                std::swap(xi(k)[l], xi(rowt[k*W + l])[l]);
+
+    Eigen::Array<double, W, 1> xj;
+
+    // Solve L*y = P*b, where L is unit lower triangular
+    for(Index j = 0; j < n; ++j)
+    {
+        xj = Lanes<W>(xi(j));
+        for(Index i = j + 1; i < n; ++i)
+            Lanes<W>(xi(i)) -= LanesConst<W>(at(i, j)) * xj;
+    }
+
+    // Solve U*z = y, discarding the linearly dependent equations (skipped if there is only one equation)
+    for(Index j = n - 1; j >= 0; --j)
+    {
+        const auto zj = xi(j);
+        const auto ajj = at(j, j);
+
+        for(int l = 0; l < W; ++l)
+        {
+            const auto discarded = n > 1 && std::abs(ajj[l]) <= eps * std::abs(zj[l]);
+            const auto zjl = zj[l] / ajj[l];
+            zj[l] = discarded ? 0.0 : zjl;
+        }
+
+        xj = Lanes<W>(zj);
+        for(Index i = 0; i < j; ++i)
+            Lanes<W>(xi(i)) -= LanesConst<W>(at(i, j)) * xj;
+    }
+
+    // Compute x = Q*z
+    for(Index k = n - 1; k >= 0; --k)
+        for(int l = 0; l < W; ++l)
+            if(colt[k*W + l] != k)
+                std::swap(xi(k)[l], xi(colt[k*W + l])[l]);
+}
+
+/// Solve the linear system of the matrix in lane *l* of a group of W interleaved matrices decomposed with @ref decomposeGroup.
+auto solveLane(const double* a, const Index* rowt, const Index* colt, Index n, Index W, Index l, VectorRef x) -> void
+{
+    auto at = [&](Index i, Index j) { return a[(i + j*n)*W + l]; };
+
+    const auto eps = std::numeric_limits<double>::epsilon();
+
+    for(Index k = 0; k < n; ++k)
+        std::swap(x[k], x[rowt[k*W + l]]);
+
+    for(Index j = 0; j < n; ++j)
+        for(Index i = j + 1; i < n; ++i)
+            x[i] -= at(i, j) * x[j];
+
+    for(Index j = n - 1; j >= 0; --j)
+    {
+        const auto discarded = n > 1 && std::abs(at(j, j)) <= eps * std::abs(x[j]);
+        x[j] = discarded ? 0.0 : x[j] / at(j, j);
+        for(Index i = 0; i < j; ++i)
+            x[i] -= at(i, j) * x[j];
+    }
+
+    for(Index k = n - 1; k >= 0; --k)
+        std::swap(x[k], x[colt[k*W + l]]);
+}
+
+} // namespace
+
+struct BatchLU::Impl
+{
+    /// The number of matrices in the batch.
+    Index m = 0;
+
+    /// The dimension of the matrices in the batch.
+    Index n = 0;
+
+    /// The number of matrices interleaved in each group (i.e., the number of SIMD lanes).
+    Index W = 4;
+
+    /// The lower and upper triangular factors of the matrices, interleaved in groups of W (padded with identity matrices).
+    Vector lu;
+
+    /// The row transpositions of the matrices, interleaved in groups of W.
+    Indices rowt;
+
+    /// The column transpositions of the matrices, interleaved in groups of W.
+    Indices colt;
+
+    /// Construct a default Impl object.
+    Impl()
+    {}
+
+    /// Return the number of groups of interleaved matrices.
+    auto numGroups() const -> Index
+    {
+        return (m + W - 1)/W;
+    }
+
+    /// Compute the LU decompositions of the given matrices.
+    auto decompose(MatrixView A) -> void
+    {
+        m = A.rows();
+        n = std::lround(std::sqrt(A.cols()));
+
+        errorif(n*n != A.cols(), "Expecting the matrices in the batch in flattened form with n*n columns, but got ", A.cols(), " columns.");
+
+        W = chooseLanes(m, n);
+
+        const auto nn = n*n;
+        const auto ngroups = numGroups();
+
+        lu.resize(ngroups*nn*W);
+        rowt.resize(ngroups*n*W);
+        colt.resize(ngroups*n*W);
+
+        // Interleave the matrices, padding the last group with identity matrices
+        for(Index g = 0; g < ngroups; ++g)
+            for(Index e = 0; e < nn; ++e)
+                for(Index l = 0; l < W; ++l)
+                {
+                    const auto k = g*W + l;
+                    lu[(g*nn + e)*W + l] = k < m ? A(k, e) : (e % (n + 1) == 0 ? 1.0 : 0.0);
+                }
+
+        for(Index g = 0; g < ngroups; ++g)
+        {
+            const auto a = lu.data() + g*nn*W;
+            const auto r = rowt.data() + g*n*W;
+            const auto c = colt.data() + g*n*W;
+            switch(W)
+            {
+            case 16: decomposeGroup<16>(a, r, c, n); break;
+            case 8:  decomposeGroup<8>(a, r, c, n); break;
+            default: decomposeGroup<4>(a, r, c, n); break;
+            }
+        }
+    }
+
+    /// Solve the linear systems of all matrices in the batch.
+    auto solve(MatrixRef X) const -> void
+    {
+        assert(X.rows() == m);
+        assert(X.cols() == n);
+
+        const auto nn = n*n;
+        const auto ngroups = numGroups();
+
+        Vector xw(n*W);
+
+        for(Index g = 0; g < ngroups; ++g)
+        {
+            const auto nlanes = std::min(W, m - g*W);
+
+            xw.fill(0.0);
+            for(Index i = 0; i < n; ++i)
+                for(Index l = 0; l < nlanes; ++l)
+                    xw[i*W + l] = X(g*W + l, i);
+
+            const auto a = lu.data() + g*nn*W;
+            const auto r = rowt.data() + g*n*W;
+            const auto c = colt.data() + g*n*W;
+            switch(W)
+            {
+            case 16: solveGroup<16>(a, r, c, n, xw.data()); break;
+            case 8:  solveGroup<8>(a, r, c, n, xw.data()); break;
+            default: solveGroup<4>(a, r, c, n, xw.data()); break;
+            }
+
+            for(Index i = 0; i < n; ++i)
+                for(Index l = 0; l < nlanes; ++l)
+                    X(g*W + l, i) = xw[i*W + l];
+        }
+    }
+
+    /// Solve the linear system of the k-th matrix in the batch.
+    auto solve(Index k, VectorRef x) const -> void
+    {
+        assert(k < m);
+        assert(x.rows() == n);
+
+        const auto g = k / W;
+        const auto l = k % W;
+        const auto nn = n*n;
+
+        solveLane(lu.data() + g*nn*W, rowt.data() + g*n*W, colt.data() + g*n*W, n, W, l, x);
+    }
+};
+
+BatchLU::BatchLU()
+: pimpl(new Impl())
+{}
+
+BatchLU::BatchLU(const BatchLU& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+BatchLU::~BatchLU()
+{}
+
+auto BatchLU::operator=(BatchLU other) -> BatchLU&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto BatchLU::empty() const -> bool
+{
+    return pimpl->m == 0;
+}
+
+auto BatchLU::size() const -> Index
+{
+    return pimpl->m;
+}
+
+auto BatchLU::dim() const -> Index
+{
+    return pimpl->n;
+}
+
+auto BatchLU::decompose(MatrixView A) -> void
+{
+    pimpl->decompose(A);
+}
+
+auto BatchLU::solve(MatrixRef X) const -> void
+{
+    pimpl->solve(X);
+}
+
+auto BatchLU::solve(Index k, VectorRef x) const -> void
+{
+    pimpl->solve(k, x);
+}
+
+} // namespace Optima
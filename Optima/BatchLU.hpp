@@ -0,0 +1,78 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// A class for the LU decompositions of many matrices with the same dimension computed together.
+/// The matrices are interleaved in groups of 4, 8 or 16 so that each one of them occupies a SIMD
+/// lane and the group is decomposed and solved with the same vector instructions. Each matrix is
+/// decomposed with full pivoting and its linear systems are solved exactly as with @ref LU.
+class BatchLU
+{
+public:
+    /// Construct a default BatchLU object.
+    BatchLU();
+
+    /// Construct a copy of a BatchLU object.
+    BatchLU(const BatchLU& other);
+
+    /// Destroy this BatchLU object.
+    virtual ~BatchLU();
+
+    /// Assign a BatchLU object to this.
+    auto operator=(BatchLU other) -> BatchLU&;
+
+    /// Return true if empty.
+    auto empty() const -> bool;
+
+    /// Return the number of matrices in the batch.
+    auto size() const -> Index;
+
+    /// Return the dimension of the matrices in the batch.
+    auto dim() const -> Index;
+
+    /// Compute the LU decompositions of the given matrices.
+    /// @param A The square matrices, one per row in flattened column-major order (i.e., entry *(i, j)* of the *k*-th matrix in `A(k, i + j*n)`).
+    auto decompose(MatrixView A) -> void;
+
+    /// Solve the linear systems `A*x = b` of all matrices in the batch using the LU decompositions obtained with @ref decompose.
+    /// @param[in,out] X As input, the right-hand side vectors *b*, one per row. As output, the solution vectors *x*.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solve(MatrixRef X) const -> void;
+
+    /// Solve the linear system `A*x = b` of the *k*-th matrix in the batch using its LU decomposition obtained with @ref decompose.
+    /// @param k The index of the matrix in the batch.
+    /// @param[in,out] x As input, vector *b*. As output, vector *x*.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solve(Index k, VectorRef x) const -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -0,0 +1,548 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BatchSolver.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/LinearSolverNullspaceBatch.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Sensitivity.hpp>
+#include <Optima/SensitivityBatch.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+#include <Optima/StateBatch.hpp>
+
+namespace Optima {
+namespace {
+
+/// Return the matrix stored in row *k* of a batch result in flattened column-major order.
+auto unflatten(const Matrix& M, Index k, Index rows, Index cols)
+{
+    return Eigen::Map<const Matrix, 0, Eigen::InnerStride<>>(M.data() + k, rows, cols, Eigen::InnerStride<>(M.rows()));
+}
+
+/// A pending evaluation of an objective function in a calculation of the batch.
+struct ObjectiveRequest
+{
+    Index iproblem;                ///< The index of the problem in the batch.
+    ObjectiveResultRef* res;       ///< The result of the evaluation.
+    const VectorView* x;           ///< The primal variables *x* of the evaluation.
+    const VectorView* p;           ///< The parameter variables *p* of the evaluation.
+    const VectorView* c;           ///< The sensitive parameter variables *c* of the evaluation.
+    const ObjectiveOptions* opts;  ///< The options of the evaluation.
+};
+
+/// A pending evaluation of a constraint function in a calculation of the batch.
+struct ConstraintRequest
+{
+    Index iproblem;                ///< The index of the problem in the batch.
+    ConstraintResultRef* res;      ///< The result of the evaluation.
+    const VectorView* x;           ///< The primal variables *x* of the evaluation.
+    const VectorView* p;           ///< The parameter variables *p* of the evaluation.
+    const VectorView* c;           ///< The sensitive parameter variables *c* of the evaluation.
+    const ConstraintOptions* opts; ///< The options of the evaluation.
+};
+
+/// A pending decomposition of a canonical matrix in a calculation of the batch.
+struct DecompositionRequest
+{
+    Index iproblem;                         ///< The index of the problem in the batch.
+    const CanonicalMatrix* M;               ///< The canonical matrix to be decomposed.
+    LinearSolverNullspaceBatchEntry* entry; ///< The decomposition of the canonical matrix in its batch.
+};
+
+/// Used to synchronize the calculations of the batch and evaluate their pending function evaluations and decompositions in batches.
+struct BatchEvaluator
+{
+    ObjectiveBatchFunction f;                ///< The batch function evaluating objective functions *f*.
+    ConstraintBatchFunction he;              ///< The batch function evaluating nonlinear equality constraint functions *he*.
+    ConstraintBatchFunction hg;              ///< The batch function evaluating nonlinear inequality constraint functions *hg*.
+    ConstraintBatchFunction v;               ///< The batch function evaluating external nonlinear constraint functions *v*.
+    std::mutex mutex;                        ///< The mutex protecting the pending requests and counters below.
+    std::condition_variable cvcoordinator;   ///< Used to wake the coordinator when a calculation waits or finishes.
+    std::condition_variable cvworkers;       ///< Used to wake the calculations when their requests have been evaluated.
+    Index nactive = 0;                       ///< The number of unfinished calculations.
+    Index nwaiting = 0;                      ///< The number of calculations waiting for their requests to be evaluated.
+    Index round = 0;                         ///< The number of batches of requests evaluated so far.
+    std::vector<ObjectiveRequest> frequests; ///< The pending evaluations of *f*.
+    std::vector<ConstraintRequest> herequests; ///< The pending evaluations of *he*.
+    std::vector<ConstraintRequest> hgrequests; ///< The pending evaluations of *hg*.
+    std::vector<ConstraintRequest> vrequests;  ///< The pending evaluations of *v*.
+    std::vector<DecompositionRequest> drequests; ///< The pending decompositions of canonical matrices.
+    Matrix X;                                ///< The primal variables *x* of the pending evaluations in structure-of-arrays layout.
+    Matrix P;                                ///< The parameter variables *p* of the pending evaluations in structure-of-arrays layout.
+    Matrix C;                                ///< The sensitive parameter variables *c* of the pending evaluations in structure-of-arrays layout.
+    ObjectiveBatchResult fres;               ///< The results of the batch evaluations of *f*.
+    ConstraintBatchResult hres;              ///< The results of the batch evaluations of *he*, *hg*, or *v*.
+    ObjectiveBatchOptions fopts;             ///< The options of the batch evaluations of *f*.
+    ConstraintBatchOptions hopts;            ///< The options of the batch evaluations of *he*, *hg*, or *v*.
+    std::exception_ptr error;                ///< The first exception thrown while evaluating the pending requests.
+
+    /// Add a pending evaluation and wait until it has been evaluated (called from the calculations).
+    /// The calculation is interrupted with an exception if an error has occurred in the meantime.
+    template<typename Request>
+    auto submit(std::vector<Request>& requests, const Request& request) -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        errorif(error, "The calculation was interrupted because of an error in the batch.");
+        requests.push_back(request);
+        ++nwaiting;
+        const auto current = round;
+        cvcoordinator.notify_one();
+        cvworkers.wait(lock, [&] { return round != current; });
+        errorif(error, "The calculation was interrupted because of an error in the batch.");
+    }
+
+    /// Register the end of a calculation (called from the calculations).
+    auto leave() -> void
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        --nactive;
+        cvcoordinator.notify_one();
+    }
+
+    /// Register calculations that could not be started and interrupt the others (called from the coordinator).
+    auto abandon(Index count, std::exception_ptr reason) -> void
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        nactive -= count;
+        if(!error) error = reason;
+    }
+
+    /// Evaluate the pending requests in batches until all calculations have finished (called from the coordinator).
+    auto run() -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            cvcoordinator.wait(lock, [&] { return nwaiting == nactive; });
+            if(nactive == 0)
+                return;
+            if(!error)
+            {
+                try
+                {
+                    evaluate(frequests);
+                    evaluate(herequests, he);
+                    evaluate(hgrequests, hg);
+                    evaluate(vrequests, v);
+                    decompose(drequests);
+                }
+                catch(...) { error = std::current_exception(); }
+            }
+            frequests.clear();
+            herequests.clear();
+            hgrequests.clear();
+            vrequests.clear();
+            drequests.clear();
+            nwaiting = 0;
+            ++round;
+            cvworkers.notify_all();
+        }
+    }
+
+    /// Gather the variables of the pending requests in the structure-of-arrays buffers *X*, *P*, *C*.
+    template<typename Request>
+    auto gather(std::vector<Request>& requests, Indices& iproblems, std::vector<Indices>& ibasicvars) -> void
+    {
+        // Sort the requests so that the rows of the batch do not depend on the order in which the calculations arrived
+        std::sort(requests.begin(), requests.end(), [](const auto& l, const auto& r) { return l.iproblem < r.iproblem; });
+
+        const auto n = requests.size();
+        X.resize(n, requests[0].x->size());
+        P.resize(n, requests[0].p->size());
+        C.resize(n, requests[0].c->size());
+        iproblems.resize(n);
+        ibasicvars.resize(n);
+
+        for(auto k = 0U; k < n; ++k)
+        {
+            const auto& request = requests[k];
+            X.row(k) = request.x->transpose();
+            P.row(k) = request.p->transpose();
+            C.row(k) = request.c->transpose();
+            iproblems[k] = request.iproblem;
+            ibasicvars[k] = request.opts->ibasicvars;
+        }
+    }
+
+    /// Evaluate the pending requests of the objective function with one call to the batch function.
+    auto evaluate(std::vector<ObjectiveRequest>& requests) -> void
+    {
+        if(requests.empty())
+            return;
+
+        gather(requests, fopts.iproblems, fopts.ibasicvars);
+
+        fopts.eval = { false, false, false };
+        for(const auto& request : requests)
+        {
+            fopts.eval.fxx = fopts.eval.fxx || request.opts->eval.fxx;
+            fopts.eval.fxp = fopts.eval.fxp || request.opts->eval.fxp;
+            fopts.eval.fxc = fopts.eval.fxc || request.opts->eval.fxc;
+        }
+
+        const auto n = requests.size();
+        const auto nx = X.cols();
+        const auto np = P.cols();
+        const auto nc = C.cols();
+
+        try { f(fres, X, P, C, fopts); }
+        catch(...)
+        {
+            if(!error) error = std::current_exception();
+            fres.succeeded.assign(n, false);
+        }
+
+        // Scatter the results, keeping the derivatives not requested unchanged
+        for(auto k = 0U; k < n; ++k)
+        {
+            const auto& request = requests[k];
+            const auto& eval = request.opts->eval;
+            auto& res = *request.res;
+            res.f = fres.f[k];
+            res.fx = fres.fx.row(k).transpose();
+            if(eval.fxx && nx) res.fxx = unflatten(fres.fxx, k, nx, nx);
+            if(eval.fxp && np) res.fxp = unflatten(fres.fxp, k, nx, np);
+            if(eval.fxc && nc) res.fxc = unflatten(fres.fxc, k, nx, nc);
+            if(eval.fxx) res.diagfxx = fres.diagfxx;
+            if(eval.fxx) res.fxx4basicvars = fres.fxx4basicvars;
+            res.succeeded = fres.succeeded[k];
+        }
+
+        requests.clear();
+    }
+
+    /// Evaluate the pending requests of a constraint function with one call to its batch function.
+    auto evaluate(std::vector<ConstraintRequest>& requests, const ConstraintBatchFunction& q) -> void
+    {
+        if(requests.empty())
+            return;
+
+        gather(requests, hopts.iproblems, hopts.ibasicvars);
+
+        hopts.eval = { false, false, false };
+        for(const auto& request : requests)
+        {
+            hopts.eval.ddx = hopts.eval.ddx || request.opts->eval.ddx;
+            hopts.eval.ddp = hopts.eval.ddp || request.opts->eval.ddp;
+            hopts.eval.ddc = hopts.eval.ddc || request.opts->eval.ddc;
+        }
+
+        const auto n = requests.size();
+        const auto nq = requests[0].res->val.size();
+        const auto nx = X.cols();
+        const auto np = P.cols();
+        const auto nc = C.cols();
+
+        try { q(hres, nq, X, P, C, hopts); }
+        catch(...)
+        {
+            if(!error) error = std::current_exception();
+            hres.succeeded.assign(n, false);
+        }
+
+        // Scatter the results, keeping the derivatives not requested unchanged
+        for(auto k = 0U; k < n; ++k)
+        {
+            const auto& request = requests[k];
+            const auto& eval = request.opts->eval;
+            auto& res = *request.res;
+            res.val = hres.val.row(k).transpose();
+            if(eval.ddx && nx) res.ddx = unflatten(hres.ddx, k, nq, nx);
+            if(eval.ddp && np) res.ddp = unflatten(hres.ddp, k, nq, np);
+            if(eval.ddc && nc) res.ddc = unflatten(hres.ddc, k, nq, nc);
+            if(eval.ddx) res.ddx4basicvars = hres.ddx4basicvars;
+            res.succeeded = hres.succeeded[k];
+        }
+
+        requests.clear();
+    }
+
+    /// Decompose the pending canonical matrices together with those of same dimensions.
+    auto decompose(std::vector<DecompositionRequest>& requests) -> void
+    {
+        if(requests.empty())
+            return;
+
+        auto samedims = [](const CanonicalDims& l, const CanonicalDims& r)
+        {
+            return l.ns == r.ns && l.np == r.np && l.nbe == r.nbe && l.nbi == r.nbi && l.nns == r.nns;
+        };
+
+        // Sort the requests so that the batches do not depend on the order in which the calculations arrived
+        std::sort(requests.begin(), requests.end(), [](const auto& l, const auto& r) { return l.iproblem < r.iproblem; });
+
+        std::vector<bool> done(requests.size(), false);
+        std::vector<CanonicalMatrix> Ms;
+        std::vector<DecompositionRequest*> group;
+
+        for(auto i = 0U; i < requests.size(); ++i)
+        {
+            if(done[i])
+                continue;
+
+            Ms.clear();
+            group.clear();
+
+            for(auto j = i; j < requests.size(); ++j)
+            {
+                if(!done[j] && samedims(requests[j].M->dims, requests[i].M->dims))
+                {
+                    Ms.push_back(*requests[j].M);
+                    group.push_back(&requests[j]);
+                    done[j] = true;
+                }
+            }
+
+            // A canonical matrix left without a batch is decomposed by its calculation on its own
+            try
+            {
+                auto batch = std::make_shared<LinearSolverNullspaceBatch>();
+                batch->decompose(Ms);
+                for(auto k = 0U; k < group.size(); ++k)
+                    *group[k]->entry = { batch, Index(k) };
+            }
+            catch(...) {}
+        }
+
+        requests.clear();
+    }
+};
+
+} // namespace
+
+struct BatchSolver::Impl
+{
+    Options options;            ///< The options for the optimization calculations.
+    ObjectiveBatchFunction f;   ///< The batch function used instead of the objective function of each problem.
+    ConstraintBatchFunction he; ///< The batch function used instead of the nonlinear equality constraint function of each problem.
+    ConstraintBatchFunction hg; ///< The batch function used instead of the nonlinear inequality constraint function of each problem.
+    ConstraintBatchFunction v;  ///< The batch function used instead of the external nonlinear constraint function of each problem.
+
+    Impl()
+    {}
+
+    /// Initialize the problem of a calculation in the batch with its functions replaced by requests to the evaluator.
+    auto initProblem(Problem& problem, const Problem& other, Index iproblem, BatchEvaluator& evaluator) const -> void
+    {
+        problem = other;
+        problem.r  = other.r;
+        problem.f  = other.f;
+        problem.he = other.he;
+        problem.hg = other.hg;
+        problem.v  = other.v;
+
+        if(f.initialized())
+        {
+            problem.f = [&evaluator, iproblem](ObjectiveResultRef res, VectorView x, VectorView p, VectorView c, ObjectiveOptions opts)
+            {
+                evaluator.submit(evaluator.frequests, ObjectiveRequest{ iproblem, &res, &x, &p, &c, &opts });
+            };
+            problem.f.setConstantHessian(other.f.constantHessian());
+            if(other.f.blockDiagonalHessian()) problem.f.setBlocksHessian(other.f.blocksHessian());
+        }
+
+        auto replace = [&](ConstraintFunction& q, const ConstraintFunction& qother, std::vector<ConstraintRequest>& requests)
+        {
+            q = [&evaluator, &requests, iproblem](ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts)
+            {
+                evaluator.submit(requests, ConstraintRequest{ iproblem, &res, &x, &p, &c, &opts });
+            };
+            if(qother.sparseDdx()) q.setNonZeroColumnsDdx(qother.nonZeroColumnsDdx());
+            q.setConstantDerivatives(qother.constantDerivatives());
+        };
+
+        if(he.initialized() && other.dims.he) replace(problem.he, other.he, evaluator.herequests);
+        if(hg.initialized() && other.dims.hg) replace(problem.hg, other.hg, evaluator.hgrequests);
+        if(v.initialized() && other.dims.p) replace(problem.v, other.v, evaluator.vrequests);
+    }
+
+    /// Return the function that replaces the decompositions of the canonical matrices of a calculation in the batch by requests to the evaluator.
+    auto initDecomposition(Index iproblem, BatchEvaluator& evaluator) const -> LinearSolverNullspaceBatchFunction
+    {
+        return [&evaluator, iproblem](CanonicalMatrix M)
+        {
+            LinearSolverNullspaceBatchEntry entry;
+            evaluator.submit(evaluator.drequests, DecompositionRequest{ iproblem, &M, &entry });
+            return entry;
+        };
+    }
+
+    /// Solve the batch of optimization problems with states in a std::vector<State> or StateBatch object.
+    template<typename States, typename Sensitivities>
+    auto solve(const std::vector<Problem>& problems, States& states, Sensitivities* sensitivities) -> std::vector<Result>
+    {
+        const auto nproblems = problems.size();
+
+        errorif(std::size_t(states.size()) != nproblems, "Expecting as many states as problems in the batch, but got ", states.size(), " states and ", nproblems, " problems.");
+        errorif(sensitivities && std::size_t(sensitivities->size()) != nproblems, "Expecting as many sensitivities as problems in the batch, but got ", sensitivities->size(), " sensitivities and ", nproblems, " problems.");
+
+        for(const auto& problem : problems)
+        {
+            const auto& dims = problems[0].dims;
+            errorif(problem.dims.x != dims.x || problem.dims.p != dims.p || problem.dims.c != dims.c ||
+                problem.dims.he != dims.he || problem.dims.hg != dims.hg,
+                    "Expecting problems with the same dimensions in the batch.");
+        }
+
+        // Every calculation must evaluate its functions from its own thread only
+        auto opts = options;
+        opts.decomposer.threads = 1;
+        opts.linesearch.parallel_trials = 0;
+
+        errorif(options.batch.width == 0, "Expecting a positive batch width in options.batch.width.");
+
+        std::vector<Result> results(nproblems);
+        std::vector<std::exception_ptr> errors(nproblems);
+
+        // Solve the problems in consecutive waves of at most options.batch.width calculations in lockstep
+        const std::size_t width = options.batch.width;
+
+        for(std::size_t kbegin = 0; kbegin < nproblems; kbegin += width)
+        {
+            const auto kend = std::min(kbegin + width, nproblems);
+
+            BatchEvaluator evaluator;
+            evaluator.f = f;
+            evaluator.he = he;
+            evaluator.hg = hg;
+            evaluator.v = v;
+            evaluator.nactive = kend - kbegin;
+
+            auto solve = [&](Index k)
+            {
+                // The canonical matrices are decomposed in batches only in the thread of the calculation and while it runs
+                threadNullspaceBatchFunction() = initDecomposition(k, evaluator);
+                try
+                {
+                    Problem problem(problems[k].dims);
+                    initProblem(problem, problems[k], k, evaluator);
+                    Solver solver;
+                    solver.setOptions(opts);
+                    results[k] = sensitivities ?
+                        solver.solve(problem, states[k], (*sensitivities)[k]) :
+                        solver.solve(problem, states[k]);
+                }
+                catch(...) { errors[k] = std::current_exception(); }
+                threadNullspaceBatchFunction() = nullptr;
+                evaluator.leave();
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(kend - kbegin);
+
+            // The calculations already started must finish and be joined even if starting another one fails
+            try
+            {
+                for(auto k = kbegin; k < kend; ++k)
+                    workers.emplace_back(solve, k);
+            }
+            catch(...)
+            {
+                evaluator.abandon(kend - kbegin - workers.size(), std::current_exception());
+            }
+
+            evaluator.run();
+
+            for(auto& worker : workers)
+                worker.join();
+
+            if(evaluator.error)
+                std::rethrow_exception(evaluator.error);
+            for(auto k = kbegin; k < kend; ++k)
+                if(errors[k]) std::rethrow_exception(errors[k]);
+        }
+
+        return results;
+    }
+};
+
+BatchSolver::BatchSolver()
+: pimpl(new Impl())
+{}
+
+BatchSolver::BatchSolver(const BatchSolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+BatchSolver::~BatchSolver()
+{}
+
+auto BatchSolver::operator=(BatchSolver other) -> BatchSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto BatchSolver::setOptions(const Options& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto BatchSolver::setObjectiveFunction(const ObjectiveBatchFunction& f) -> void
+{
+    pimpl->f = f;
+}
+
+auto BatchSolver::setEqualityConstraintFunction(const ConstraintBatchFunction& he) -> void
+{
+    pimpl->he = he;
+}
+
+auto BatchSolver::setInequalityConstraintFunction(const ConstraintBatchFunction& hg) -> void
+{
+    pimpl->hg = hg;
+}
+
+auto BatchSolver::setExternalConstraintFunction(const ConstraintBatchFunction& v) -> void
+{
+    pimpl->v = v;
+}
+
+auto BatchSolver::solve(const std::vector<Problem>& problems, std::vector<State>& states) -> std::vector<Result>
+{
+    return pimpl->solve(problems, states, static_cast<std::vector<Sensitivity>*>(nullptr));
+}
+
+auto BatchSolver::solve(const std::vector<Problem>& problems, std::vector<State>& states, std::vector<Sensitivity>& sensitivities) -> std::vector<Result>
+{
+    return pimpl->solve(problems, states, &sensitivities);
+}
+
+auto BatchSolver::solve(const std::vector<Problem>& problems, StateBatch& states) -> std::vector<Result>
+{
+    return pimpl->solve(problems, states, static_cast<SensitivityBatch*>(nullptr));
+}
+
+auto BatchSolver::solve(const std::vector<Problem>& problems, StateBatch& states, SensitivityBatch& sensitivities) -> std::vector<Result>
+{
+    return pimpl->solve(problems, states, &sensitivities);
+}
+
+} // namespace Optima
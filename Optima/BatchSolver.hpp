@@ -0,0 +1,108 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// Optima includes
+#include <Optima/ConstraintBatchFunction.hpp>
+#include <Optima/ObjectiveBatchFunction.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Options;
+class Problem;
+class Result;
+class Sensitivity;
+class SensitivityBatch;
+class State;
+class StateBatch;
+
+/// The solver for a batch of independent optimization problems whose functions are evaluated in batches.
+/// The problems are solved in lockstep, each on its own thread, in consecutive waves of at most
+/// BatchOptions::width problems (see Options::batch). Whenever a calculation needs to
+/// evaluate a function for which a batch function has been set, it waits until every other
+/// unfinished calculation also needs a function evaluation. The pending evaluations are then
+/// gathered in structure-of-arrays buffers, evaluated with one call to the corresponding batch
+/// function, and their results scattered back to each calculation. Functions without a batch
+/// counterpart are evaluated with the functions of each problem as usual.
+///
+/// The Newton steps of the calculations are synchronized in the same way when using the
+/// linear solver method @ref LinearSolverMethod::Nullspace: the canonical matrices pending
+/// decomposition whose dimensions are the same are decomposed together with
+/// LinearSolverNullspaceBatch, one calculation per SIMD lane.
+///
+/// All problems must have the same dimensions. The declarations made on the functions of each
+/// problem (e.g., constant Hessian, non-zero columns of `ddx`) are kept when their batch
+/// counterparts are used. Since every calculation runs on a single thread, the concurrent
+/// solution of decomposed blocks and the concurrent line search trials are disabled.
+///
+/// If a batch function throws an exception, the unfinished calculations are interrupted
+/// and the exception is rethrown once all of them have stopped.
+class BatchSolver
+{
+public:
+    /// Construct a default BatchSolver instance.
+    BatchSolver();
+
+    /// Construct a copy of a BatchSolver instance.
+    BatchSolver(const BatchSolver& other);
+
+    /// Destroy this BatchSolver instance.
+    virtual ~BatchSolver();
+
+    /// Assign a BatchSolver instance to this.
+    auto operator=(BatchSolver other) -> BatchSolver&;
+
+    /// Set the options for the optimization calculations.
+    auto setOptions(const Options& options) -> void;
+
+    /// Set the batch function used instead of the objective function *f* of each problem.
+    auto setObjectiveFunction(const ObjectiveBatchFunction& f) -> void;
+
+    /// Set the batch function used instead of the nonlinear equality constraint function *he* of each problem.
+    auto setEqualityConstraintFunction(const ConstraintBatchFunction& he) -> void;
+
+    /// Set the batch function used instead of the nonlinear inequality constraint function *hg* of each problem.
+    auto setInequalityConstraintFunction(const ConstraintBatchFunction& hg) -> void;
+
+    /// Set the batch function used instead of the external nonlinear constraint function *v* of each problem.
+    auto setExternalConstraintFunction(const ConstraintBatchFunction& v) -> void;
+
+    /// Solve the batch of optimization problems.
+    auto solve(const std::vector<Problem>& problems, std::vector<State>& states) -> std::vector<Result>;
+
+    /// Solve the batch of optimization problems and compute the sensitivity derivatives at the end.
+    auto solve(const std::vector<Problem>& problems, std::vector<State>& states, std::vector<Sensitivity>& sensitivities) -> std::vector<Result>;
+
+    /// Solve the batch of optimization problems with their states in the cells of a StateBatch object.
+    auto solve(const std::vector<Problem>& problems, StateBatch& states) -> std::vector<Result>;
+
+    /// Solve the batch of optimization problems with their states and sensitivity derivatives in the cells of StateBatch and SensitivityBatch objects.
+    auto solve(const std::vector<Problem>& problems, StateBatch& states, SensitivityBatch& sensitivities) -> std::vector<Result>;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -0,0 +1,184 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BatchStorage.hpp"
+
+// C++ includes
+#include <fstream>
+#include <vector>
+
+// POSIX includes
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Optima includes
+#include <Optima/Exception.hpp>
+
+namespace Optima {
+
+struct BatchStorage::Impl
+{
+    std::vector<char> buffer; ///< The buffer of the storage if in memory.
+    char* mapping = nullptr;  ///< The beginning of the memory-mapped file if mapped.
+    std::size_t nbytes = 0;   ///< The number of bytes of the storage.
+
+    Impl()
+    {}
+
+    Impl(std::size_t bytes)
+    : buffer(bytes, 0), nbytes(bytes)
+    {}
+
+    Impl(std::size_t bytes, const std::string& filename)
+    : nbytes(bytes)
+    {
+#ifdef _WIN32
+        errorif(true, "Cannot map file `", filename, "` in memory. Memory-mapped batch containers are not supported on Windows.");
+#else
+        const auto fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+        errorif(fd < 0, "Could not open file `", filename, "` to be mapped in memory.");
+
+        struct stat info;
+        const auto statfailed = ::fstat(fd, &info) != 0;
+        const auto size = statfailed ? 0 : static_cast<std::size_t>(info.st_size);
+
+        if(statfailed || (size != 0 && size != bytes))
+        {
+            ::close(fd);
+            errorif(statfailed, "Could not determine the size of file `", filename, "`.");
+            errorif(true, "Expecting file `", filename, "` with ", bytes, " bytes to be mapped in memory, but it has ", size, " bytes.");
+        }
+
+        if(size == 0 && bytes != 0 && ::ftruncate(fd, bytes) != 0) // a new file is filled with zeros
+        {
+            ::close(fd);
+            errorif(true, "Could not resize file `", filename, "` to ", bytes, " bytes.");
+        }
+
+        if(bytes != 0)
+        {
+            auto addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd); // the mapping remains valid after the file descriptor is closed
+            errorif(addr == MAP_FAILED, "Could not map file `", filename, "` in memory.");
+            mapping = static_cast<char*>(addr);
+        }
+        else ::close(fd);
+#endif
+    }
+
+    Impl(const Impl& other)
+    : buffer(other.data(), other.data() + other.nbytes), nbytes(other.nbytes)
+    {}
+
+    ~Impl()
+    {
+#ifndef _WIN32
+        if(mapping)
+        {
+            ::msync(mapping, nbytes, MS_SYNC);
+            ::munmap(mapping, nbytes);
+        }
+#endif
+    }
+
+    auto data() -> char*
+    {
+        return mapping ? mapping : buffer.data();
+    }
+
+    auto data() const -> const char*
+    {
+        return mapping ? mapping : buffer.data();
+    }
+
+    auto flush() -> void
+    {
+#ifndef _WIN32
+        if(mapping)
+            errorif(::msync(mapping, nbytes, MS_SYNC) != 0, "Could not write the memory-mapped storage to its file.");
+#endif
+    }
+
+    auto save(const std::string& filename) const -> void
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        errorif(!file, "Could not open file `", filename, "` for writing.");
+        file.write(data(), nbytes);
+        errorif(!file, "Could not write ", nbytes, " bytes to file `", filename, "`.");
+    }
+};
+
+BatchStorage::BatchStorage()
+: pimpl(new Impl())
+{}
+
+BatchStorage::BatchStorage(std::size_t bytes)
+: pimpl(new Impl(bytes))
+{}
+
+BatchStorage::BatchStorage(std::size_t bytes, const std::string& filename)
+: pimpl(new Impl(bytes, filename))
+{}
+
+BatchStorage::BatchStorage(const BatchStorage& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+BatchStorage::~BatchStorage()
+{}
+
+auto BatchStorage::operator=(BatchStorage other) -> BatchStorage&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto BatchStorage::data() -> char*
+{
+    return pimpl->data();
+}
+
+auto BatchStorage::data() const -> const char*
+{
+    return pimpl->data();
+}
+
+auto BatchStorage::bytes() const -> std::size_t
+{
+    return pimpl->nbytes;
+}
+
+auto BatchStorage::mapped() const -> bool
+{
+    return pimpl->mapping != nullptr;
+}
+
+auto BatchStorage::flush() -> void
+{
+    pimpl->flush();
+}
+
+auto BatchStorage::save(const std::string& filename) const -> void
+{
+    pimpl->save(filename);
+}
+
+} // namespace Optima
@@ -0,0 +1,78 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+#include <string>
+
+namespace Optima {
+
+/// Used to allocate the contiguous memory of a batch container, optionally backed by a memory-mapped file.
+/// A batch container stores all its fields in a single buffer, so that saving this buffer to a file
+/// is a single write, and a file created this way can be mapped later to resume from its contents.
+class BatchStorage
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a default BatchStorage object.
+    BatchStorage();
+
+    /// Construct a BatchStorage object with given number of bytes in memory, initialized with zeros.
+    explicit BatchStorage(std::size_t bytes);
+
+    /// Construct a BatchStorage object with given number of bytes backed by a memory-mapped file.
+    /// The file is created and filled with zeros if it does not exist. Otherwise, it must have the given
+    /// number of bytes and its contents are kept. Memory-mapped files are not supported on Windows.
+    /// @param bytes The number of bytes of the storage.
+    /// @param filename The path to the file mapped in memory.
+    BatchStorage(std::size_t bytes, const std::string& filename);
+
+    /// Construct a copy of a BatchStorage object (the copy is always in memory).
+    BatchStorage(const BatchStorage& other);
+
+    /// Destroy this BatchStorage object (a memory-mapped file is synchronized and unmapped).
+    virtual ~BatchStorage();
+
+    /// Assign a BatchStorage object to this.
+    auto operator=(BatchStorage other) -> BatchStorage&;
+
+    /// Return the pointer to the beginning of the storage.
+    auto data() -> char*;
+
+    /// Return the pointer to the beginning of the storage.
+    auto data() const -> const char*;
+
+    /// Return the number of bytes of the storage.
+    auto bytes() const -> std::size_t;
+
+    /// Return `true` if the storage is backed by a memory-mapped file.
+    auto mapped() const -> bool;
+
+    /// Write the modified contents of a memory-mapped storage to its file (no effect if in memory).
+    auto flush() -> void;
+
+    /// Save the contents of the storage to a file with a single write.
+    auto save(const std::string& filename) const -> void;
+};
+
+} // namespace Optima
@@ -0,0 +1,52 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <atomic>
+#include <memory>
+
+namespace Optima {
+
+/// Used to request the cooperative cancellation of optimization calculations.
+/// Copies of a CancellationToken object share the same state, so that a copy
+/// kept by the caller (e.g., in another thread) can cancel the calculations
+/// performed with the copies in Options. The cancellation is checked once
+/// per iteration.
+class CancellationToken
+{
+public:
+    /// Construct a default CancellationToken object.
+    CancellationToken()
+    : state(std::make_shared<std::atomic<bool>>(false)) {}
+
+    /// Request the cancellation of the optimization calculations using this token.
+    auto cancel() -> void { state->store(true); }
+
+    /// Clear a previous cancellation request so that this token can be used in new calculations.
+    auto reset() -> void { state->store(false); }
+
+    /// Return `true` if the cancellation of the optimization calculations has been requested.
+    auto cancelled() const -> bool { return state->load(); }
+
+private:
+    /// The cancellation state shared among the copies of this token.
+    std::shared_ptr<std::atomic<bool>> state;
+};
+
+} // namespace Optima
@@ -42,6 +42,8 @@ struct CanonicalMatrix
     IndicesView jn;     ///< The indices of the non-basic variables ordered as jn = (jns, jnu).
     IndicesView js;     ///< The indices of the stable variables ordered as js = (jbs, jns).
     IndicesView ju;     ///< The indices of the unstable variables ordered as ju = (jbu, jnu).
+    bool isHss4BasicVars = false; ///< The flag that indicates wether Hss is non-zero only on columns of basic variables (i.e., Hbsns = 0 and Hnsns = 0).
+    bool isHssDiagonal = false;   ///< The flag that indicates wether Hss is diagonal (i.e., Hxx is diagonal).
 };
 
 } // namespace Optima
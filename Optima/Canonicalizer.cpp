@@ -56,10 +56,11 @@ struct Canonicalizer::Impl
 
     Matrix Hprime;      ///< The matrix H' = [Hss Hsp].
     Matrix Vprime;      ///< The matrix V' = [Vps Vpu Vpp].
-    Matrix Wprime;      ///< The matrix W' = [Ws Wu Wp] = [As Au Ap; Js Ju Jp].
 
     bool diagHxx = false; ///< The flag indicating whether Hxx is diagonal.
 
+    bool Hxx4basicvars = false; ///< The flag indicating whether Hxx is non-zero only on columns corresponding to basic variables.
+
     Impl()
     {}
 
@@ -76,7 +77,6 @@ struct Canonicalizer::Impl
 
         const auto H   = M.H;
         const auto V   = M.V;
-        const auto W   = M.W;
         const auto RWQ = M.RWQ;
         const auto ju0 = M.ju;
 
@@ -92,18 +92,10 @@ struct Canonicalizer::Impl
         nl = nw - nb;
 
         //======================================================================
-        // Initialize matrices R, Sbn, Sbp and indices of variables jbn
+        // Initialize indices of variables jbn (matrices R, Sbn, Sbp are
+        // assembled further below, once their final ordering is known)
         //======================================================================
 
-        S.resize(nw, nx + np);
-        auto Sbn = S.topLeftCorner(nb, nn);
-        auto Sbp = S.topRightCorner(nb, np);
-
-        R = RWQ.R;
-
-        Sbn = RWQ.Sbn;
-        Sbp = RWQ.Sbp;
-
         jbn.resize(nx);
         jbn << RWQ.jb, RWQ.jn; // the indices of the variables ordered as x = (xb, xn), but xb and xn not yet properly sorted
 
@@ -161,7 +153,7 @@ struct Canonicalizer::Impl
         {
             const auto idx = jn[k];                     // the global index of the k-th non-basic variable
             const auto Hkk = Hd[idx];                   // the corresponding diagonal entry in the H matrix
-            const auto a1 = norminf(Sbn.col(k));        // the max value along the corresponding column of the Sbn matrix
+            const auto a1 = norminf(RWQ.Sbn.col(k));    // the max value along the corresponding column of the Sbn matrix
             const auto a2 = norminf(V.Vpx.col(idx));    // the max value along the corresponding column of the Vpx matrix
             return abs(Hkk) >= std::max(a1, a2);        // return true if diagonal entry is dominant with respect to Vpx and Sbn only (not Hxx!)
         };
@@ -174,14 +166,20 @@ struct Canonicalizer::Impl
         nni = nns - nne;
 
         //======================================================================
-        // Apply permutation to R, Sbn, Sbp and indices of variables jbn
+        // Assemble R, Sbn, Sbp with permuted rows and columns (in a single
+        // pass, instead of copying and then permuting them) and apply
+        // permutation to indices of variables jbn
         //======================================================================
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Sbn);
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Sbp);
+        using Eigen::all;
+
+        S.resize(nw, nx + np);
+        auto Sbn = S.topLeftCorner(nb, nn);
+        auto Sbp = S.topRightCorner(nb, np);
 
-        Kn.asPermutation().applyThisOnTheRight(Sbn);
+        Sbn = RWQ.Sbn(Kb, Kn);
+        Sbp = RWQ.Sbp(Kb, all);
 
-        Kb.asPermutation().transpose().applyThisOnTheLeft(R);
+        R = RWQ.R(Kb, all);
 
         Kb.asPermutation().transpose().applyThisOnTheLeft(jb); // jb is now ordered as (jbs, jbu) = (jbe, jbi, jbu)
         Kn.asPermutation().transpose().applyThisOnTheLeft(jn); // jn is now ordered as (jns, jnu) = (jne, jni, jnu)
@@ -220,21 +218,28 @@ struct Canonicalizer::Impl
 
         // The indices of the stable variables js = (jbs, jns) = (jbe, jbi, jne, jni)
         const auto js = jsu.head(ns);
-        const auto ju = jsu.tail(nu);
 
         //=========================================================================================
         // Initialize matrices Hss, Hsp
         //=========================================================================================
-        using Eigen::all;
-
         Hprime.resize(nx, nx + np);
         auto Hss = Hprime.topLeftCorner(ns, ns);
         auto Hsp = Hprime.topRightCorner(ns, np);
 
-        Hss = H.Hxx(js, js);
-        Hsp = H.Hxp(js, all);
-
         diagHxx = H.isHxxDiag;
+        Hxx4basicvars = H.isHxx4BasicVars;
+
+        // Only the columns of Hxx corresponding to basic variables need to be
+        // gathered when the non-basic ones are known to be zero. In this case,
+        // Hss = [Hbsbs 0; Hnsbs 0], with Hnsbs not necessarily zero.
+        if(Hxx4basicvars)
+        {
+            Hss.leftCols(nbs) = H.Hxx(js, jbs);
+            Hss.rightCols(nns).fill(0.0);
+        }
+        else Hss = H.Hxx(js, js);
+
+        Hsp = H.Hxp(js, all);
 
         //=========================================================================================
         // Initialize matrices Vps, Vpp
@@ -245,19 +250,6 @@ struct Canonicalizer::Impl
 
         Vps = V.Vpx(all, js);
         Vpp = V.Vpp;
-
-        //=========================================================================================
-        // Initialize matrices Ws, Wu and Wp in W = [Ws Wu Wp] = [As Au Ap; Js Ju Jp]
-        //=========================================================================================
-
-        Wprime.resize(nw, nx + np);
-        auto Ws = Wprime.leftCols(ns);
-        auto Wu = Wprime.middleCols(ns, nu);
-        auto Wp = Wprime.rightCols(np);
-
-        Ws = W.Wx(all, js);
-        Wu = W.Wx(all, ju);
-        Wp = W.Wp;
     }
 
     auto canonicalMatrix() const -> CanonicalMatrix
@@ -277,7 +269,7 @@ struct Canonicalizer::Impl
         const auto js = jsu.head(ns);
         const auto ju = jsu.tail(nu);
 
-        return {dims, Hss, Hsp, Vps, Vpp, Sbsns, Sbsp, Rbs, jb, jn, js, ju};
+        return {dims, Hss, Hsp, Vps, Vpp, Sbsns, Sbsp, Rbs, jb, jn, js, ju, Hxx4basicvars, diagHxx};
     }
 };
 
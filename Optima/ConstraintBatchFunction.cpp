@@ -0,0 +1,55 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ConstraintBatchFunction.hpp"
+
+// C++ includes
+#include <algorithm>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+
+namespace Optima {
+
+ConstraintBatchFunction::ConstraintBatchFunction()
+{}
+
+ConstraintBatchFunction::ConstraintBatchFunction(const Signature& func)
+{
+    error(func == nullptr, "ConstraintBatchFunction cannot be constructed with a non-initialized function.");
+    fn = func;
+}
+
+auto ConstraintBatchFunction::operator()(ConstraintBatchResult& res, Index nq, MatrixView X, MatrixView P, MatrixView C, const ConstraintBatchOptions& opts) const -> void
+{
+    // Ensure clear state before evaluation
+    res.resize(X.rows(), nq, X.cols(), P.cols(), C.cols());
+    res.val.fill(0.0);
+    if(opts.eval.ddx) res.ddx.fill(0.0);
+    if(opts.eval.ddp) res.ddp.fill(0.0);
+    if(opts.eval.ddc) res.ddc.fill(0.0);
+    res.ddx4basicvars = false;
+    std::fill(res.succeeded.begin(), res.succeeded.end(), true);
+    fn(res, X, P, C, opts);
+}
+
+auto ConstraintBatchFunction::initialized() const -> bool
+{
+    return fn != nullptr;
+}
+
+} // namespace Optima
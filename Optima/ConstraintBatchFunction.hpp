@@ -0,0 +1,120 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <functional>
+#include <vector>
+
+// Optima includes
+#include <Optima/ConstraintFunction.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// The result of a batch of constraint function evaluations in structure-of-arrays layout.
+/// Row *k* of every member corresponds to the *k*-th evaluation in the batch, and each column
+/// stores one component of the result for all evaluations contiguously (e.g., column *i* of `val`
+/// stores *q[i]* of every evaluation). The Jacobian matrices are flattened in column-major
+/// order, so that column *i + j*nq* of `ddx` stores *ddx(i, j)* of every evaluation.
+/// @see ConstraintBatchFunction
+struct ConstraintBatchResult
+{
+    /// The evaluated vector values of *q(x, p, c)* with dimensions *n* by *nq*.
+    Matrix val;
+
+    /// The evaluated Jacobian matrices of *q(x, p, c)* with respect to *x* with dimensions *n* by *nq*nx*.
+    Matrix ddx;
+
+    /// The evaluated Jacobian matrices of *q(x, p, c)* with respect to *p* with dimensions *n* by *nq*np*.
+    Matrix ddp;
+
+    /// The evaluated Jacobian matrices of *q(x, p, c)* with respect to *c* with dimensions *n* by *nq*nc*.
+    Matrix ddc;
+
+    /// True if the matrices `ddx` of all evaluations are non-zero only on columns corresponding to basic variables in *x*.
+    bool ddx4basicvars = false;
+
+    /// The flags indicating whether each evaluation succeeded with dimension *n*.
+    std::vector<bool> succeeded;
+
+    /// Resize this ConstraintBatchResult object with given dimensions.
+    /// @param n The number of evaluations in the batch.
+    /// @param nq The number of constraint equations in *q(x, p, c)*.
+    /// @param nx The number of variables in *x*.
+    /// @param np The number of parameters in *p*.
+    /// @param nc The number of sensitive parameters in *c*.
+    auto resize(Index n, Index nq, Index nx, Index np, Index nc) -> void
+    {
+        val.resize(n, nq);
+        ddx.resize(n, nq*nx);
+        ddp.resize(n, nq*np);
+        ddc.resize(n, nq*nc);
+        succeeded.resize(n);
+    }
+};
+
+/// The options transmitted to the evaluation of a batch of constraint functions.
+/// @see ConstraintBatchFunction, ConstraintBatchResult
+struct ConstraintBatchOptions
+{
+    /// The constraint function components that need to be evaluated for at least one evaluation in the batch.
+    ConstraintOptions::Eval eval;
+
+    /// The indices of the problems in the batch solver associated with each evaluation.
+    Indices iproblems;
+
+    /// The indices of the basic variables in *x* for each evaluation.
+    std::vector<Indices> ibasicvars;
+};
+
+/// Used to represent a constraint function *q(x, p, c)* evaluated for a batch of points at once.
+/// The points are given in structure-of-arrays layout, with row *k* of matrices *X*, *P*, *C*
+/// corresponding to the *k*-th evaluation and column *i* of *X* storing *x[i]* of every evaluation.
+/// @see ConstraintFunction, BatchSolver
+class ConstraintBatchFunction
+{
+public:
+    /// The main functional signature of a batch of constraint functions *q(x, p, c)*.
+    /// @param[out] res The evaluated results of the constraint functions and their derivatives.
+    /// @param X The primal variables *x* of each evaluation with dimensions *n* by *nx*.
+    /// @param P The parameter variables *p* of each evaluation with dimensions *n* by *np*.
+    /// @param C The sensitive parameter variables *c* of each evaluation with dimensions *n* by *nc*.
+    /// @param opts The options transmitted to the evaluation of the batch.
+    using Signature = std::function<void(ConstraintBatchResult& res, MatrixView X, MatrixView P, MatrixView C, const ConstraintBatchOptions& opts)>;
+
+    /// Construct a default ConstraintBatchFunction object.
+    ConstraintBatchFunction();
+
+    /// Construct a ConstraintBatchFunction object with given function.
+    ConstraintBatchFunction(const Signature& fn);
+
+    /// Evaluate the batch of constraint functions with *nq* constraint equations.
+    /// The components of `res` are zeroed before the evaluation.
+    auto operator()(ConstraintBatchResult& res, Index nq, MatrixView X, MatrixView P, MatrixView C, const ConstraintBatchOptions& opts) const -> void;
+
+    /// Return `true` if this ConstraintBatchFunction object has been initialized.
+    auto initialized() const -> bool;
+
+private:
+    /// The batch of constraint functions with main functional signature.
+    Signature fn;
+};
+
+} // namespace Optima
@@ -48,11 +48,17 @@ ConstraintFunction::ConstraintFunction(const Signature4py& func)
 auto ConstraintFunction::operator()(ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts) const -> void
 {
     // Ensure clear state before evaluation
+    // Constant derivatives that are not requested keep their values from the evaluation in which they were computed
+    const auto keepddx = constantddxddp && !opts.eval.ddx;
+    const auto keepddp = constantddxddp && !opts.eval.ddp;
     res.val.fill(0.0);
-    res.ddx.fill(0.0);
-    res.ddp.fill(0.0);
+    if(!keepddx) {
+        if(ddxsparse) res.ddx(all, ddxcols).fill(0.0);
+        else res.ddx.fill(0.0);
+        res.ddx4basicvars = false;
+    }
+    if(!keepddp) res.ddp.fill(0.0);
     res.ddc.fill(0.0);
-    res.ddx4basicvars = false;
     res.succeeded = true;
     fn(res, x, p, c, opts);
 }
@@ -61,6 +67,9 @@ auto ConstraintFunction::operator=(const Signature& func) -> ConstraintFunction&
 {
     error(func == nullptr, "ConstraintFunction cannot be constructed with a non-initialized function.");
     fn = func;
+    ddxcols.resize(0);
+    ddxsparse = false; // the non-zero columns of ddx need to be declared again for the new function
+    constantddxddp = false;
     return *this;
 }
 
@@ -69,4 +78,31 @@ auto ConstraintFunction::initialized() const -> bool
     return fn != nullptr;
 }
 
+auto ConstraintFunction::setNonZeroColumnsDdx(IndicesView jcols) -> void
+{
+    errorif(jcols.size() && jcols.minCoeff() < 0, "The indices of the non-zero columns of the Jacobian matrix ddx cannot be negative.");
+    ddxcols = jcols;
+    ddxsparse = true;
+}
+
+auto ConstraintFunction::sparseDdx() const -> bool
+{
+    return ddxsparse;
+}
+
+auto ConstraintFunction::nonZeroColumnsDdx() const -> IndicesView
+{
+    return ddxcols;
+}
+
+auto ConstraintFunction::setConstantDerivatives(bool constant) -> void
+{
+    constantddxddp = constant;
+}
+
+auto ConstraintFunction::constantDerivatives() const -> bool
+{
+    return constantddxddp;
+}
+
 } // namespace Optima
@@ -143,17 +143,56 @@ public:
     // : ConstraintFunction(fn) {}
 
     /// Evaluate the constraint function.
+    /// All entries in `res` are reset before the evaluation, except the derivatives declared constant that are not requested in `opts`.
     auto operator()(ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts) const -> void;
 
     /// Assign another constraint function to this.
+    /// Any previously declared non-zero columns of `ddx` and constant derivatives are discarded.
     auto operator=(const Signature& fn) -> ConstraintFunction&;
 
     /// Return `true` if this ConstraintFunction object has been initialized.
     auto initialized() const -> bool;
 
+    /// Declare the columns of the Jacobian matrix `ddx` that can be non-zero.
+    /// Use this method when each constraint equation depends only on a few
+    /// variables in *x*. The columns of `ddx` not in `jcols` are then
+    /// assumed zero at all times. They are neither reset before each
+    /// evaluation nor read when computing the echelon form of the Jacobian
+    /// matrix and the residual vector of the problem (see
+    /// EchelonizerExtended::updateWithPriorityWeights for the parts of the
+    /// echelonization whose cost still depends on the number of variables).
+    /// @param jcols The indices of the columns of `ddx` that can be non-zero (each in the range [0, *nx*)).
+    auto setNonZeroColumnsDdx(IndicesView jcols) -> void;
+
+    /// Return `true` if the columns of `ddx` that can be non-zero have been declared.
+    auto sparseDdx() const -> bool;
+
+    /// Return the indices of the columns of `ddx` that can be non-zero if @ref sparseDdx is `true`.
+    auto nonZeroColumnsDdx() const -> IndicesView;
+
+    /// Declare the Jacobian matrices `ddx` and `ddp` constant (e.g., *q(x, p, c)* is linear in *x* and *p*).
+    /// Once `ddx` and `ddp` have been evaluated, the next evaluations are
+    /// requested without them (see ConstraintOptions::Eval), and their
+    /// values in the result are kept instead of being reset. The echelon
+    /// form of the Jacobian matrix of the problem is then also reused.
+    /// @param constant True if `ddx` and `ddp` do not depend on *x* and *p*.
+    auto setConstantDerivatives(bool constant) -> void;
+
+    /// Return `true` if `ddx` and `ddp` have been declared constant.
+    auto constantDerivatives() const -> bool;
+
 private:
     /// The constraint function with main functional signature.
     Signature fn;
+
+    /// The indices of the columns of `ddx` that can be non-zero.
+    Indices ddxcols;
+
+    /// True if the columns of `ddx` that can be non-zero have been declared.
+    bool ddxsparse = false;
+
+    /// True if `ddx` and `ddp` have been declared constant.
+    bool constantddxddp = false;
 };
 
 
@@ -18,10 +18,15 @@
 #include "Convergence.hpp"
 
 // C++ includes
+#include <cmath>
 #include <vector>
 
+// Eigen includes
+#include <Eigen/QR>
+
 // Optima includes
 #include <Optima/Exception.hpp>
+#include <Optima/MasterProblem.hpp>
 
 namespace Optima {
 
@@ -33,17 +38,75 @@ struct Convergence::Impl
     /// The options for convergence analysis.
     ConvergenceOptions options;
 
+    /// The index in the history of the last error that significantly decreased the smallest error so far.
+    std::size_t ibest = 0;
+
+    /// True if the linear equality constraints of the problem are inconsistent.
+    bool infeasible = false;
+
     Impl()
     {
     }
 
-    auto initialize(const MasterProblem& problem) -> void
+    auto initialize(const MasterProblem& problem, const ResidualFunction& F) -> void
     {
+        history.clear();
+        ibest = 0;
+        infeasible = options.infeasibility_check && inconsistent(problem, F);
+    }
+
+    /// Return true if *b* is not in the range of *[Ax Ap]* using the echelon form *RWQ* of *W* in the residual function.
+    /// The rows of *Ax* are echelonized before those of *Jx*, so the linearly dependent rows of *Ax* depend only
+    /// on other rows of *Ax*. The point *x* whose basic variables are *Rb[b; 0]* and non-basic variables are zero
+    /// thus satisfies all independent rows of *Ax x = b*, and the residual *Ax x - b* is non-zero on the dependent
+    /// rows only if *b* is inconsistent. With parameters *p*, the residuals of the columns of *Ap* computed this
+    /// way may compensate the residual of *b*, which is then reduced by its least-squares projection onto them.
+    auto inconsistent(const MasterProblem& problem, const ResidualFunction& F) const -> bool
+    {
+        const auto [nx, np, ny, nz, nw, nt] = problem.dims;
+
+        if(ny == 0)
+            return false;
+
+        const auto RWQ = F.result().Jm.RWQ;
+        const auto Rby = RWQ.R.leftCols(ny); // the columns of Rb acting on the rows of Ax
+        const auto Axb = problem.Ax(all, RWQ.jb);
+
+        Vector rb = Axb * (Rby * problem.b) - problem.b;
+
+        if(np)
+        {
+            const Matrix rp = Axb * (Rby * problem.Ap) - problem.Ap;
+            if(rp.size() && rp.cwiseAbs().maxCoeff() > 0.0)
+                rb -= rp * rp.colPivHouseholderQr().solve(rb);
+        }
+
+        const auto residual = rb.cwiseAbs().maxCoeff();
+
+        return residual > options.infeasibility_tolerance * std::max(1.0, problem.b.cwiseAbs().maxCoeff());
     }
 
     auto update(const ResidualErrors& E) -> void
     {
         history.push_back(E.error());
+        if(history.back() < (1.0 - options.stagnation_tolerance) * history[ibest])
+            ibest = history.size() - 1;
+    }
+
+    auto failure() const -> std::string
+    {
+        if(infeasible)
+            return "infeasibility";
+        if(history.empty())
+            return "";
+        const auto currenterror = history.back();
+        if(!std::isfinite(currenterror))
+            return "divergence";
+        if(options.divergence_factor > 0.0 && currenterror > options.divergence_factor * history.front())
+            return "divergence";
+        if(options.stagnation_iterations > 0 && history.size() - 1 - ibest >= options.stagnation_iterations)
+            return "stagnation";
+        return "";
     }
 
     auto converged(ConvergenceCheckArgs const& args) const -> bool
@@ -89,9 +152,9 @@ auto Convergence::setOptions(const ConvergenceOptions& options) -> void
     pimpl->options = options;
 }
 
-auto Convergence::initialize(const MasterProblem& problem) -> void
+auto Convergence::initialize(const MasterProblem& problem, const ResidualFunction& F) -> void
 {
-    pimpl->initialize(problem);
+    pimpl->initialize(problem, F);
 }
 
 auto Convergence::update(const ResidualErrors& E) -> void
@@ -104,6 +167,11 @@ auto Convergence::converged(ConvergenceCheckArgs const& args) const -> bool
     return pimpl->converged(args);
 }
 
+auto Convergence::failure() const -> std::string
+{
+    return pimpl->failure();
+}
+
 auto Convergence::rate() const -> double
 {
     return pimpl->rate();
@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <memory>
+#include <string>
 
 // Optima includes
 #include <Optima/ConvergenceOptions.hpp>
@@ -51,7 +52,9 @@ public:
     auto setOptions(const ConvergenceOptions& options) -> void;
 
     /// Initialize this convergence checker once at the start of the optimization calculation.
-    auto initialize(const MasterProblem& problem) -> void;
+    /// @param problem The master optimization problem.
+    /// @param F The residual function of the problem, already updated at the initial guess.
+    auto initialize(const MasterProblem& problem, const ResidualFunction& F) -> void;
 
     /// Update the convergence analysis with new accepted error status.
     auto update(const ResidualErrors& E) -> void;
@@ -59,6 +62,10 @@ public:
     /// Return `true` if the optimization calculation has converged.
     auto converged(ConvergenceCheckArgs const& args) const -> bool;
 
+    /// Return the reason for stopping the optimization calculation before it converges (empty if there is none).
+    /// The possible reasons are `infeasibility`, `divergence` and `stagnation` (see ConvergenceOptions).
+    auto failure() const -> std::string;
+
     /// Return the current convergence rate.
     auto rate() const -> double;
 };
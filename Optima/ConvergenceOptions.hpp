@@ -28,6 +28,23 @@ struct ConvergenceOptions
     /// The tolerance for the optimality error.
     double tolerance = 1.0e-8;
 
+    /// The number of iterations without a significant decrease of the error after which the calculation stops with failure reason `stagnation` (disabled if zero).
+    unsigned stagnation_iterations = 0;
+
+    /// The relative decrease of the smallest error so far that is considered significant in the detection of stagnation.
+    double stagnation_tolerance = 1.0e-3;
+
+    /// The factor by which the error must exceed its first value for the calculation to stop with failure reason `divergence` (disabled if zero).
+    /// The calculation also stops with this failure reason if the error is not finite.
+    double divergence_factor = 1.0e+10;
+
+    /// The boolean flag that indicates if the consistency of the linear equality constraints is checked before the calculation starts.
+    /// If *b* is not in the range of *[Ax Ap]*, the calculation stops without iterations with failure reason `infeasibility`.
+    bool infeasibility_check = true;
+
+    /// The tolerance, relative to the largest absolute entry in *b*, for the residual of the linear equality constraints in the infeasibility check.
+    double infeasibility_tolerance = 1.0e-8;
+
     /// An optional convergence check function to be used in addition to default check.
     std::function<bool(ConvergenceCheckArgs const&)> check;
 };
@@ -0,0 +1,447 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Decomposer.hpp"
+
+// C++ includes
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/IndexUtils.hpp>
+
+namespace Optima {
+namespace {
+
+/// Return the representative of the set containing a given element in a disjoint-set forest.
+auto findset(std::vector<Index>& parent, Index i) -> Index
+{
+    while(parent[i] != i)
+        i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+/// Merge the sets containing two given elements in a disjoint-set forest.
+auto unite(std::vector<Index>& parent, Index i, Index j) -> void
+{
+    i = findset(parent, i);
+    j = findset(parent, j);
+    if(i != j) parent[std::max(i, j)] = std::min(i, j);
+}
+
+/// Return true if two vectors of indices have the same size and entries.
+auto same(IndicesView a, IndicesView b) -> bool
+{
+    return a.size() == b.size() && a == b;
+}
+
+/// Return the index of the first non-zero entry in a vector (or -1 if all entries are zero).
+template<typename VectorType>
+auto firstNonZero(const VectorType& v) -> Index
+{
+    for(auto j = 0; j < v.size(); ++j)
+        if(v[j] != 0.0) return j;
+    return -1;
+}
+
+} // namespace
+
+struct Decomposer::Impl
+{
+    DecomposerOptions options;             ///< The options for the decomposition of the master optimization problem.
+    std::vector<MasterBlock> blocks;       ///< The independent blocks of the master optimization problem.
+    Index nblocks = 0;                     ///< The number of independent blocks found in the last structure analysis.
+    Indices xblock;                        ///< The block of each variable in x found in the last structure analysis.
+    Indices yblock;                        ///< The block of each row of Ax found in the last structure analysis.
+    Indices zblock;                        ///< The block of each row of Jx found in the last structure analysis.
+    Matrix Axpattern;                      ///< The sparsity pattern of Ax in the last structure analysis.
+    Indices Jxcols;                        ///< The declared columns of Jx that can be non-zero in the last structure analysis.
+    Indices fxxblocks;                     ///< The declared blocks of the variables in the Hessian matrix fxx in the last structure analysis (empty if not declared).
+    Vector xo;                             ///< The initial guess of x (within bounds) at which the variables outside each block are kept.
+    std::shared_ptr<std::mutex> evalmutex; ///< The mutex used to serialize the evaluations of the functions among the blocks.
+
+    Impl()
+    : evalmutex(std::make_shared<std::mutex>())
+    {}
+
+    auto initialize(const MasterProblem& problem, MasterVectorView u) -> void
+    {
+        const auto [nx, np, ny, nz, nw, nt] = problem.dims;
+
+        blocks.clear();
+
+        if(!options.active || np > 0 || nx == 0)
+            return;
+
+        xo.noalias() = min(max(u.x, problem.xlower), problem.xupper);
+
+        const Matrix pattern = (problem.Ax.array() != 0.0).cast<double>();
+
+        // Only the declared structures of Jx and fxx are used, since their entries that are zero at the initial guess may not be zero elsewhere
+        const Indices jcols = nz == 0 ? Indices() : problem.h.sparseDdx() ? Indices(problem.h.nonZeroColumnsDdx()) : indices(nx);
+        const Indices fblocks = problem.f.blockDiagonalHessian() ? Indices(problem.f.blocksHessian()) : Indices();
+
+        errorif(problem.f.blockDiagonalHessian() && fblocks.size() != nx,
+            "The declared blocks of the Hessian matrix of f(x, p) must have one entry per variable in x.");
+
+        errorif(jcols.size() && jcols.maxCoeff() >= nx,
+            "The declared non-zero columns of the Jacobian matrix of h(x, p) contain indices out of range.");
+
+        // The structure is the same as before if Ax has the same sparsity pattern, the same structures of Jx and fxx are
+        // declared, and fxx, if its blocks are not declared, is constant (so that it is known to be diagonal or not)
+        const auto samestructure =
+            xblock.size() == nx && zblock.size() == nz &&
+            Axpattern.rows() == pattern.rows() && Axpattern.cols() == pattern.cols() && Axpattern == pattern &&
+            same(Jxcols, jcols) && same(fxxblocks, fblocks) && (fblocks.size() || problem.f.constantHessian());
+
+        if(!samestructure)
+        {
+            Axpattern = pattern;
+            Jxcols = jcols;
+            fxxblocks = fblocks;
+            analyze(problem);
+        }
+
+        if(nblocks < 2)
+            return;
+
+        blocks.resize(nblocks);
+
+        for(auto k = 0; k < nblocks; ++k)
+        {
+            auto& block = blocks[k];
+            block.jx = indicesInBlock(xblock, k);
+            block.iy = indicesInBlock(yblock, k);
+            block.iz = indicesInBlock(zblock, k);
+            updateBlockProblem(problem, block);
+        }
+    }
+
+    /// Return the indices of the entries in a vector of block labels that belong to a given block.
+    static auto indicesInBlock(const Indices& labels, Index k) -> Indices
+    {
+        Indices res((labels.array() == k).count());
+        for(auto i = 0, j = 0; i < labels.size(); ++i)
+            if(labels[i] == k) res[j++] = i;
+        return res;
+    }
+
+    /// Return true if the Hessian matrix fxx, whose blocks have not been declared, is diagonal (or -1 if f cannot be evaluated).
+    /// Only the flag `diagfxx` in the evaluation of f at the initial guess is used, not the values of the entries of fxx.
+    auto diagonalHessian(const MasterProblem& problem) const -> int
+    {
+        const auto nx = problem.dims.nx;
+        const auto nc = problem.c.size();
+
+        const Indices jx = indices(nx);
+        const Vector p;
+        ObjectiveResult fres(nx, 0, nc);
+        const ObjectiveOptions fopts{{true, false, false}, jx};
+        const ConstraintOptions hopts{{false, false, false}, jx};
+        const ConstraintOptions vopts{{false, false, false}, jx};
+        problem.r(xo, p, problem.c, fopts, hopts, vopts);
+        problem.f(fres, xo, p, problem.c, fopts);
+
+        return fres.succeeded ? fres.diagfxx : -1;
+    }
+
+    /// Find the connected components of the graph of variables x coupled by Ax and the declared structures of Jx and fxx.
+    auto analyze(const MasterProblem& problem) -> void
+    {
+        const auto [nx, np, ny, nz, nw, nt] = problem.dims;
+
+        nblocks = 0;
+        xblock.setZero(nx);
+        yblock.setZero(ny);
+        zblock.setZero(nz);
+
+        const auto diagfxx = fxxblocks.size() ? 0 : diagonalHessian(problem);
+
+        if(diagfxx < 0)
+        {
+            xblock.resize(0); // ensure the structure is analyzed again in the next initialization
+            return;
+        }
+
+        std::vector<Index> parent(nx);
+        std::iota(parent.begin(), parent.end(), 0);
+
+        std::vector<bool> constrained(nx, false);
+
+        const auto couple = [&](auto row)
+        {
+            const auto first = firstNonZero(row);
+            if(first < 0) return;
+            for(auto j = first; j < nx; ++j)
+                if(row[j] != 0.0)
+                    unite(parent, first, j), constrained[j] = true;
+        };
+
+        for(auto i = 0; i < ny; ++i)
+            couple(Axpattern.row(i));
+
+        // The sparsity patterns of the rows of Jx are not declared, so all its columns that can be non-zero are coupled
+        for(auto j : Jxcols)
+            unite(parent, Jxcols[0], j), constrained[j] = true;
+
+        // The variables in the same block of fxx are coupled, and all variables are coupled if fxx is neither block diagonal nor diagonal
+        if(fxxblocks.size())
+        {
+            std::unordered_map<Index, Index> first; // the first variable in each block of fxx
+            for(auto j = 0; j < nx; ++j)
+            {
+                const auto [it, inserted] = first.emplace(fxxblocks[j], j);
+                if(!inserted) unite(parent, it->second, j);
+            }
+        }
+        else if(!diagfxx)
+            for(auto j = 1; j < nx; ++j)
+                unite(parent, 0, j);
+
+        // Number the components with constrained variables in the order of their first variables.
+        // The components without constrained variables are placed in the first block.
+        std::vector<Index> label(nx, -1);
+        for(auto j = 0; j < nx; ++j)
+            if(constrained[j] && label[findset(parent, j)] < 0)
+                label[findset(parent, j)] = nblocks++;
+
+        for(auto j = 0; j < nx; ++j)
+            xblock[j] = std::max<Index>(label[findset(parent, j)], 0);
+
+        // Each constraint belongs to the block of its variables (zero constraints are placed in the first block)
+        for(auto i = 0; i < ny; ++i)
+        {
+            const auto j = firstNonZero(Axpattern.row(i));
+            yblock[i] = j < 0 ? 0 : xblock[j];
+        }
+
+        // The constraints in h belong to the block of the columns of Jx that can be non-zero
+        zblock.fill(Jxcols.size() ? xblock[Jxcols[0]] : 0);
+    }
+
+    /// Update the master optimization problem of a block from the original one.
+    auto updateBlockProblem(const MasterProblem& problem, MasterBlock& block) -> void
+    {
+        const auto nx = problem.dims.nx;
+        const auto nz = problem.dims.nz;
+        const auto nc = problem.c.size();
+
+        const auto& jx = block.jx;
+        const auto& iy = block.iy;
+        const auto& iz = block.iz;
+
+        const auto nxk = jx.size();
+        const auto nyk = iy.size();
+        const auto nzk = iz.size();
+
+        auto& bproblem = block.problem;
+
+        bproblem.dims = MasterDims(nxk, 0, nyk, nzk);
+        bproblem.Ax = problem.Ax(iy, jx);
+        bproblem.Ap = Matrix(nyk, 0);
+        bproblem.b = problem.b(iy);
+        bproblem.xlower = problem.xlower(jx);
+        bproblem.xupper = problem.xupper(jx);
+        bproblem.plower = Vector();
+        bproblem.pupper = Vector();
+        bproblem.c = problem.c;
+        bproblem.bc = problem.bc.size() ? Matrix(problem.bc(iy, all)) : problem.bc;
+
+        // The functions of the block evaluate those of the original problem with the variables outside the block
+        // kept at their initial values. The resources function is evaluated right before the objective and
+        // constraint functions, and together with them under a lock unless concurrent evaluations are supported.
+        // Each function keeps its own auxiliary data, so that copies of these functions can be evaluated concurrently.
+
+        const auto mutex = options.threadsafe ? std::shared_ptr<std::mutex>() : evalmutex;
+
+        bproblem.r = ResourcesFunction();
+
+        bproblem.f = [r = problem.r, f = problem.f, jx, mutex, xfull = xo, jb = Indices(), fres = ObjectiveResult(nx, 0, nc)]
+            (ObjectiveResultRef res, VectorView x, VectorView p, VectorView c, ObjectiveOptions opts) mutable
+        {
+            xfull(jx) = x;
+            jb = jx(opts.ibasicvars);
+            const ObjectiveOptions fopts{opts.eval, jb};
+            const ConstraintOptions qopts{{false, false, false}, jb};
+            {
+                const auto lock = mutex ? std::unique_lock<std::mutex>(*mutex) : std::unique_lock<std::mutex>();
+                r(xfull, p, c, fopts, qopts, qopts);
+                f(fres, xfull, p, c, fopts);
+            }
+            res.f = fres.f;
+            res.fx = fres.fx(jx);
+            if(opts.eval.fxx) res.fxx = fres.fxx(jx, jx);
+            if(opts.eval.fxc) res.fxc = fres.fxc(jx, all);
+            res.diagfxx = fres.diagfxx;
+            res.fxx4basicvars = fres.fxx4basicvars;
+            res.succeeded = fres.succeeded;
+        };
+
+        bproblem.h = ConstraintFunction();
+
+        if(nzk) bproblem.h = [r = problem.r, h = problem.h, jx, iz, mutex, xfull = xo, jb = Indices(), hres = ConstraintResult(nz, nx, 0, nc)]
+            (ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts) mutable
+        {
+            xfull(jx) = x;
+            jb = jx(opts.ibasicvars);
+            const ObjectiveOptions fopts{{false, false, false}, jb};
+            const ConstraintOptions hopts{opts.eval, jb};
+            const ConstraintOptions vopts{{false, false, false}, jb};
+            {
+                const auto lock = mutex ? std::unique_lock<std::mutex>(*mutex) : std::unique_lock<std::mutex>();
+                r(xfull, p, c, fopts, hopts, vopts);
+                h(hres, xfull, p, c, hopts);
+            }
+            res.val = hres.val(iz);
+            if(opts.eval.ddx) res.ddx = hres.ddx(iz, jx);
+            if(opts.eval.ddc) res.ddc = hres.ddc(iz, all);
+            res.ddx4basicvars = hres.ddx4basicvars;
+            res.succeeded = hres.succeeded;
+        };
+
+        bproblem.phi = nullptr;
+
+        if(problem.phi) bproblem.phi = [phi = problem.phi, jx, mutex, xofull = xo, xfull = xo](VectorView xo, VectorRef x) mutable
+        {
+            xofull(jx) = xo;
+            xfull(jx) = x;
+            const auto lock = mutex ? std::unique_lock<std::mutex>(*mutex) : std::unique_lock<std::mutex>();
+            const auto succeeded = phi(xofull, xfull);
+            x = xfull(jx);
+            return succeeded;
+        };
+
+        // The block functions keep the declared properties of the original ones
+        bproblem.f.setConstantHessian(problem.f.constantHessian());
+        if(problem.f.blockDiagonalHessian()) bproblem.f.setBlocksHessian(problem.f.blocksHessian()(jx));
+        bproblem.h.setConstantDerivatives(problem.h.constantDerivatives());
+
+        if(nzk && problem.h.sparseDdx())
+        {
+            const auto jcols = problem.h.nonZeroColumnsDdx();
+            std::vector<bool> nonzero(nx, false);
+            for(auto j : jcols) nonzero[j] = true;
+            Indices bcols(nxk);
+            Index count = 0;
+            for(auto k = 0; k < nxk; ++k)
+                if(nonzero[jx[k]]) bcols[count++] = k;
+            bproblem.h.setNonZeroColumnsDdx(bcols.head(count));
+        }
+    }
+
+    auto split(MasterVectorView u, Index iblock, MasterVectorRef ublock) const -> void
+    {
+        const auto& block = blocks[iblock];
+        const auto ny = Axpattern.rows();
+        const auto nyk = block.iy.size();
+        ublock.x = u.x(block.jx);
+        ublock.w.head(nyk) = u.w.head(ny)(block.iy);
+        ublock.w.tail(block.iz.size()) = u.w.tail(u.w.size() - ny)(block.iz);
+    }
+
+    auto merge(const std::vector<MasterState>& bstates, MasterState& state) const -> void
+    {
+        assert(bstates.size() == blocks.size());
+
+        const auto ny = Axpattern.rows();
+        const auto nz = state.u.w.size() - ny;
+
+        state.s.resize(state.u.x.size());
+
+        for(auto k = 0U; k < blocks.size(); ++k)
+        {
+            const auto& block = blocks[k];
+            const auto& bstate = bstates[k];
+            const auto nyk = block.iy.size();
+            const auto nzk = block.iz.size();
+            state.u.x(block.jx) = bstate.u.x;
+            state.u.w.head(ny)(block.iy) = bstate.u.w.head(nyk);
+            state.u.w.tail(nz)(block.iz) = bstate.u.w.tail(nzk);
+            state.s(block.jx) = bstate.s;
+        }
+
+        // Assemble the indices of the variables in each partition from those in the blocks
+        const auto gather = [&](Indices MasterState::* member)
+        {
+            Index size = 0;
+            for(const auto& bstate : bstates)
+                size += (bstate.*member).size();
+            Indices res(size);
+            Index offset = 0;
+            for(auto k = 0U; k < blocks.size(); ++k)
+            {
+                const auto& jk = bstates[k].*member;
+                res.segment(offset, jk.size()) = blocks[k].jx(jk);
+                offset += jk.size();
+            }
+            return res;
+        };
+
+        state.js  = gather(&MasterState::js);
+        state.ju  = gather(&MasterState::ju);
+        state.jlu = gather(&MasterState::jlu);
+        state.juu = gather(&MasterState::juu);
+        state.jb  = gather(&MasterState::jb);
+        state.jn  = gather(&MasterState::jn);
+    }
+};
+
+Decomposer::Decomposer()
+: pimpl(new Impl())
+{}
+
+Decomposer::Decomposer(const Decomposer& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+Decomposer::~Decomposer()
+{}
+
+auto Decomposer::operator=(Decomposer other) -> Decomposer&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto Decomposer::setOptions(const DecomposerOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto Decomposer::initialize(const MasterProblem& problem, MasterVectorView u) -> void
+{
+    pimpl->initialize(problem, u);
+}
+
+auto Decomposer::blocks() const -> const std::vector<MasterBlock>&
+{
+    return pimpl->blocks;
+}
+
+auto Decomposer::split(MasterVectorView u, Index iblock, MasterVectorRef ublock) const -> void
+{
+    pimpl->split(u, iblock, ublock);
+}
+
+auto Decomposer::merge(const std::vector<MasterState>& bstates, MasterState& state) const -> void
+{
+    pimpl->merge(bstates, state);
+}
+
+} // namespace Optima
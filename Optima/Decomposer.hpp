@@ -0,0 +1,99 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// Optima includes
+#include <Optima/DecomposerOptions.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/MasterProblem.hpp>
+#include <Optima/MasterState.hpp>
+
+namespace Optima {
+
+/// Used to represent an independent block of a master optimization problem.
+struct MasterBlock
+{
+    Indices jx;            ///< The indices of the variables *x* in the block.
+    Indices iy;            ///< The indices of the linear equality constraints (rows of *Ax*) in the block.
+    Indices iz;            ///< The indices of the nonlinear equality constraints (rows of *h*) in the block.
+    MasterProblem problem; ///< The master optimization problem of the block in the variables *x[jx]*.
+};
+
+/// Used to decompose a master optimization problem into independent blocks.
+/// The blocks are the connected components of the graph whose vertices are
+/// the variables *x* and whose edges connect variables appearing together in a
+/// row of *Ax*, in the Jacobian matrix *Jx* of *h*, or in a block of the Hessian
+/// matrix *fxx*. Only the declared structures of *Jx* and *fxx* are used, never
+/// the values of their entries: all columns of *Jx* declared non-zero with
+/// ConstraintFunction::setNonZeroColumnsDdx (all columns if none declared) are
+/// coupled, and so are the variables in the same block of *fxx* declared with
+/// ObjectiveFunction::setBlocksHessian. Without such a declaration, *fxx* couples
+/// all variables unless its evaluation at the initial guess is flagged diagonal
+/// (see ObjectiveResult::diagfxx). This analysis is skipped in later
+/// initializations if the structure is known to be the same (i.e., *Ax* has the
+/// same sparsity pattern, the same structures of *Jx* and *fxx* are declared, and
+/// *fxx* has declared blocks or is constant). Variables not present in any
+/// constraint are placed in the first block. Problems with parameters *p* are not decomposed,
+/// since these are coupled with all variables *x* through *v(x, p)*.
+///
+/// The functions of each block evaluate those of the original problem with
+/// the variables outside the block kept at their initial values, and return
+/// only the entries corresponding to the block.
+class Decomposer
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a default Decomposer object.
+    Decomposer();
+
+    /// Construct a copy of a Decomposer object.
+    Decomposer(const Decomposer& other);
+
+    /// Destroy this Decomposer object.
+    virtual ~Decomposer();
+
+    /// Assign a Decomposer object to this.
+    auto operator=(Decomposer other) -> Decomposer&;
+
+    /// Set the options for the decomposition of the master optimization problem.
+    auto setOptions(const DecomposerOptions& options) -> void;
+
+    /// Initialize the independent blocks of a master optimization problem.
+    /// @param problem The master optimization problem.
+    /// @param u The initial guess of the master variables *u = (x, p, w)*.
+    auto initialize(const MasterProblem& problem, MasterVectorView u) -> void;
+
+    /// Return the independent blocks of the master optimization problem (empty if the problem could not be decomposed).
+    auto blocks() const -> const std::vector<MasterBlock>&;
+
+    /// Extract the master variables of a block from those of the master optimization problem.
+    auto split(MasterVectorView u, Index iblock, MasterVectorRef ublock) const -> void;
+
+    /// Assemble the master state of the master optimization problem from those of its blocks.
+    auto merge(const std::vector<MasterState>& bstates, MasterState& state) const -> void;
+};
+
+} // namespace Optima
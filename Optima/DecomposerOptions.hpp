@@ -0,0 +1,37 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace Optima {
+
+/// Used to organize the options for the decomposition of a master optimization problem into independent blocks.
+struct DecomposerOptions
+{
+    /// The boolean flag that indicates if the master optimization problem is decomposed into independent blocks solved separately.
+    bool active = false;
+
+    /// The maximum number of threads used to solve the independent blocks concurrently.
+    /// If less than two, the blocks are solved one after another on the calling thread.
+    unsigned threads = 1;
+
+    /// The boolean flag that indicates if the objective, constraint and resources functions support concurrent evaluations.
+    /// If false, their evaluations are serialized among the blocks, which then only solve their linear systems concurrently.
+    bool threadsafe = false;
+};
+
+} // namespace Optima
@@ -17,6 +17,9 @@
 
 #include "Echelonizer.hpp"
 
+// C++ includes
+#include <optional>
+
 // Eigen includes
 #include <Eigen/Dense>
 
@@ -33,11 +36,41 @@ auto identical(const MatrixView& A, const MatrixView& B)
     return A.rows() == B.rows() && A.cols() == B.cols() && A == B;
 }
 
+/// Return the rank of the matrix decomposed with the given full-pivoting LU decomposition.
+auto rank(Eigen::FullPivLU<Matrix>& lu) -> Index
+{
+    // Check if max pivot is very small
+    if(lu.maxPivot() < 10*std::numeric_limits<double>::epsilon())
+    {
+        const auto previous_threshold = lu.threshold();
+        lu.setThreshold(1.0); // In this case, set threshold to 1, to effectively obtain an absolute comparion instead of relative
+        const auto r = lu.rank();
+        lu.setThreshold(previous_threshold);
+        return r;
+    }
+    else return lu.rank();
+}
+
 struct Echelonizer::Impl
 {
-    /// The full-pivoting LU decomposition of A so that P*A*Q = L*U;
+    /// The full-pivoting LU decomposition of the candidate columns of A so that P*A(:, cand)*Q = L*U;
     Eigen::FullPivLU<Matrix> lu;
 
+    /// The column-pivoting QR decomposition of a block of candidate columns of A used in the tournament pivoting (empty until needed and in lean mode).
+    std::optional<Eigen::ColPivHouseholderQR<Matrix>> qrblock;
+
+    /// The indices of the columns of A that are candidates to basic columns.
+    Indices cand;
+
+    /// The indices of the columns of A that survive the current round of the tournament pivoting.
+    Indices winners;
+
+    /// The flags indicating which columns of A are candidates to basic columns.
+    Indices iscand;
+
+    /// The number of columns in each block of the tournament pivoting.
+    const Index blocksize = 256;
+
     /// The matrix A being echelonized.
     Matrix A;
 
@@ -68,6 +101,12 @@ struct Echelonizer::Impl
     /// The matrix M used in the swap operation.
     Vector M;
 
+    /// The pivot row of R used in the swap operation.
+    Vector Rib;
+
+    /// The pivot row of S used in the swap operation.
+    Vector Sib;
+
     /// The permutation matrix Kb used in the weighted update method.
     PermutationMatrix Kb;
 
@@ -83,9 +122,84 @@ struct Echelonizer::Impl
     /// The backup permutation matrix Q used to reset this object to a state with non-accumulated round-off errors.
     Indices Q0;
 
+    /// The flag indicating whether the backup matrices R0 and S0 are stored (not in lean mode, in which case reset recomputes them from A).
+    bool backup = false;
+
+    /// The options for the echelonization.
+    EchelonizerOptions options;
+
     /// The threshold used to compare numbers in S matrix.
     const double threshold = 1e-8;
 
+    /// The matrix D in the product of eta factors E = I + D*Z' accumulated during a sequence of swaps, with Z' selecting the pivot rows.
+    Matrix D;
+
+    /// The rows of S at the start of a sequence of swaps corresponding to the pivot rows in the eta factors.
+    Matrix Sp;
+
+    /// The rows of R at the start of a sequence of swaps corresponding to the pivot rows in the eta factors.
+    Matrix Rp;
+
+    /// The auxiliary matrix used to assemble the new matrix S at the end of a sequence of swaps.
+    Matrix Snew;
+
+    /// The rows of matrix D permuted in the new order of the basic variables at the end of a sequence of swaps.
+    Matrix Dp;
+
+    /// The inverse of the permutation matrix Kb used at the end of a sequence of swaps.
+    Indices ikb;
+
+    /// The pivot rows in the eta factors accumulated during a sequence of swaps.
+    Indices ipiv;
+
+    /// The position of each basic row in `ipiv` (or -1 if the row has not been a pivot row yet).
+    Indices kpiv;
+
+    /// The columns of the canonical form [I S] at the start of a sequence of swaps associated with the current basic variables.
+    Indices srcb;
+
+    /// The columns of the canonical form [I S] at the start of a sequence of swaps associated with the current non-basic variables.
+    Indices srcn;
+
+    /// The number of eta factors accumulated during a sequence of swaps.
+    Index neta = 0;
+
+    /// The current row of S (computed from the eta factors) during a sequence of swaps.
+    Vector srow;
+
+    /// The auxiliary vector used to compute the current row of S during a sequence of swaps.
+    Vector vrow;
+
+    /// The current column of S (computed from the eta factors) during a sequence of swaps.
+    Vector scol;
+
+    /// The auxiliary vector used to compute a new eta factor.
+    Vector u;
+
+    /// The auxiliary vector used to store a row of matrix D.
+    Vector d;
+
+    /// The number of swaps performed since the last factorization of A.
+    Index numswaps = 0;
+
+    /// The flags indicating which rows of R and S have been modified since the last cleanup of round-off errors.
+    Indices touched;
+
+    /// The estimated round-off drift of the canonical form right after the last factorization of A.
+    double drift0 = 0.0;
+
+    /// The tolerance for the estimated round-off drift of the canonical form above which it is recomputed from A.
+    const double drifttol = 1e-10;
+
+    /// The number of columns sampled when estimating the round-off drift of the canonical form.
+    const Index numsamples = 4;
+
+    /// The position of the next column in the canonical form to be sampled when estimating the round-off drift.
+    Index isample = 0;
+
+    /// The auxiliary vector used to estimate the round-off drift of the canonical form.
+    Vector rdrift;
+
     /// The number used for eliminating round-off errors during cleanup procedure.
     /// This is computed as 10**[1 + ceil(log10(maxAij))], where maxAij is the
     /// inf norm of matrix A. For each entry in R and S, we add sigma and
@@ -95,16 +209,57 @@ struct Echelonizer::Impl
     /// Return the number of basic variables, which is also the the rank of matrix A.
     auto numBasicVariables() -> Index
     {
-        // Check if max pivot is very small
-        if(lu.maxPivot() < 10*std::numeric_limits<double>::epsilon())
+        return rank(lu);
+    }
+
+    /// Select the columns of A that are candidates to basic columns using tournament pivoting.
+    /// For wide matrices, the columns of A are split into blocks, and only the linearly
+    /// independent columns selected by a column-pivoting QR decomposition of each block
+    /// proceed to the next round. This is repeated until the remaining columns fit in
+    /// a few blocks, so that the final full-pivoting LU decomposition, which determines
+    /// the rank and the basic columns of A, is performed on a short and narrow matrix.
+    auto selectCandidateColumns() -> void
+    {
+        const auto m = A.rows();
+        const auto n = A.cols();
+
+        // The number of columns in each block, which should be much larger than the number of rows in A
+        const auto bsize = std::max(blocksize, 4*m);
+
+        cand = indices(n);
+
+        if(cand.size() > 2*bsize && !qrblock)
+            qrblock.emplace();
+
+        while(cand.size() > 2*bsize)
         {
-            const auto previous_threshold = lu.threshold();
-            lu.setThreshold(1.0); // In this case, set threshold to 1, to effectively obtain an absolute comparion instead of relative
-            const auto r = lu.rank();
-            lu.setThreshold(previous_threshold);
-            return r;
+            const auto ncand = cand.size();
+
+            winners.resize(ncand);
+
+            Index k = 0;
+            for(Index j = 0; j < ncand; j += bsize)
+            {
+                const auto cols = cand.segment(j, std::min(bsize, ncand - j));
+                qrblock->compute(A(all, cols));
+                const auto r = qrblock->rank();
+                const auto qblock = qrblock->colsPermutation().indices().head(r);
+                for(Index i = 0; i < r; ++i)
+                    winners[k++] = cols[qblock[i]];
+            }
+
+            // Keep at least one column so that the final LU decomposition is not performed on an empty matrix (e.g., when A is zero)
+            if(k == 0)
+                winners[k++] = cand[0];
+
+            winners.conservativeResize(k);
+
+            // Stop if no column was discarded in this round (e.g., when all blocks have full column rank)
+            if(k == ncand)
+                break;
+
+            cand.swap(winners);
         }
-        else return lu.rank();
     }
 
     /// Compute the canonical matrix of the given matrix.
@@ -123,8 +278,15 @@ struct Echelonizer::Impl
         /// Initialize the current ordering of the variables
         inv_ordering = indices(n);
 
-        // Compute the full-pivoting LU of A so that P*A*Q = L*U
-        lu.compute(A);
+        // Select the columns of A that are candidates to basic columns (all of them, unless A is very wide)
+        selectCandidateColumns();
+
+        // The number of candidate columns of A
+        const auto nc = cand.size();
+
+        // Compute the full-pivoting LU of the candidate columns of A so that P*A(:, cand)*Q = L*U
+        if(nc == n) lu.compute(A);
+        else lu.compute(A(all, cand));
 
         // Update the rank of matrix A
         rankA = numBasicVariables();
@@ -135,13 +297,23 @@ struct Echelonizer::Impl
 
         // Get the LU factors of matrix A
         const auto Lbb = lu.matrixLU().topLeftCorner(nb, nb).triangularView<Eigen::UnitLower>();
-        const auto U   = lu.matrixLU().rightCols(n).triangularView<Eigen::Upper>();
         const auto Ubb = lu.matrixLU().topLeftCorner(nb, nb).triangularView<Eigen::Upper>();
-        const auto Ubn = lu.matrixLU().topRightCorner(nb, nn);
+        const auto Ubn = lu.matrixLU().topRightCorner(nb, nc - nb);
 
-        // Set the permutation matrices P and Q
+        // Set the permutation matrix P
         P = lu.permutationP().indices().cast<Index>();
-        Q = lu.permutationQ().indices().cast<Index>();
+
+        // Set the permutation matrix Q, with the non-candidate columns of A, if any, at the end
+        Q.resize(n);
+        Q.head(nc) = cand(lu.permutationQ().indices());
+        if(nc < n)
+        {
+            iscand.setZero(n);
+            iscand(cand).fill(1);
+            Index k = nc;
+            for(Index j = 0; j < n; ++j)
+                if(!iscand[j]) Q[k++] = j;
+        }
 
         // Initialize the permutation matrix Q(aux)
         Qaux = Q;
@@ -154,9 +326,11 @@ struct Echelonizer::Impl
         R.topRows(nb) = Lbb.solve(R.topRows(nb)); // [L] = 6x5, [R] = 6x6, [Lbb] = 5x5
         R.topRows(nb) = Ubb.solve(R.topRows(nb));
 
-        // Calculate matrix S
-        S = Ubn;
-        S = Ubb.solve(S);
+        // Calculate matrix S, in which the columns corresponding to non-candidate columns of A, if any, are computed with a matrix-matrix product
+        S.resize(nb, nn);
+        S.leftCols(nc - nb) = Ubn;
+        Ubb.solveInPlace(S.leftCols(nc - nb));
+        S.rightCols(n - nc).noalias() = R.topRows(nb)(all, Ptr.head(nb)) * A(Ptr.head(nb), Q.tail(n - nc));
 
         // Initialize the permutation matrices Kb and Kn
         Kb.setIdentity(nb);
@@ -166,10 +340,139 @@ struct Echelonizer::Impl
         sigma = A.size() ? A.cwiseAbs().maxCoeff() : 0.0;
         sigma = A.size() ? std::pow(10, 1 + std::ceil(std::log10(sigma))) : 0.0;
 
-        // Set the backup matrices R0, S0, Q0 for resetting purposes
-        R0 = R;
-        S0 = S;
+        // Set the backup matrices R0, S0, Q0 for resetting purposes (only Q0 in lean mode)
+        backup = !options.lean;
+        if(backup)
+        {
+            R0 = R;
+            S0 = S;
+        }
         Q0 = Q;
+
+        // Reset the number of swaps since the last factorization of A
+        numswaps = 0;
+
+        // Mark all rows of R and S as in need of cleanup and estimate the round-off drift of the new canonical form
+        touched.setOnes(m);
+        isample = 0;
+        neta = 0;
+        drift0 = estimateDrift();
+
+        // Release the memory no longer needed after the factorization in lean mode
+        if(options.lean)
+            releaseMemory();
+    }
+
+    /// Release the memory used by the LU decomposition of A, the backup matrices, and the auxiliary matrices.
+    auto releaseMemory() -> void
+    {
+        lu = Eigen::FullPivLU<Matrix>();
+        qrblock.reset();
+        cand.resize(0);
+        winners.resize(0);
+        iscand.resize(0);
+        R0.resize(0, 0);
+        S0.resize(0, 0);
+        Snew.resize(0, 0);
+        Sp.resize(0, 0);
+        Rp.resize(0, 0);
+        Dp.resize(0, 0);
+        backup = false;
+    }
+
+    /// Set the options for the echelonization.
+    auto setOptions(const EchelonizerOptions& opts) -> void
+    {
+        options = opts;
+        if(options.lean)
+            releaseMemory();
+    }
+
+    /// Return the number of bytes used by the matrices and vectors in this object.
+    auto memoryFootprint() const -> Index
+    {
+        const auto nlu = lu.rows()*lu.cols()*sizeof(double) + 2*(lu.rows() + lu.cols())*sizeof(int);
+        const auto nqr = qrblock ? qrblock->rows()*qrblock->cols()*sizeof(double) + 3*qrblock->cols()*sizeof(double) : 0;
+        const auto nmatrices = A.size() + R.size() + S.size() + R0.size() + S0.size() + D.size() + Sp.size() + Rp.size() + Snew.size() + Dp.size();
+        const auto nvectors = M.size() + Rib.size() + Sib.size() + srow.size() + vrow.size() + scol.size() + u.size() + d.size() + rdrift.size();
+        const auto nindices = cand.size() + winners.size() + iscand.size() + P.size() + Ptr.size() + Q.size() + Qaux.size() + inv_ordering.size() + Q0.size()
+            + ikb.size() + ipiv.size() + kpiv.size() + srcb.size() + srcn.size() + touched.size();
+        const auto nperms = Kb.size() + Kn.size();
+        return nlu + nqr + (nmatrices + nvectors)*sizeof(double) + nindices*sizeof(Index) + nperms*sizeof(int);
+    }
+
+    /// Return the round-off error in the column at position `k` in the canonical form, computed as the residual of R*A*Q.
+    auto residualColumn(Index k) -> double
+    {
+        // The number of basic columns of A.
+        const auto nb = rankA;
+
+        rdrift.noalias() = R.topRows(nb) * A.col(Q[k]);
+        if(k < nb) rdrift[k] -= 1.0;
+        else rdrift -= S.col(k - nb);
+
+        const auto scale = k < nb ? 1.0 : 1.0 + S.col(k - nb).cwiseAbs().maxCoeff();
+
+        return rdrift.cwiseAbs().maxCoeff() / scale;
+    }
+
+    /// Return an estimate of the round-off drift of the canonical form using a few sampled columns of R*A*Q.
+    /// The sampled columns are those of the basic variables in the pivot rows of the last sequence of swaps
+    /// (where round-off errors are introduced) and a few others chosen in a round-robin fashion.
+    auto estimateDrift() -> double
+    {
+        // The number of basic columns of A.
+        const auto nb = rankA;
+        const auto n = A.cols();
+
+        if(nb == 0)
+            return 0.0;
+
+        double drift = 0.0;
+
+        for(Index k = 0; k < std::min(neta, numsamples); ++k)
+            drift = std::max(drift, residualColumn(ipiv[k]));
+
+        for(Index k = 0; k < std::min(n, numsamples); ++k)
+        {
+            drift = std::max(drift, residualColumn(isample));
+            isample = (isample + 1) % n;
+        }
+
+        return drift;
+    }
+
+    /// Recompute the canonical form from A for the current basic and non-basic variables.
+    auto refactorize() -> void
+    {
+        // The number of basic and non-basic columns of A.
+        const auto nb = rankA;
+        const auto nn = A.cols() - rankA;
+
+        // The indices of the basic and non-basic variables
+        const auto ibasic = Q.head(nb);
+        const auto inonbasic = Q.tail(nn);
+
+        // The indices of the linearly independent rows of A
+        const auto irows = Ptr.head(nb);
+
+        // The LU decomposition of the square and non-singular matrix A(irows, ibasic)
+        const Eigen::PartialPivLU<Matrix> lub(A(irows, ibasic));
+
+        // Compute the top `nb` rows of R, with non-zero columns only for the linearly independent rows of A
+        R.topRows(nb).fill(0.0);
+        R.topRows(nb)(all, irows) = Matrix(lub.inverse());
+
+        // Compute matrix S
+        S = A(irows, inonbasic);
+        S = lub.solve(S);
+
+        // Reset the number of swaps since the last factorization of A
+        numswaps = 0;
+
+        // Mark the top `nb` rows of R and S as in need of cleanup and estimate the round-off drift of the new canonical form
+        touched.head(nb).fill(1);
+        drift0 = estimateDrift();
     }
 
     /// Swap a basic variable by a non-basic variable.
@@ -201,27 +504,193 @@ struct Echelonizer::Impl
         const auto m = S.rows();
         const auto aux = 1.0/S(ib, in);
 
-        // Update the echelonizer matrix R (only its `r` upper rows, where `r = rank(A)`)
-        R.row(ib) *= aux;
+        // Mark the rows of R and S modified by the swap
         for(auto i = 0; i < m; ++i)
-            if(i != ib) R.row(i) -= S(i, in) * R.row(ib);
+            if(i == ib || M[i] != 0.0) touched[i] = 1;
 
-        // Update matrix S
-        S.row(ib) *= aux;
-        for(auto i = 0; i < m; ++i)
-            if(i != ib) S.row(i) -= S(i, in) * S.row(ib);
+        // The pivot rows of R and S scaled by the pivot
+        Rib = R.row(ib) * aux;
+        Sib = S.row(ib) * aux;
+
+        // Exclude the pivot row from the rank-one updates below
+        M[ib] = 0.0;
+
+        // Update the echelonizer matrix R (only its `r` upper rows, where `r = rank(A)`)
+        // using a rank-one update, which traverses R along its contiguous columns
+        auto Rt = R.topRows(m);
+        Rt.noalias() -= M * Rib.transpose();
+        R.row(ib) = Rib;
+
+        // Update matrix S using a rank-one update
+        S.noalias() -= M * Sib.transpose();
+        S.row(ib) = Sib;
         S.col(in) = -M*aux;
         S(ib, in) = aux;
 
         // Update the permutation matrix Q
         std::swap(Q[ib], Q[m + in]);
+
+        // Update the number of swaps since the last factorization of A
+        ++numswaps;
+    }
+
+    /// Start a sequence of swaps in which the eta factors are accumulated instead of updating R and S.
+    auto beginSwapSequence() -> void
+    {
+        // The number of basic and non-basic columns of A.
+        const auto nb = rankA;
+        const auto nn = A.cols() - rankA;
+
+        D.resize(nb, nb);
+        Sp.resize(nb, nn);
+        ipiv.resize(nb);
+        kpiv.setConstant(nb, -1);
+        srcb = indices(nb);
+        srcn = indices(nn).array() + nb;
+        neta = 0;
+    }
+
+    /// Compute the current row `i` of S from the eta factors accumulated in the sequence of swaps.
+    auto computeRowSwapSequence(Index i) -> VectorView
+    {
+        // The number of basic and non-basic columns of A.
+        const auto nb = rankA;
+        const auto nn = A.cols() - rankA;
+
+        // The row i of S at the start of the sequence of swaps, updated with the eta factors if row i has been affected by them
+        vrow = S.row(i);
+        if(neta > 0 && !D.row(i).head(neta).isZero(0.0))
+            vrow.noalias() += Sp.topRows(neta).transpose() * D.row(i).head(neta).transpose();
+
+        // Collect the entries in row i associated with the current non-basic variables
+        srow.resize(nn);
+        for(Index k = 0; k < nn; ++k)
+        {
+            const auto t = srcn[k];
+            if(t >= nb) srow[k] = vrow[t - nb];
+            else srow[k] = (t == i ? 1.0 : 0.0) + (kpiv[t] >= 0 ? D(i, kpiv[t]) : 0.0);
+        }
+
+        return srow;
+    }
+
+    /// Swap a basic variable by a non-basic variable by accumulating a new eta factor in the sequence of swaps.
+    auto updateWithSwapBasicVariableSwapSequence(Index ib, Index in, double pivot) -> void
+    {
+        // The number of basic columns of A.
+        const auto nb = rankA;
+
+        // Compute the current column of the non-basic variable entering the basic set
+        const auto t = srcn[in];
+        if(t >= nb)
+        {
+            scol = S.col(t - nb);
+            if(neta > 0) scol.noalias() += D.leftCols(neta) * Sp.col(t - nb).head(neta);
+        }
+        else
+        {
+            scol.setZero(nb);
+            scol[t] = 1.0;
+            if(kpiv[t] >= 0) scol += D.col(kpiv[t]);
+        }
+
+        // The new eta factor E(k) = I + u*e(ib)' so that E(k) scales row ib by 1/pivot and eliminates column `in` from all other rows
+        u = -scol/pivot;
+        u[ib] = 1.0/pivot - 1.0;
+
+        // Update the product of eta factors E = E(k)*E = I + D*Z'
+        d = D.row(ib).head(neta);
+        if(neta > 0) D.leftCols(neta).noalias() += u * d.transpose();
+        if(kpiv[ib] < 0)
+        {
+            kpiv[ib] = neta;
+            ipiv[neta] = ib;
+            D.col(neta) = u;
+            Sp.row(neta) = S.row(ib);
+            ++neta;
+        }
+        else D.col(kpiv[ib]) += u;
+
+        // Update the columns of the canonical form associated with the swapped variables
+        std::swap(srcb[ib], srcn[in]);
+
+        // Update the permutation matrix Q
+        std::swap(Q[ib], Q[nb + in]);
+
+        // Update the number of swaps since the last factorization of A
+        ++numswaps;
+    }
+
+    /// Finish a sequence of swaps by applying the accumulated eta factors to R and S.
+    /// If `rearrange` is true, matrix S is assembled with its rows and columns already
+    /// permuted by Kb and Kn, so that no further pass over S is needed to rearrange it.
+    auto endSwapSequence(bool rearrange) -> void
+    {
+        if(neta == 0)
+            return;
+
+        // The number of basic and non-basic columns of A.
+        const auto nb = rankA;
+        const auto nn = A.cols() - rankA;
+
+        // The pivot rows in the eta factors
+        const auto irows = ipiv.head(neta);
+
+        // Mark the rows of R and S modified by the eta factors
+        for(Index i = 0; i < nb; ++i)
+            if(kpiv[i] >= 0 || !D.row(i).head(neta).isZero(0.0)) touched[i] = 1;
+
+        // Update the top `nb` rows of R with R = E*R
+        auto Rb = R.topRows(nb);
+        Rp = Rb(irows, all);
+        Rb.noalias() += D.leftCols(neta) * Rp;
+
+        // The new order of the basic and non-basic variables (identity if no rearrangement)
+        const auto& kb = Kb.indices();
+        const auto& kn = Kn.indices();
+
+        // The position of each row of S in the new order of the basic variables
+        ikb.resize(nb);
+        if(rearrange) ikb(kb) = indices(nb);
+        else ikb = indices(nb);
+
+        // Assemble the columns of [I S] at the start of the sequence of swaps associated with the current non-basic variables (in their new order)
+        Snew.resize(nb, nn);
+        for(Index k = 0; k < nn; ++k)
+        {
+            const auto t = srcn[rearrange ? kn[k] : k];
+            if(t >= nb)
+            {
+                if(rearrange) Snew.col(k) = S.col(t - nb)(kb);
+                else Snew.col(k) = S.col(t - nb);
+            }
+            else { Snew.col(k).setZero(); Snew(ikb[t], k) = 1.0; }
+        }
+
+        // Update the pivot rows to the new order of the basic variables
+        for(Index k = 0; k < neta; ++k)
+            ipiv[k] = ikb[ipiv[k]];
+
+        // Update matrix S with S = E*S (with the rows of E in the new order of the basic variables)
+        Sp.topRows(neta) = Snew(irows, all);
+        if(rearrange)
+        {
+            Dp = D.leftCols(neta)(kb, all);
+            Snew.noalias() += Dp * Sp.topRows(neta);
+        }
+        else Snew.noalias() += D.leftCols(neta) * Sp.topRows(neta);
+        S.swap(Snew);
+
+        // Release the auxiliary matrix in lean mode, which is as large as S
+        if(options.lean)
+            Snew.resize(0, 0);
     }
 
     /// Update the existing canonical form with given priority weights for the columns.
     auto updateWithPriorityWeights(VectorView w) -> void
     {
         // Assert there are as many weights as there are variables
-        assert(w.rows() == lu.cols() &&
+        assert(w.rows() == A.cols() &&
             "Could not update the canonical form."
                 "Mismatch number of variables and given priority weights.");
 
@@ -237,12 +706,12 @@ struct Echelonizer::Impl
         auto inonbasic = Q.tail(nn);
 
         // Find the non-basic variable with maximum proportional weight with respect to a basic variable
-        auto find_nonbasic_candidate = [&](Index i, Index& j)
+        auto find_nonbasic_candidate = [&](VectorView Si, Index& j)
         {
             j = 0; double max = -infinity();
             double tmp = 0.0;
             for(Index k = 0; k < nn; ++k) {
-                if(std::abs(S(i, k)) <= threshold) continue;
+                if(std::abs(Si[k]) <= threshold) continue;
                 tmp = w[inonbasic[k]];
                 if(tmp > max) {
                     max = tmp;
@@ -252,46 +721,86 @@ struct Echelonizer::Impl
             return max;
         };
 
-        // Check if there are basic variables to be swapped with non-basic variables with higher priority
-        if(nn > 0) for(Index i = 0; i < nb; ++i)
+        // The number of swaps since the last factorization of A before the new sequence of swaps
+        const auto numswapsbefore = numswaps;
+
+        // Check if there are basic variables to be swapped with non-basic variables with higher priority.
+        // The swaps are accumulated as eta factors and only applied to R and S at the end of the sequence.
+        if(nn > 0 && nb > 0)
         {
-            Index j;
-            const double wi = w[ibasic[i]];
-            const double wj = find_nonbasic_candidate(i, j);
-            if(wi < wj)
-                updateWithSwapBasicVariable(i, j);
+            beginSwapSequence();
+            for(Index i = 0; i < nb; ++i)
+            {
+                Index j;
+                const auto Si = computeRowSwapSequence(i);
+                const double wi = w[ibasic[i]];
+                const double wj = find_nonbasic_candidate(Si, j);
+                const double wthreshold = wi > 0.0 ? options.hysteresis * wi : wi; // the hysteresis factor applies only to basic variables with positive weights
+                if(wthreshold < wj)
+                    updateWithSwapBasicVariableSwapSequence(i, j, Si[j]);
+            }
         }
+        else neta = 0;
 
-        // Sort the basic variables in descend order of weights
-        std::sort(Kb.indices().data(), Kb.indices().data() + nb,
-            [&](Index l, Index r) { return w[ibasic[l]] > w[ibasic[r]]; });
+        // Check if the basic and non-basic variables are already in descend order of weights, so that no rearrangement is needed
+        const auto descend = [&](Index l, Index r) { return w[l] > w[r]; };
+        const auto rearrange = !std::is_sorted(ibasic.begin(), ibasic.end(), descend) || !std::is_sorted(inonbasic.begin(), inonbasic.end(), descend);
 
-        // Sort the non-basic variables in descend order of weights
-        std::sort(Kn.indices().data(), Kn.indices().data() + nn,
-            [&](Index l, Index r) { return w[inonbasic[l]] > w[inonbasic[r]]; });
+        if(rearrange)
+        {
+            // Sort the basic variables in descend order of weights
+            std::sort(Kb.indices().data(), Kb.indices().data() + nb,
+                [&](Index l, Index r) { return w[ibasic[l]] > w[ibasic[r]]; });
 
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(S);
+            // Sort the non-basic variables in descend order of weights
+            std::sort(Kn.indices().data(), Kn.indices().data() + nn,
+                [&](Index l, Index r) { return w[inonbasic[l]] > w[inonbasic[r]]; });
+        }
 
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.applyThisOnTheRight(S);
+        // Apply the accumulated eta factors to R and S, with S assembled directly in the new order of the variables
+        endSwapSequence(rearrange);
 
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(Rb);
+        if(rearrange)
+        {
+            // Rearrange the rows and columns of S based on the new order of basic and non-basic variables (if not done above)
+            if(neta == 0)
+            {
+                Kb.transpose().applyThisOnTheLeft(S);
+                Kn.applyThisOnTheRight(S);
+            }
 
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(ibasic);
+            // Rearrange the top `nb` rows of R based on the new order of basic variables
+            Kb.transpose().applyThisOnTheLeft(Rb);
 
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.transpose().applyThisOnTheLeft(inonbasic);
+            // Rearrange the flags of modified rows based on the new order of basic variables
+            auto touchedb = touched.head(nb);
+            Kb.transpose().applyThisOnTheLeft(touchedb);
+
+            // Rearrange the permutation matrix Q based on the new order of basic variables
+            Kb.transpose().applyThisOnTheLeft(ibasic);
+
+            // Rearrange the permutation matrix Q based on the new order of non-basic variables
+            Kn.transpose().applyThisOnTheLeft(inonbasic);
+        }
+
+        // Recompute the canonical form from A if the estimated round-off drift caused by the swaps is too large.
+        // The tolerance is relaxed for canonical forms that are already inaccurate right after factorization.
+        if(numswaps > numswapsbefore && estimateDrift() > std::max(drifttol, 100*drift0))
+            refactorize();
     }
 
     /// Reset to the canonical matrix form computed initially.
     auto reset() -> void
     {
-        R = R0;
-        S = S0;
         Q = Q0;
+        if(backup)
+        {
+            R = R0;
+            S = S0;
+            numswaps = 0;
+            touched.fill(1);
+        }
+        else refactorize(); // in lean mode, recompute R and S from A for the initial basic variables
     }
 
     /// Update the ordering of the basic and non-basic variables,
@@ -320,6 +829,10 @@ struct Echelonizer::Impl
         // Rearrange the top `nb` rows of R based on the new order of basic variables
         Kb.asPermutation().transpose().applyThisOnTheLeft(Rt);
 
+        // Rearrange the flags of modified rows based on the new order of basic variables
+        auto touchedb = touched.head(nb);
+        Kb.asPermutation().transpose().applyThisOnTheLeft(touchedb);
+
         // Rearrange the permutation matrix Q based on the new order of basic variables
         Kb.asPermutation().transpose().applyThisOnTheLeft(ibasic);
 
@@ -328,13 +841,28 @@ struct Echelonizer::Impl
     }
 
     /// Perform a cleanup procedure to remove residual round-off errors from the canonical form.
+    /// Only the rows of R and S modified since the last cleanup are processed.
     auto cleanResidualRoundoffErrors() -> void
     {
-        S.array() += sigma;
-        S.array() -= sigma;
+        const auto m = R.rows();
+        const auto nb = S.rows();
 
-        R.array() += sigma;
-        R.array() -= sigma;
+        for(Index i = 0; i < m; ++i)
+        {
+            if(touched[i] == 0)
+                continue;
+
+            R.row(i).array() += sigma;
+            R.row(i).array() -= sigma;
+
+            if(i < nb)
+            {
+                S.row(i).array() += sigma;
+                S.row(i).array() -= sigma;
+            }
+
+            touched[i] = 0;
+        }
     }
 };
 
@@ -361,14 +889,19 @@ auto Echelonizer::operator=(Echelonizer other) -> Echelonizer&
     return *this;
 }
 
+auto Echelonizer::setOptions(const EchelonizerOptions& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
 auto Echelonizer::numVariables() const -> Index
 {
-    return pimpl->lu.cols();
+    return pimpl->A.cols();
 }
 
 auto Echelonizer::numEquations() const -> Index
 {
-    return pimpl->lu.rows();
+    return pimpl->A.rows();
 }
 
 auto Echelonizer::numBasicVariables() const -> Index
@@ -381,6 +914,11 @@ auto Echelonizer::numNonBasicVariables() const -> Index
     return numVariables() - numBasicVariables();
 }
 
+auto Echelonizer::memoryFootprint() const -> Index
+{
+    return pimpl->memoryFootprint();
+}
+
 auto Echelonizer::S() const -> MatrixView
 {
     return pimpl->S;
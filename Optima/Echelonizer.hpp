@@ -21,6 +21,7 @@
 #include <memory>
 
 // Optima includes
+#include <Optima/EchelonizerOptions.hpp>
 #include <Optima/Index.hpp>
 #include <Optima/Matrix.hpp>
 
@@ -57,6 +58,9 @@ public:
     /// Assign a Echelonizer instance to this.
     auto operator=(Echelonizer other) -> Echelonizer&;
 
+    /// Set the options for the echelonization.
+    auto setOptions(const EchelonizerOptions& options) -> void;
+
     /// Return the number of variables.
     auto numVariables() const -> Index;
 
@@ -69,6 +73,9 @@ public:
     /// Return the number of non-basic variables.
     auto numNonBasicVariables() const -> Index;
 
+    /// Return the number of bytes used by the matrices and vectors stored in this object.
+    auto memoryFootprint() const -> Index;
+
     /// Return the matrix \eq{S} of the canonicalization.
     auto S() const -> MatrixView;
 
@@ -119,7 +126,8 @@ public:
     /// Reset to the canonical matrix form computed initially.
     /// This method exists so that after several variable swapping operations
     /// have taken place, which produce accumulated round-off errors, the first
-    /// canonical form can be recovered.
+    /// canonical form can be recovered. In lean mode (see EchelonizerOptions::lean),
+    /// the first canonical form is recomputed from matrix \eq{A}.
     auto reset() -> void;
 
     /// Perform a cleanup procedure to remove residual round-off errors from the canonical form.
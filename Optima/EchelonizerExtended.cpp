@@ -20,9 +20,14 @@
 // C++ includes
 #include <cmath>
 
+// Eigen includes
+#include <Eigen/Dense>
+
 // Optima includes
 #include <Optima/Echelonizer.hpp>
 #include <Optima/Exception.hpp>
+#include <Optima/IndexUtils.hpp>
+#include <Optima/Utils.hpp>
 
 namespace Optima {
 
@@ -31,8 +36,8 @@ struct EchelonizerExtended::Impl
     /// The echelonizer for matrix A
     Echelonizer echelonizerA;
 
-    /// The echelonizer for matrix J
-    Echelonizer echelonizerJ;
+    /// The options for the echelonization.
+    EchelonizerOptions options;
 
     /// The matrix R in the canonicalization R*[A; J]*Q = [I S]
     Matrix R;
@@ -49,6 +54,75 @@ struct EchelonizerExtended::Impl
     /// The permutation matrix `Kn` used in the update method with priority weights.
     PermutationMatrix Kn;
 
+    /// The matrix J*QA = [J1 J2] used in the update method with priority weights (only the columns of J1 in `kb` when J is sparse).
+    Matrix J12;
+
+    /// The flags indicating which columns of J may be non-zero (used when J is sparse).
+    Indices Jmask;
+
+    /// The positions of the basic variables wrt A whose columns in J may be non-zero (used when J is sparse).
+    Indices kb;
+
+    /// The positions of the non-basic variables wrt A whose columns in J may be non-zero (used when J is sparse).
+    Indices kn;
+
+    /// The matrix J2 - J1*SA with rows scaled by those of J, reduced in place by the Householder reflections.
+    Matrix G;
+
+    /// The product of the Householder reflections and the row scaling matrix of J.
+    Matrix H;
+
+    /// The matrix SJ in the canonicalization RJ*(J2 - J1*SA)*QJ = [I SJ].
+    Matrix SJ;
+
+    /// The matrix RJ in the canonicalization RJ*(J2 - J1*SA)*QJ = [I SJ].
+    Matrix RJ;
+
+    /// The permutation matrix QJ in the canonicalization RJ*(J2 - J1*SA)*QJ = [I SJ].
+    Indices QJ;
+
+    /// The priority weights of the non-basic variables wrt A used to select the basic variables wrt J.
+    Vector wJ;
+
+    /// The flags indicating which variables were selected as basic variables wrt J in the last update.
+    Indices basicJ;
+
+    /// The workspace used when applying the Householder reflections.
+    Vector essential, work;
+
+    /// The norms of the columns of G before the Householder reflections.
+    Vector gnorms;
+
+    /// The norms of the columns of G below the current step of the Householder reflections, updated at each step.
+    Vector rnorms;
+
+    /// The norms in `rnorms` when last computed from G instead of updated (used to detect cancellation in the updates).
+    Vector rnormsref;
+
+    /// The matrix SA with its columns ordered as the non-basic variables wrt A in the canonical form of J2 - J1*SA.
+    Matrix SA12;
+
+    /// The number of basic variables wrt J.
+    Index nbJ = 0;
+
+    /// The relative threshold used to decide if a column of J2 - J1*SA is linearly dependent on the ones already selected.
+    /// A column is dependent if its residual norm is below this threshold times the largest column norm of the row-scaled
+    /// J2 - J1*SA or, when cancellation in J2 - J1*SA leaves all columns small, times the magnitude of the largest entry
+    /// in each row of J (one after the row scaling).
+    const double threshold = 1e-8;
+
+    /// The fraction of the largest residual norm among the remaining columns of J2 - J1*SA that the residual norm of a column
+    /// must have to be selected as pivot. The priority weights choose only among these columns, since a pivot much smaller than
+    /// the others amplifies their round-off errors and lets columns that are dependent in exact arithmetic look independent.
+    const double pivotratio = 0.01;
+
+    /// The flags indicating which rows of R and S have been modified since the last cleanup of round-off errors.
+    /// The rows copied from the canonical form of A, which is cleaned in every update, are not marked.
+    Indices touched;
+
+    /// The flag indicating whether J is empty, in which case the canonical form is the one in `echelonizerA` and R, S, Q are not used.
+    bool onlyA = true;
+
     /// The number used for eliminating round-off errors during cleanup procedure.
     /// This is computed as 10**[1 + ceil(log10(maxAij))], where maxAij is the
     /// inf norm of matrix A. For each entry in R and S, we add sigma and
@@ -63,31 +137,171 @@ struct EchelonizerExtended::Impl
     /// Construct a EchelonizerExtended::Impl object with given matrix A
     Impl(MatrixView A)
     {
-        // Initialize the echelonizer for A (wait until J is provided to initialize echelonizerJ)
+        // Initialize the echelonizer for A, whose canonical form is used until a non-empty J is provided
         echelonizerA.compute(A);
-        R = echelonizerA.R();
-        S = echelonizerA.S();
-        Q = echelonizerA.Q();
 
         // Compute sigma for given matrix A
         sigma = A.size() ? A.cwiseAbs().maxCoeff() : 0.0;
-        sigma = A.size() ? std::pow(10, 1 + std::ceil(std::log10(sigma))) : 0.0; // TODO: In the future, consider a contribution from J to determine sigma (or find an alternative approach to remove round-off errors.)
+        sigma = A.size() ? std::pow(10, 1 + std::ceil(std::log10(sigma))) : 0.0;
+
+        basicJ.setZero(A.cols());
+    }
+
+    /// Compute the canonical form RJ*G*QJ = [I SJ] of matrix G = J2 - J1*SA.
+    /// The basic variables wrt J are selected with a Householder QR
+    /// factorization in which, at each step, the column with the highest
+    /// priority weight among those whose residual norm is not small relative
+    /// to the largest one is chosen (ties are broken by the largest residual
+    /// norm), until the largest residual norm is negligible. The rows of G
+    /// are first scaled by those of J, so that
+    /// the selection is not affected by the magnitude of the entries in J.
+    /// The residual norms of the columns are updated at each step instead of
+    /// recomputed, and recomputed only when the update loses accuracy (as in
+    /// LAPACK's xGEQP3). The factorization is computed anew in every update,
+    /// since a change in J changes every entry of G.
+    auto echelonizeJ(MatrixView J, VectorView w) -> void
+    {
+        const auto mJ = G.rows();
+        const auto nnA = G.cols();
+
+        H.setZero(mJ, mJ);
+        for(Index i = 0; i < mJ; ++i)
+        {
+            const auto maxJi = J.row(i).cwiseAbs().maxCoeff();
+            H(i, i) = maxJi > 0.0 ? 1.0/maxJi : 1.0;
+            G.row(i) *= H(i, i);
+        }
+
+        QJ = indices(nnA);
+        wJ = w;
+
+        // The hysteresis factor favours the variables that were basic wrt J in the last update (only those with positive weights)
+        for(Index j = 0; j < nnA; ++j)
+            if(basicJ[QJ[j]] && wJ[j] > 0.0)
+                wJ[j] *= options.hysteresis;
+
+        gnorms = G.colwise().norm().transpose();
+        rnorms = gnorms;
+        rnormsref = gnorms;
+
+        const auto rtol = threshold * std::max(nnA ? gnorms.maxCoeff() : 0.0, 1.0);
+
+        const auto tolupdate = std::sqrt(epsilon());
+
+        work.resize(std::max(mJ, nnA));
+        essential.resize(mJ);
+
+        Index k = 0;
+        for(; k < std::min(mJ, nnA); ++k)
+        {
+            // The largest residual norm among the remaining columns, which is negligible when they are linearly dependent on
+            // the selected ones. The downdated norms are only accurate to about sqrt(epsilon) of their reference values, so they
+            // are recomputed before the remaining columns are deemed dependent.
+            auto rlargest = rnorms.segment(k, nnA - k).maxCoeff();
+            if(rlargest <= rtol)
+            {
+                for(Index j = k; j < nnA; ++j)
+                    rnorms[j] = rnormsref[j] = G.col(j).tail(mJ - k).norm();
+                rlargest = rnorms.segment(k, nnA - k).maxCoeff();
+            }
+            if(rlargest <= rtol)
+                break;
+
+            // Find the column with highest priority weight among those whose residual norm is not small relative to the
+            // largest one, so that a pivot dominated by round-off errors is never selected in favour of a weight
+            Index jmax = -1;
+            double wmax = -infinity();
+            double rmax = 0.0;
+            for(Index j = k; j < nnA; ++j)
+            {
+                const auto rj = rnorms[j];
+                if(rj < pivotratio * rlargest) continue;
+                if(wJ[j] > wmax || (wJ[j] == wmax && rj > rmax))
+                {
+                    jmax = j;
+                    wmax = wJ[j];
+                    rmax = rj;
+                }
+            }
+
+            if(jmax == -1)
+                break;
+
+            G.col(k).swap(G.col(jmax));
+            std::swap(QJ[k], QJ[jmax]);
+            std::swap(wJ[k], wJ[jmax]);
+            std::swap(gnorms[k], gnorms[jmax]);
+            std::swap(rnorms[k], rnorms[jmax]);
+            std::swap(rnormsref[k], rnormsref[jmax]);
+
+            // Annihilate the entries below the diagonal in the k-th column and apply the same reflection to the remaining columns and to H
+            double tau, beta;
+            auto essentialk = essential.head(mJ - k - 1);
+            G.col(k).tail(mJ - k).makeHouseholder(essentialk, tau, beta);
+            G.bottomRightCorner(mJ - k, nnA - k - 1).applyHouseholderOnTheLeft(essentialk, tau, work.data());
+            H.bottomRows(mJ - k).applyHouseholderOnTheLeft(essentialk, tau, work.data());
+            G(k, k) = beta;
+            G.col(k).tail(mJ - k - 1).fill(0.0);
+
+            // Update the residual norms of the remaining columns by removing their entries in the k-th row
+            for(Index j = k + 1; j < nnA; ++j)
+            {
+                if(rnorms[j] == 0.0) continue;
+                const auto ratio = std::abs(G(k, j)) / rnorms[j];
+                const auto factor = std::max(0.0, 1.0 - ratio*ratio);
+                const auto ratioref = rnorms[j] / rnormsref[j];
+                if(factor * ratioref * ratioref <= tolupdate)
+                {
+                    rnorms[j] = G.col(j).tail(mJ - k - 1).norm();
+                    rnormsref[j] = rnorms[j];
+                }
+                else rnorms[j] *= std::sqrt(factor);
+            }
+        }
+
+        nbJ = k;
+
+        const auto Rh = G.topLeftCorner(nbJ, nbJ).triangularView<Eigen::Upper>();
+
+        SJ = G.topRightCorner(nbJ, nnA - nbJ);
+        Rh.solveInPlace(SJ);
+
+        RJ = H;
+        Rh.solveInPlace(RJ.topRows(nbJ));
+
+        basicJ.fill(0);
+        basicJ(QJ.head(nbJ)).fill(1);
     }
 
     /// Update the canonical form with given variable matrix J in W = [A; J] and priority weights for the variables.
     auto updateWithPriorityWeights(MatrixView J, VectorView weights) -> void
+    {
+        updateWithPriorityWeights(J, Indices(), false, weights);
+    }
+
+    /// Update the canonical form with given variable matrix J in W = [A; J], whose non-zero entries are only on columns Jcols, and priority weights for the variables.
+    auto updateWithPriorityWeights(MatrixView J, IndicesView Jcols, VectorView weights) -> void
+    {
+        updateWithPriorityWeights(J, Jcols, true, weights);
+    }
+
+    /// Update the canonical form with given variable matrix J in W = [A; J] and priority weights for the variables.
+    auto updateWithPriorityWeights(MatrixView J, IndicesView Jcols, bool sparseJ, VectorView weights) -> void
     {
         echelonizerA.updateWithPriorityWeights(weights);
 
+        // Remove round-off errors from the rows of the canonical form of A modified by the update (only these are processed)
+        echelonizerA.cleanResidualRoundoffErrors();
+
         if(J.size() == 0)
         {
-            R = echelonizerA.R();
-            S = echelonizerA.S();
-            Q = echelonizerA.Q();
+            onlyA = true;
+            if(options.lean)
+                releaseMemory();
             return;
         }
 
-        // FIXME: Investigate why EchelonizerExtended is not accurate when nz > 5 and fix it.
+        onlyA = false;
 
         const auto& RA = echelonizerA.R();
         const auto& SA = echelonizerA.S();
@@ -101,33 +315,50 @@ struct EchelonizerExtended::Impl
         const auto mJ = J.rows();
         const auto m = mA + mJ;
 
-        Matrix J12 = J * QA.asPermutation();
-        auto J1 = J12.leftCols(nbA);
-        auto J2 = J12.rightCols(nnA);
-        J2 -= J1 * SA;
-
-        Vector w = weights(QA.tail(nnA));  // w has the weights only for non-basic variables wrt A
-        echelonizerJ.compute(J2);
-        echelonizerJ.updateWithPriorityWeights(w);
-
-        const auto nbJ = echelonizerJ.numBasicVariables();
-        const auto nnJ = echelonizerJ.numNonBasicVariables();
+        if(sparseJ)
+        {
+            // Only the columns of J in Jcols may be non-zero, so that both J*QA and J1*SA can be computed with these columns only.
+            // The matrix J2 - J1*SA is in general dense, however, since the rows of SA are, and it is factorized as such below.
+            Jmask.setZero(n);
+            Jmask(Jcols).fill(1);
+
+            const auto ibA = QA.head(nbA);
+            const auto inA = QA.tail(nnA);
+
+            kb.resize(nbA);
+            kn.resize(nnA);
+
+            Index k = 0;
+            for(Index i = 0; i < nbA; ++i)
+                if(Jmask[ibA[i]]) kb[k++] = i;
+            kb.conservativeResize(k);
+
+            k = 0;
+            for(Index i = 0; i < nnA; ++i)
+                if(Jmask[inA[i]]) kn[k++] = i;
+            kn.conservativeResize(k);
+
+            J12 = J(all, ibA(kb));
+            G.setZero(mJ, nnA);
+            G(all, kn) = J(all, inA(kn));
+            G.noalias() -= J12 * SA(kb, all);
+        }
+        else
+        {
+            J12 = J * QA.asPermutation();
+            G = J12.rightCols(nnA);
+            G.noalias() -= J12.leftCols(nbA) * SA;
+        }
 
-        // TODO: When testing with nx = 30, ny = 20, nz = 5, and two linearly dependent rows,
-        // EchelonizerExtended does not produce accurate C = [I S] matrix when performing R*[A; J]*Q.
-        // While there are ~1e-14 errors on the very left part of I, which is a reasonable approximation for zeros,
-        // for the right side part of I, the last 5 columns, we see ~1e-6, which is not acceptable.
-        warning(nbA + nbJ != std::min(m, n), "EchelonizerExtended guarantees accuracy at the moment only when A and J have no linearly dependent rows.");
+        echelonizeJ(J, weights(QA.tail(nnA)));  // use the weights only for non-basic variables wrt A
 
-        const auto RJ = echelonizerJ.R();
-        const auto SJ = echelonizerJ.S();
-        const auto QJ = echelonizerJ.Q();
+        const auto nnJ = nnA - nbJ;
 
         Q.resize(n);
         Q.head(nbA) = QA.head(nbA);
         Q.tail(nnA) = QA.tail(nnA)(QJ);
 
-        Matrix SA12 = SA;
+        SA12 = SA;
         QJ.asPermutation().applyThisOnTheRight(SA12);
         auto SA1 = SA12.leftCols(nbJ);
         auto SA2 = SA12.rightCols(nnJ);
@@ -148,18 +379,49 @@ struct EchelonizerExtended::Impl
         auto Rt = R.topRows(nbA + nbJ);
         auto Rb = R.bottomRows(m - nbA - nbJ);
 
-        Rt.topLeftCorner(nbA, mA) = RAt + SA1*RJt*J1*RAt;
-        Rb.topLeftCorner(mA - nbA, mA) = RAb;
+        if(sparseJ)
+        {
+            const auto& J1s = J12;
+            const auto RAts = RAt(kb, all);
+
+            Rt.topLeftCorner(nbA, mA) = RAt + SA1*RJt*J1s*RAts;
+            Rb.topLeftCorner(mA - nbA, mA) = RAb;
+
+            Rt.topRightCorner(nbA, mJ) = -SA1*RJt;
+            Rb.topRightCorner(mA - nbA, mJ).fill(0.0);
+
+            Rt.bottomLeftCorner(nbJ, mA) = -RJt*J1s*RAts;
+            Rb.bottomLeftCorner(mJ - nbJ, mA) = -RJb*J1s*RAts;
+        }
+        else
+        {
+            const auto J1 = J12.leftCols(nbA);
 
-        Rt.topRightCorner(nbA, mJ) = -SA1*RJt;
-        Rb.topRightCorner(mA - nbA, mJ).fill(0.0);
+            Rt.topLeftCorner(nbA, mA) = RAt + SA1*RJt*J1*RAt;
+            Rb.topLeftCorner(mA - nbA, mA) = RAb;
 
-        Rt.bottomLeftCorner(nbJ, mA) = -RJt*J1*RAt;
-        Rb.bottomLeftCorner(mJ - nbJ, mA) = -RJb*J1*RAt;
+            Rt.topRightCorner(nbA, mJ) = -SA1*RJt;
+            Rb.topRightCorner(mA - nbA, mJ).fill(0.0);
+
+            Rt.bottomLeftCorner(nbJ, mA) = -RJt*J1*RAt;
+            Rb.bottomLeftCorner(mJ - nbJ, mA) = -RJb*J1*RAt;
+        }
 
         Rt.bottomRightCorner(nbJ, mJ) = RJt;
         Rb.bottomRightCorner(mJ - nbJ, mJ) = RJb;
 
+        // Mark the rows of R and S that are not copies of those in the cleaned canonical form of A. These are the rows
+        // of the basic variables wrt A with non-zero entries in SA1, and the rows corresponding to those of J.
+        touched.setZero(m);
+        for(Index i = 0; i < nbA; ++i)
+            touched[i] = !SA1.row(i).isZero(0.0);
+        touched.segment(nbA, nbJ).fill(1);
+        touched.tail(mJ - nbJ).fill(1);
+
+        // Release the auxiliary matrices in lean mode
+        if(options.lean)
+            releaseMemory();
+
         //---------------------------------------------------------------------------
         // Start sorting of basic and non-basic variables according to their weights
         //---------------------------------------------------------------------------
@@ -175,6 +437,11 @@ struct EchelonizerExtended::Impl
         auto ibasic = Q.head(nb);
         auto inonbasic = Q.tail(nn);
 
+        // Skip the sorting and rearrangement below if the basic and non-basic variables are already in descend order of weights
+        const auto descend = [&](Index l, Index r) { return weights[l] > weights[r]; };
+        if(std::is_sorted(ibasic.begin(), ibasic.end(), descend) && std::is_sorted(inonbasic.begin(), inonbasic.end(), descend))
+            return;
+
         // Sort the basic variables in descend order of weights
         std::sort(Kb.indices().data(), Kb.indices().data() + nb,
             [&](Index l, Index r) { return weights[ibasic[l]] > weights[ibasic[r]]; });
@@ -192,6 +459,10 @@ struct EchelonizerExtended::Impl
         // Rearrange the top `nb` rows of R based on the new order of basic variables
         Kb.transpose().applyThisOnTheLeft(Rt);
 
+        // Rearrange the flags of the modified rows of R and S based on the new order of basic variables
+        auto touchedb = touched.head(nb);
+        Kb.transpose().applyThisOnTheLeft(touchedb);
+
         // Rearrange the permutation matrix Q based on the new order of basic variables
         Kb.transpose().applyThisOnTheLeft(ibasic);
 
@@ -199,9 +470,41 @@ struct EchelonizerExtended::Impl
         Kn.transpose().applyThisOnTheLeft(inonbasic);
     }
 
+    /// Release the memory used by the matrices that are not needed until the next update.
+    auto releaseMemory() -> void
+    {
+        J12.resize(0, 0);
+        G.resize(0, 0);
+        H.resize(0, 0);
+        SA12.resize(0, 0);
+        if(onlyA)
+        {
+            R.resize(0, 0);
+            S.resize(0, 0);
+            Q.resize(0);
+            touched.resize(0);
+        }
+    }
+
+    /// Return the number of bytes used by the matrices and vectors in this object.
+    auto memoryFootprint() const -> Index
+    {
+        const auto nmatrices = R.size() + S.size() + J12.size() + G.size() + H.size() + SJ.size() + RJ.size() + SA12.size();
+        const auto nvectors = wJ.size() + essential.size() + work.size() + gnorms.size() + rnorms.size() + rnormsref.size();
+        const auto nindices = Q.size() + Jmask.size() + kb.size() + kn.size() + QJ.size() + basicJ.size() + touched.size();
+        const auto nperms = Kb.size() + Kn.size();
+        return echelonizerA.memoryFootprint() + (nmatrices + nvectors)*sizeof(double) + nindices*sizeof(Index) + nperms*sizeof(int);
+    }
+
     /// Update the ordering of the basic and non-basic variables,
     auto updateOrdering(IndicesView Kb, IndicesView Kn) -> void
     {
+        if(onlyA)
+        {
+            echelonizerA.updateOrdering(Kb, Kn);
+            return;
+        }
+
         const auto n  = Q.rows();
         const auto nb = S.rows();
         const auto nn = n - nb;
@@ -225,6 +528,10 @@ struct EchelonizerExtended::Impl
         // Rearrange the top `nb` rows of R based on the new order of basic variables
         Kb.asPermutation().transpose().applyThisOnTheLeft(Rt);
 
+        // Rearrange the flags of the modified rows of R and S based on the new order of basic variables
+        auto touchedb = touched.head(nb);
+        Kb.asPermutation().transpose().applyThisOnTheLeft(touchedb);
+
         // Rearrange the permutation matrix Q based on the new order of basic variables
         Kb.asPermutation().transpose().applyThisOnTheLeft(ibasic);
 
@@ -233,13 +540,32 @@ struct EchelonizerExtended::Impl
     }
 
     /// Perform a cleanup procedure to remove residual round-off errors from the canonical form.
+    /// Only the rows of R and S modified since the last cleanup are processed.
     auto cleanResidualRoundoffErrors() -> void
     {
-        S.array() += sigma;
-        S.array() -= sigma;
+        // Skip cleanup if the canonical form is the already cleaned one of A
+        if(onlyA)
+            return;
+
+        const auto m = R.rows();
+        const auto nb = S.rows();
+
+        for(Index i = 0; i < m; ++i)
+        {
+            if(touched[i] == 0)
+                continue;
 
-        R.array() += sigma;
-        R.array() -= sigma;
+            R.row(i).array() += sigma;
+            R.row(i).array() -= sigma;
+
+            if(i < nb)
+            {
+                S.row(i).array() += sigma;
+                S.row(i).array() -= sigma;
+            }
+
+            touched[i] = 0;
+        }
     }
 };
 
@@ -266,19 +592,25 @@ auto EchelonizerExtended::operator=(EchelonizerExtended other) -> EchelonizerExt
     return *this;
 }
 
+auto EchelonizerExtended::setOptions(const EchelonizerOptions& options) -> void
+{
+    pimpl->options = options;
+    pimpl->echelonizerA.setOptions(options);
+}
+
 auto EchelonizerExtended::numVariables() const -> Index
 {
-    return pimpl->Q.rows();
+    return pimpl->echelonizerA.numVariables();
 }
 
 auto EchelonizerExtended::numEquations() const -> Index
 {
-    return pimpl->echelonizerA.numEquations() + pimpl->echelonizerJ.numEquations();
+    return R().rows();
 }
 
 auto EchelonizerExtended::numBasicVariables() const -> Index
 {
-    return pimpl->S.rows();
+    return S().rows();
 }
 
 auto EchelonizerExtended::numNonBasicVariables() const -> Index
@@ -286,18 +618,26 @@ auto EchelonizerExtended::numNonBasicVariables() const -> Index
     return numVariables() - numBasicVariables();
 }
 
+auto EchelonizerExtended::memoryFootprint() const -> Index
+{
+    return pimpl->memoryFootprint();
+}
+
 auto EchelonizerExtended::S() const -> MatrixView
 {
+    if(pimpl->onlyA) return pimpl->echelonizerA.S();
     return pimpl->S;
 }
 
 auto EchelonizerExtended::R() const -> MatrixView
 {
+    if(pimpl->onlyA) return pimpl->echelonizerA.R();
     return pimpl->R;
 }
 
 auto EchelonizerExtended::Q() const -> IndicesView
 {
+    if(pimpl->onlyA) return pimpl->echelonizerA.Q();
     return pimpl->Q;
 }
 
@@ -316,13 +656,13 @@ auto EchelonizerExtended::C() const -> Matrix
 auto EchelonizerExtended::indicesBasicVariables() const -> IndicesView
 {
     const auto nb = numBasicVariables();
-    return pimpl->Q.head(nb);
+    return Q().head(nb);
 }
 
 auto EchelonizerExtended::indicesNonBasicVariables() const -> IndicesView
 {
     const auto nn = numNonBasicVariables();
-    return pimpl->Q.tail(nn);
+    return Q().tail(nn);
 }
 
 auto EchelonizerExtended::updateWithPriorityWeights(MatrixView J, VectorView weights) -> void
@@ -330,6 +670,11 @@ auto EchelonizerExtended::updateWithPriorityWeights(MatrixView J, VectorView wei
     pimpl->updateWithPriorityWeights(J, weights);
 }
 
+auto EchelonizerExtended::updateWithPriorityWeights(MatrixView J, IndicesView Jcols, VectorView weights) -> void
+{
+    pimpl->updateWithPriorityWeights(J, Jcols, weights);
+}
+
 auto EchelonizerExtended::updateOrdering(IndicesView Kb, IndicesView Kn) -> void
 {
     pimpl->updateOrdering(Kb, Kn);
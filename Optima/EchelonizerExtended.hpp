@@ -21,6 +21,7 @@
 #include <memory>
 
 // Optima includes
+#include <Optima/EchelonizerOptions.hpp>
 #include <Optima/Index.hpp>
 #include <Optima/Matrix.hpp>
 
@@ -39,10 +40,11 @@ namespace Optima {
 /// other hand, is related to the linear equality constraint whose coefficient
 /// matrix remains the same throughout the calculation.
 ///
-/// @warning EchelonizerExtended assumes that rows in *J* are not linearly
-/// dependent on rows in *A* and vice-versa. This assumption should be sensible
-/// in most application cases. However, when testing, it may happen that *W =
-/// [A; J]* is produced so that this assumption is not respected.
+/// The canonical form of \eq{A} is updated with basis swaps only, while the
+/// rows in \eq{J} are eliminated against it and the resulting matrix is
+/// canonicalized with a Householder QR factorization whose column pivoting
+/// follows the priority weights of the variables. Rows in \eq{J} that are
+/// linearly dependent on rows in \eq{[A; J]} are detected in this step.
 ///----------------------------------------------------------------------------------------------
 class EchelonizerExtended
 {
@@ -62,6 +64,9 @@ public:
     /// Assign a EchelonizerExtended instance to this.
     auto operator=(EchelonizerExtended other) -> EchelonizerExtended&;
 
+    /// Set the options for the echelonization.
+    auto setOptions(const EchelonizerOptions& options) -> void;
+
     /// Return the number of variables.
     auto numVariables() const -> Index;
 
@@ -74,6 +79,9 @@ public:
     /// Return the number of non-basic variables.
     auto numNonBasicVariables() const -> Index;
 
+    /// Return the number of bytes used by the matrices and vectors stored in this object.
+    auto memoryFootprint() const -> Index;
+
     /// Return the matrix \eq{S} of the canonicalization.
     auto S() const -> MatrixView;
 
@@ -96,6 +104,19 @@ public:
     /// Update the canonical form with given lower matrix block *J* and priority weights for the variables.
     auto updateWithPriorityWeights(MatrixView J, VectorView weights) -> void;
 
+    /// Update the canonical form with given sparse lower matrix block *J* and priority weights for the variables.
+    /// Use this method when only a few columns of *J* can be non-zero. Only
+    /// these columns of *J* are then read, and the elimination of *J* against
+    /// the canonical form of *A* involves only the rows of *S* of the basic
+    /// variables in these columns. The resulting matrix has in general
+    /// non-zero entries in all non-basic columns, however, so that its
+    /// factorization and the update of *S* still scale with the number of
+    /// variables.
+    /// @param J The lower matrix block *J* in *W = [A; J]*.
+    /// @param Jcols The indices of the columns of *J* that can be non-zero (all others are assumed zero).
+    /// @param weights The priority weights for the variables.
+    auto updateWithPriorityWeights(MatrixView J, IndicesView Jcols, VectorView weights) -> void;
+
     /// Update the ordering of the basic and non-basic variables.
     auto updateOrdering(IndicesView Kb, IndicesView Kn) -> void;
 
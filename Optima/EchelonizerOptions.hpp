@@ -0,0 +1,41 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace Optima {
+
+/// Used to organize the options for the echelonization of matrices in Echelonizer and related classes.
+struct EchelonizerOptions
+{
+    /// The relative hysteresis factor used when swapping basic and non-basic variables in updates with priority weights.
+    /// A non-basic variable replaces a basic variable with positive priority weight only if its weight is greater
+    /// than the weight of the basic variable multiplied by this factor. The default value of 1 swaps the variables
+    /// whenever the weight of the non-basic variable is greater. Values above 1 prevent the basic variables from
+    /// changing back and forth between iterations when their weights are close (e.g., trace species).
+    double hysteresis = 1.0;
+
+    /// The flag indicating whether the echelonization should use as little memory as possible.
+    /// In lean mode, the LU decomposition of the matrix is released after the canonical form is
+    /// computed and no backup copies of the initial canonical form are kept (they are recomputed
+    /// from the matrix when needed), which reduces the memory held at all times. The auxiliary
+    /// matrices of an update are also released after it, but they are allocated again by the next
+    /// update, so this reduces only the memory held between updates, not their peak memory usage.
+    bool lean = false;
+};
+
+} // namespace Optima
@@ -20,6 +20,7 @@
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/EchelonizerExtended.hpp>
+#include <Optima/IndexUtils.hpp>
 #include <Optima/Utils.hpp>
 #include <Optima/Macros.hpp>
 
@@ -30,19 +31,45 @@ struct EchelonizerW::Impl
     /// The dimensions of the master variables.
     MasterDims dims;
 
-    /// The matrices Ax, Ap, W = [Ax Ap; Jx Jp], S = [Sbn Sbp]
-    Matrix W, S;
+    /// The matrix W = [Ax Ap; Jx Jp].
+    Matrix W;
+
+    /// The matrix Sbp in S = [Sbn Sbp], where Sbn is the matrix S in the canonical form of Wx = [Ax; Jx].
+    Matrix Sbp;
 
     /// The echelonizer of matrix Wx = [Ax; Jx]
     EchelonizerExtended echelonizer;
 
+    /// The options for the echelonization of matrix W.
+    EchelonizerOptions options;
+
+    /// The indices of the columns of Jx that can be non-zero.
+    Indices Jxcols;
+
+    /// True if only a subset of the columns of Jx can be non-zero.
+    bool sparseJx = false;
+
+    /// True if `echelonizer` operates on the entire matrix Wx = [Ax; Jx] as if Jx were part of Ax (used when Jx is constant).
+    bool merged = false;
+
+    /// The ordering of the basic and non-basic variables in the last computation of Sbp when `echelonizer` operates on the entire matrix Wx.
+    Indices jbnSbp;
+
     Impl()
     {}
 
     auto initialize(const MasterDims& dimens, MatrixView Ax, MatrixView Ap) -> void
+    {
+        initialize(dimens, Ax, Ap, indices(dimens.nx));
+    }
+
+    auto initialize(const MasterDims& dimens, MatrixView Ax, MatrixView Ap, IndicesView jcols) -> void
     {
         dims = dimens;
 
+        Jxcols = jcols;
+        sparseJx = Jxcols.size() < dims.nx;
+
         const auto [nx, np, ny, nz, nw, nt] = dims;
 
         assert(Ax.rows() == ny || ny == 0 || nx == 0);
@@ -55,15 +82,20 @@ struct EchelonizerW::Impl
         // where EchelonizerExtended::initialize should figure out if same. Careful with echelon form that has
         // been contaminated with round off errors (because there has been many basic swaps already).
         echelonizer = EchelonizerExtended(Ax);
+        echelonizer.setOptions(options);
+        merged = false;
 
         W.resize(nw, nx + np);
-        S.resize(nw, nx + np);
+        Sbp.resize(nw, np);
 
         auto Wx = W.leftCols(nx);
         auto Wp = W.rightCols(np);
 
         if(Ax.size()) Wx.topRows(ny) = Ax;
         if(Ap.size()) Wp.topRows(ny) = Ap;
+
+        // The columns of Jx not in Jxcols are zero and are never updated
+        if(sparseJx) Wx.bottomRows(nz).fill(0.0);
     }
 
     auto update(MatrixView Jx, MatrixView Jp, VectorView weights) -> void
@@ -82,26 +114,76 @@ struct EchelonizerW::Impl
         auto Wx = W.leftCols(nx);
         auto Wp = W.rightCols(np);
 
-        if(Jx.size()) Wx.bottomRows(nz) = Jx;
+        // Restore the echelonization of Ax alone if the previous updates considered Jx constant
+        if(merged)
+        {
+            echelonizer = EchelonizerExtended(Wx.topRows(ny));
+            echelonizer.setOptions(options);
+            merged = false;
+        }
+
+        if(Jx.size())
+        {
+            if(sparseJx) Wx.bottomRows(nz)(all, Jxcols) = Jx(all, Jxcols);
+            else Wx.bottomRows(nz) = Jx;
+        }
+
         if(Jp.size()) Wp.bottomRows(nz) = Jp;
 
-        echelonizer.updateWithPriorityWeights(Jx, weights);
+        if(sparseJx) echelonizer.updateWithPriorityWeights(Jx, Jxcols, weights);
+        else echelonizer.updateWithPriorityWeights(Jx, weights);
+        echelonizer.cleanResidualRoundoffErrors();
+
+        updateSbp();
+
+        jbnSbp.resize(0);
+    }
+
+    auto update(VectorView weights) -> void
+    {
+        const auto [nx, np, ny, nz, nw, nt] = dims;
+
+        assert( echelonizer.R().rows() );
+
+        assert( nx == weights.rows() );
+
+        // Echelonize the entire matrix Wx = [Ax; Jx] once, so that changes in weights are
+        // handled with basis swaps instead of recomputing the canonical form of Jx each time
+        if(!merged && nz)
+        {
+            echelonizer = EchelonizerExtended(W.leftCols(nx));
+            echelonizer.setOptions(options);
+            merged = true;
+        }
+
+        echelonizer.updateWithPriorityWeights(Matrix(0, nx), weights);
         echelonizer.cleanResidualRoundoffErrors();
 
+        // With Wp constant, Sbp = Rb * Wp changes only if the basic variables or their order have changed
+        const auto jbn = echelonizer.Q();
+        if(jbnSbp.size() == jbn.size() && jbn == jbnSbp)
+            return;
+
+        updateSbp();
+
+        jbnSbp = jbn;
+    }
+
+    /// Update the matrix Sbp = Rb * Wp, where Rb corresponds to the basic variables in the echelon form of Wx.
+    auto updateSbp() -> void
+    {
         const auto nb = echelonizer.numBasicVariables();
-        const auto nn = echelonizer.numNonBasicVariables();
 
         // const auto Rb = echelonizer.R().topRows(nb); // WARNING: This creates dangling references.
         const auto R = echelonizer.R();
         const auto Rb = R.topRows(nb);
+        const auto Wp = W.rightCols(dims.np);
 
-        auto Sbn = S.topLeftCorner(nb, nn);
-        auto Sbp = S.topRightCorner(nb, np);
+        auto Sbpb = Sbp.topRows(nb);
 
-        Sbn = echelonizer.S();
-        Sbp = Rb * Wp;
+        Sbpb = Rb * Wp;
 
-        cleanResidualRoundoffErrors(Sbp);
+        cleanResidualRoundoffErrors(Sbpb);
 
         // NOTE: It seems the following check is not needed. It was preventing a
         // calculation in Reaktoro to be performed. The calculation has a
@@ -137,22 +219,25 @@ struct EchelonizerW::Impl
 
     auto asMatrixViewRWQ() const -> MatrixViewRWQ
     {
-        assert(S.size());
-
-        const auto [nx, np, ny, nz, nw, nt] = dims;
+        assert(W.size());
 
         const auto nb = echelonizer.numBasicVariables();
         const auto nn = echelonizer.numNonBasicVariables();
 
         const auto R   = echelonizer.R();
         const auto Rb  = R.topRows(nb);
-        const auto Sbn = S.topLeftCorner(nb, nn);
-        const auto Sbp = S.topRightCorner(nb, np);
+        const auto Sbn = echelonizer.S(); // the matrix S in the canonical form of Wx is used directly, without a copy
+        const auto Sbpb = Sbp.topRows(nb);
         const auto jbn = echelonizer.Q();
         const auto jb  = jbn.head(nb);
         const auto jn  = jbn.tail(nn);
 
-        return {Rb, Sbn, Sbp, jb, jn};
+        return {Rb, Sbn, Sbpb, jb, jn};
+    }
+
+    auto memoryFootprint() const -> Index
+    {
+        return echelonizer.memoryFootprint() + (W.size() + Sbp.size())*sizeof(double) + (Jxcols.size() + jbnSbp.size())*sizeof(Index);
     }
 };
 
@@ -167,16 +252,37 @@ EchelonizerW::EchelonizerW(const EchelonizerW& other)
 EchelonizerW::~EchelonizerW()
 {}
 
+auto EchelonizerW::setOptions(const EchelonizerOptions& options) -> void
+{
+    pimpl->options = options;
+    pimpl->echelonizer.setOptions(options);
+}
+
 auto EchelonizerW::initialize(const MasterDims& dims, MatrixView Ax, MatrixView Ap) -> void
 {
     pimpl->initialize(dims, Ax, Ap);
 }
 
+auto EchelonizerW::initialize(const MasterDims& dims, MatrixView Ax, MatrixView Ap, IndicesView Jxcols) -> void
+{
+    pimpl->initialize(dims, Ax, Ap, Jxcols);
+}
+
 auto EchelonizerW::update(MatrixView Jx, MatrixView Jp, VectorView weights) -> void
 {
     pimpl->update(Jx, Jp, weights);
 }
 
+auto EchelonizerW::update(VectorView weights) -> void
+{
+    pimpl->update(weights);
+}
+
+auto EchelonizerW::memoryFootprint() const -> Index
+{
+    return pimpl->memoryFootprint();
+}
+
 auto EchelonizerW::W() const -> MatrixViewW
 {
     return pimpl->asMatrixViewW();
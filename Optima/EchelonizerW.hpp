@@ -21,6 +21,7 @@
 #include <memory>
 
 // Optima includes
+#include <Optima/EchelonizerOptions.hpp>
 #include <Optima/MasterDims.hpp>
 #include <Optima/MatrixViewRWQ.hpp>
 #include <Optima/MatrixViewW.hpp>
@@ -48,12 +49,30 @@ public:
     /// Assign a EchelonizerW object to this.
     auto operator=(EchelonizerW other) -> EchelonizerW& = delete;
 
+    /// Set the options for the echelonization of matrix *W*.
+    auto setOptions(const EchelonizerOptions& options) -> void;
+
     /// Initialize only once the *Ax* and *Ap* matrices in case these seldom change.
     auto initialize(const MasterDims& dims, MatrixView Ax, MatrixView Ap) -> void;
 
+    /// Initialize only once the *Ax* and *Ap* matrices in case these seldom change and declare the sparsity pattern of *Jx*.
+    /// @param dims The dimensions of the master variables.
+    /// @param Ax The matrix *Ax* in *W = [Ax Ap; Jx Jp]*.
+    /// @param Ap The matrix *Ap* in *W = [Ax Ap; Jx Jp]*.
+    /// @param Jxcols The indices of the columns of *Jx* that can be non-zero (all others are assumed zero).
+    auto initialize(const MasterDims& dims, MatrixView Ax, MatrixView Ap, IndicesView Jxcols) -> void;
+
     /// Update the echelon form of matrix *W* where only *Jx* and *Jp* have changed.
     auto update(MatrixView Jx, MatrixView Jp, VectorView weights) -> void;
 
+    /// Update the echelon form of matrix *W* where *Jx* and *Jp* are the same as in the last update.
+    /// Use this method when *Jx* and *Jp* are constant. The entire matrix *Wx = [Ax; Jx]* is then
+    /// echelonized once and changes in the priority weights are handled with basis swaps only.
+    auto update(VectorView weights) -> void;
+
+    /// Return the number of bytes used by the matrices and vectors stored in this object.
+    auto memoryFootprint() const -> Index;
+
     /// Return an immutable view to the assembled matrix *W*.
     auto W() const -> MatrixViewW;
 
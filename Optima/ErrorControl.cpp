@@ -27,9 +27,11 @@ namespace Optima {
 
 struct ErrorControl::Impl
 {
-    ErrorStatus errorstatus;         ///< The current error status of the calculation.
-    BacktrackSearch backtracksearch; ///< The backtrack algorithm to correct steps producing infinity errors.
-    LineSearch linesearch;           ///< The line-search algorithm to correct steps producing significant large errors.
+    ErrorStatus errorstatus;          ///< The current error status of the calculation.
+    BacktrackSearch backtracksearch;  ///< The backtrack algorithm to correct steps producing infinity errors.
+    LineSearch linesearch;            ///< The line-search algorithm to correct steps producing significant large errors.
+    LineSearchOptions linesearchopts; ///< The options for the line-search algorithm, including when it is triggered.
+    double error_initial = -1.0;      ///< The error at the start of the calculation (negative if not yet known).
 
     Impl()
     {}
@@ -39,6 +41,7 @@ struct ErrorControl::Impl
         errorstatus.setOptions(options.errorstatus);
         backtracksearch.setOptions(options.backtracksearch);
         linesearch.setOptions(options.linesearch);
+        linesearchopts = options.linesearch;
     }
 
     auto initialize(const MasterProblem& problem) -> void
@@ -46,18 +49,28 @@ struct ErrorControl::Impl
         errorstatus.initialize();
         backtracksearch.initialize(problem);
         linesearch.initialize(problem);
+        error_initial = -1.0;
     }
 
     auto execute(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
     {
         const auto error_prev = E.error();
 
+        if(error_initial < 0.0)
+            error_initial = error_prev;
+
         backtracksearch.execute(uo, u, F, E);
 
         const auto error_new = E.error();
 
-        // if(error_new >= error_prev)
-        //     linesearch.execute(uo, u, F, E);
+        if(!linesearchopts.active)
+            return;
+
+        const auto factor_initial = linesearchopts.trigger_when_current_error_is_greater_than_initial_error_by_factor;
+        const auto factor_prev = linesearchopts.trigger_when_current_error_is_greater_than_previous_error_by_factor;
+
+        if(error_new > factor_initial * error_initial || error_new > factor_prev * error_prev)
+            linesearch.execute(uo, u, F, E);
     }
 };
 
@@ -17,12 +17,134 @@
 
 #include "LineSearch.hpp"
 
+// C++ includes
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/MasterMatrixOps.hpp>
 #include <Optima/Utils.hpp>
 
 namespace Optima {
+namespace {
+
+/// Used to run tasks concurrently on worker threads that are kept alive between runs.
+/// The worker threads are started in the first run and are not shared with copies of this object.
+class TrialWorkers
+{
+public:
+    /// Construct a TrialWorkers object without worker threads.
+    TrialWorkers()
+    {}
+
+    /// Construct a TrialWorkers object without worker threads (these are not shared with `other`).
+    TrialWorkers(const TrialWorkers&)
+    {}
+
+    /// Stop and join the worker threads.
+    ~TrialWorkers()
+    {
+        stop();
+    }
+
+    /// Keep the worker threads of this object (these are not shared with `other`).
+    auto operator=(const TrialWorkers&) -> TrialWorkers&
+    {
+        return *this;
+    }
+
+    /// Run `task(k)` for every `k` in `[0, ntasks)`, each on its own worker thread, and wait until all are done.
+    /// The first exception thrown by the tasks, if any, is rethrown after all tasks are done.
+    auto run(unsigned ntasks, const std::function<void(unsigned)>& task) -> void
+    {
+        if(threads.size() != ntasks)
+        {
+            stop();
+            start(ntasks);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        current = &task;
+        errors.assign(ntasks, nullptr);
+        pending = ntasks;
+        ++generation;
+        wakeup.notify_all();
+        finished.wait(lock, [&] { return pending == 0; });
+        current = nullptr;
+
+        for(const auto& error : errors)
+            if(error) std::rethrow_exception(error);
+    }
+
+private:
+    /// Start the worker threads, stopping those already started if one cannot be started.
+    auto start(unsigned nthreads) -> void
+    {
+        stopping = false;
+        threads.reserve(nthreads);
+        try
+        {
+            for(auto k = 0U; k < nthreads; ++k)
+                threads.emplace_back(&TrialWorkers::work, this, k, generation);
+        }
+        catch(...)
+        {
+            stop();
+            throw;
+        }
+    }
+
+    /// Stop and join the worker threads.
+    auto stop() -> void
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for(auto& thread : threads)
+            thread.join();
+        threads.clear();
+    }
+
+    /// Execute the task `k` of every run until the worker threads are stopped.
+    auto work(unsigned k, std::size_t lastgeneration) -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            wakeup.wait(lock, [&] { return stopping || generation != lastgeneration; });
+            if(stopping)
+                return;
+            lastgeneration = generation;
+            const auto& task = *current;
+            lock.unlock();
+            try { task(k); }
+            catch(...) { errors[k] = std::current_exception(); }
+            lock.lock();
+            if(--pending == 0)
+                finished.notify_one();
+        }
+    }
+
+    std::vector<std::thread> threads;                   ///< The worker threads.
+    std::mutex mutex;                                   ///< The mutex protecting the state below.
+    std::condition_variable wakeup;                     ///< The condition variable that wakes up the worker threads for a new run or to stop.
+    std::condition_variable finished;                   ///< The condition variable that signals that all tasks of a run are done.
+    const std::function<void(unsigned)>* current = {};  ///< The task of the current run.
+    std::vector<std::exception_ptr> errors;             ///< The exceptions thrown by the tasks of the current run.
+    unsigned pending = 0;                               ///< The number of tasks of the current run not done yet.
+    std::size_t generation = 0;                         ///< The number of runs so far.
+    bool stopping = false;                              ///< The flag indicating that the worker threads must stop.
+};
+
+} // namespace
 
 struct LineSearch::Impl
 {
@@ -36,6 +158,11 @@ struct LineSearch::Impl
     MasterVector du;           ///< The Newton step du = u - uo
     MasterVector Jdu;          ///< The multiplication J * du
 
+    std::vector<ResidualFunction> Ftrials; ///< The copies of the residual function used by the worker threads to evaluate the trial step lengths.
+    std::vector<ResidualErrors> Etrials;   ///< The copies of the residual errors used by the worker threads to evaluate the trial step lengths.
+    std::vector<MasterVector> utrials;     ///< The trial states of u used by the worker threads.
+    TrialWorkers workers;                  ///< The worker threads used to evaluate the trial step lengths concurrently.
+
     Impl()
     {}
 
@@ -72,10 +199,12 @@ struct LineSearch::Impl
         assert((u.x.array() <= xupper.array()).all());
         assert((u.x.array() >= xlower.array()).all());
 
+        // The trial points only require function values: the residual vector is computed with the
+        // Jacobian matrices and their echelon and canonical forms of the last update of F
         auto phi = [&](auto alpha)
         {
             utrial = uo*(1 - alpha) + alpha*u;
-            F.update(utrial);
+            F.updateSkipJacobian(utrial);
             E.update(utrial, F);
             return E.error();
         };
@@ -84,17 +213,56 @@ struct LineSearch::Impl
         const auto maxiters = options.maxiterations;
 
         // Minimize phi(alpha) along the path from uo to u for alpha in [0, 1].
-        const auto alphamin = minimizeBrent(phi, 0.0, 1.0, tol, maxiters);
+        const auto alphamin = options.parallel_trials > 1 ?
+            minimizeWithTrials(uo, u, F, E) :
+            minimizeBrent(phi, 0.0, 1.0, tol, maxiters);
 
         u = uo*(1 - alphamin) + alphamin*u; // using uo + alpha*(u - uo) is sensitive to round-off errors!
 
         F.update(u);
         E.update(u, F);
+    }
+
+    /// Return the trial step length with the smallest error among those evenly spaced in (0, 1].
+    /// The trial step lengths are evaluated concurrently on worker threads if the functions support concurrent evaluations.
+    auto minimizeWithTrials(MasterVectorView uo, MasterVectorView u, ResidualFunction& F, ResidualErrors& E) -> double
+    {
+        const auto ntrials = options.parallel_trials;
+
+        std::vector<double> alphas(ntrials);
+        std::vector<double> errors(ntrials, std::numeric_limits<double>::infinity());
+
+        for(auto k = 0U; k < ntrials; ++k)
+            alphas[k] = (k + 1.0)/ntrials;
+
+        auto trial = [&](unsigned k, ResidualFunction& Fk, ResidualErrors& Ek, MasterVector& uk)
+        {
+            uk = uo*(1 - alphas[k]) + alphas[k]*u;
+            Fk.updateSkipJacobian(uk);
+            Ek.update(uk, Fk);
+            errors[k] = Ek.error();
+        };
+
+        if(options.threadsafe)
+        {
+            Ftrials.assign(ntrials, F);
+            Etrials.assign(ntrials, E);
+            utrials.assign(ntrials, utrial);
+            workers.run(ntrials, [&](unsigned k) { trial(k, Ftrials[k], Etrials[k], utrials[k]); });
+        }
+        else
+        {
+            for(auto k = 0U; k < ntrials; ++k)
+                trial(k, F, E, utrial);
+        }
+
+        // Select the step length with the smallest error, preferring the longest among ties
+        auto kmin = ntrials - 1;
+        for(auto k = ntrials - 1; k-- > 0; )
+            if(errors[k] < errors[kmin])
+                kmin = k;
 
-        // TODO: Consider instead setting u = utrial, since utrial has been
-        // updated inside phi calls, and its last update correspond to uo*(1 -
-        // alphamin) + alphamin*u. Also consider not updating F and E above in
-        // this case, which have also been done in the last phi call.
+        return alphas[kmin];
     }
 };
 
@@ -22,6 +22,9 @@ namespace Optima {
 /// The options for the line search minimization operation.
 struct LineSearchOptions
 {
+    /// The boolean flag that indicates if line search is performed when the error after a Newton step grows (see the trigger factors below).
+    bool active = false;
+
     /// The tolerance in the minimization calculation during the line search operation.
     double tolerance = 1.0e-5;
 
@@ -33,6 +36,18 @@ struct LineSearchOptions
 
     /// The parameter that triggers line-search when current error is greater than previous error by a given factor (`Enew > factor*Eold`).
     double trigger_when_current_error_is_greater_than_previous_error_by_factor = 2.0;
+
+    /// The number of trial step lengths evaluated instead of the sequential minimization (disabled if less than two).
+    /// The trial step lengths are evenly spaced in (0, 1] and the one with the smallest error is selected.
+    unsigned parallel_trials = 0;
+
+    /// The boolean flag that indicates if the objective, constraint and resources functions support concurrent evaluations.
+    /// If true, the trial step lengths are evaluated concurrently, each on its own worker thread with its own copy of the
+    /// residual function. If false, they are evaluated one after another on the calling thread.
+    /// The copies share the functions they wrap, so every wrapper between the master problem and the
+    /// user functions (e.g., those created by Solver for the presolved and scaled problems) must also be
+    /// safe to call concurrently, keeping its auxiliary vectors and results in its own copy.
+    bool threadsafe = false;
 };
 
 } // namespace Optima
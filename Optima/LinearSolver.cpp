@@ -21,7 +21,9 @@
 #include <Optima/Exception.hpp>
 #include <Optima/LinearSolverFullspace.hpp>
 #include <Optima/LinearSolverNullspace.hpp>
+#include <Optima/LinearSolverNullspaceBatch.hpp>
 #include <Optima/LinearSolverRangespace.hpp>
+#include <Optima/LinearSolverSparseFullspace.hpp>
 
 namespace Optima {
 
@@ -32,6 +34,8 @@ struct LinearSolver::Impl
     LinearSolverRangespace rangespace; ///< The linear solver based on a rangespace algorithm.
     LinearSolverNullspace nullspace;   ///< The linear solver based on a nullspace algorithm.
     LinearSolverFullspace fullspace;   ///< The linear solver based on a fullspace algorithm.
+    LinearSolverSparseFullspace sparsefullspace; ///< The linear solver based on a fullspace algorithm with sparse LU decomposition.
+    LinearSolverNullspaceBatchEntry nullspacebatch; ///< The decomposition of the canonical matrix in a batch when a batch function is set in the current thread.
 
     Vector x; ///< The auxiliary solution vector x.
     Vector p; ///< The auxiliary solution vector p.
@@ -49,8 +53,12 @@ struct LinearSolver::Impl
     {
         switch(options.method)
         {
-        case LinearSolverMethod::Nullspace: nullspace.solve(Mc, ac, uc); break;
+        case LinearSolverMethod::Nullspace:
+            if(nullspacebatch.batch) nullspacebatch.batch->solve(nullspacebatch.index, Mc, ac, uc);
+            else nullspace.solve(Mc, ac, uc);
+            break;
         case LinearSolverMethod::Rangespace: rangespace.solve(Mc, ac, uc); break;
+        case LinearSolverMethod::SparseFullspace: sparsefullspace.solve(Mc, ac, uc); break;
         default: fullspace.solve(Mc, ac, uc); break;
         }
     }
@@ -59,8 +67,13 @@ struct LinearSolver::Impl
     {
         switch(options.method)
         {
-        case LinearSolverMethod::Nullspace: nullspace.decompose(Mc); break;
+        case LinearSolverMethod::Nullspace:
+            if(const auto& batchfn = threadNullspaceBatchFunction()) nullspacebatch = batchfn(Mc);
+            else nullspacebatch = {};
+            if(!nullspacebatch.batch) nullspace.decompose(Mc);
+            break;
         case LinearSolverMethod::Rangespace: rangespace.decompose(Mc); break;
+        case LinearSolverMethod::SparseFullspace: sparsefullspace.decompose(Mc); break;
         default: fullspace.decompose(Mc); break;
         }
     }
@@ -78,8 +78,20 @@ struct LinearSolverFullspace::Impl
         const auto Opbs  = zeros(np, nbs);
         const auto Obsbs = zeros(nbs, nbs);
 
-        if(nbs) M1 << Hbsbs, Hbsns, Hbsp, Ibsbs;
-        if(nns) M2 << Hnsbs, Hnsns, Hnsp, tr(Sbsns);
+        const auto Obsns = zeros(nbs, nns);
+        const auto Onsns = zeros(nns, nns);
+
+        // Skip reading Hbsns and Hnsns when these are known to be zero
+        if(J.isHss4BasicVars)
+        {
+            if(nbs) M1 << Hbsbs, Obsns, Hbsp, Ibsbs;
+            if(nns) M2 << Hnsbs, Onsns, Hnsp, tr(Sbsns);
+        }
+        else
+        {
+            if(nbs) M1 << Hbsbs, Hbsns, Hbsp, Ibsbs;
+            if(nns) M2 << Hnsbs, Hnsns, Hnsp, tr(Sbsns);
+        }
         if( np) M3 << Vpbs, Vpns, Vpp, Opbs;
         if(nbs) M4 << Ibsbs, Sbsns, Sbsp, Obsbs;
 
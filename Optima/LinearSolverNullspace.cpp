@@ -68,7 +68,11 @@ struct LinearSolverNullspace::Impl
         auto Hsp = Hxp.topRows(ns);
         auto Vps = Vpx.leftCols(ns);
 
-        Hss = J.Hss;
+        // Skip the copy of Hbsns and Hnsns when these are known to be zero (they are assembled below)
+        if(J.isHss4BasicVars)
+            Hss.leftCols(nbs) = J.Hss.leftCols(nbs);
+        else Hss = J.Hss;
+
         Hsp = J.Hsp;
         Vps = J.Vps;
         Vpp = J.Vpp;
@@ -124,9 +128,20 @@ struct LinearSolverNullspace::Impl
         auto M3 = M.middleRows(nbe + nns, np);
         auto M4 = M.bottomRows(nbe);
 
-        Hbins.noalias() -= Hbibi * Sbins;
-        Hbens.noalias() -= Hbebi * Sbins;
-        Hnsns.noalias() -= Hnsbi * Sbins;
+        if(J.isHss4BasicVars)
+        {
+            // Hbsns = 0 and Hnsns = 0, so these blocks are given only by the elimination of xbi
+            Hbins.noalias() = -Hbibi * Sbins;
+            Hbens.noalias() = -Hbebi * Sbins;
+            Hnsns.noalias() = -Hnsbi * Sbins;
+        }
+        else
+        {
+            Hbins.noalias() -= Hbibi * Sbins;
+            Hbens.noalias() -= Hbebi * Sbins;
+            Hnsns.noalias() -= Hnsbi * Sbins;
+        }
+
         Vpns.noalias()  -= Vpbi * Sbins;
 
         Hbip.noalias() -= Hbibi * Sbip;
@@ -0,0 +1,387 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "LinearSolverNullspaceBatch.hpp"
+
+// C++ includes
+#include <cassert>
+
+// Optima includes
+#include <Optima/BatchLU.hpp>
+#include <Optima/Exception.hpp>
+
+namespace Optima {
+namespace {
+
+/// A block of the matrices in a batch, each stored in a row of a matrix in flattened column-major order.
+/// The entry *(i, j)* of the block in all matrices of the batch is a column of this matrix, so that the
+/// operations below are performed on all matrices of the batch with vector instructions.
+struct BatchBlock
+{
+    Matrix& M;  ///< The matrices of the batch, one per row in flattened column-major order.
+    Index ld;   ///< The number of rows of the matrices in the batch.
+    Index i0;   ///< The index of the first row of the block.
+    Index j0;   ///< The index of the first column of the block.
+    Index rows; ///< The number of rows of the block.
+    Index cols; ///< The number of columns of the block.
+
+    /// Return the entry *(i, j)* of the block in all matrices of the batch.
+    auto operator()(Index i, Index j) const { return M.col(i0 + i + (j0 + j)*ld).array(); }
+
+    /// Return a sub-block of this block.
+    auto block(Index i, Index j, Index r, Index c) const -> BatchBlock { return { M, ld, i0 + i, j0 + j, r, c }; }
+};
+
+/// Return a block of the matrices in a batch stored with @ref BatchBlock.
+auto blockOf(Matrix& M, Index ld, Index i, Index j, Index rows, Index cols) -> BatchBlock
+{
+    return { M, ld, i, j, rows, cols };
+}
+
+/// Return the matrix stored in row *k* of a batch in flattened column-major order.
+auto unflatten(const Matrix& M, Index k, Index rows, Index cols)
+{
+    using Stride = Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>;
+    return Eigen::Map<const Matrix, 0, Stride>(M.data() + k, rows, cols, Stride(rows*M.rows(), M.rows()));
+}
+
+/// Store matrix *A* in row *k* of a batch in flattened column-major order.
+auto flatten(MatrixView A, Matrix& M, Index k) -> void
+{
+    for(Index j = 0; j < A.cols(); ++j)
+        for(Index i = 0; i < A.rows(); ++i)
+            M(k, i + j*A.rows()) = A(i, j);
+}
+
+/// Compute C -= A * B for all matrices in the batch.
+auto subtractProduct(BatchBlock C, BatchBlock A, BatchBlock B) -> void
+{
+    assert(C.rows == A.rows && C.cols == B.cols && A.cols == B.rows);
+    for(Index j = 0; j < C.cols; ++j)
+        for(Index i = 0; i < C.rows; ++i)
+            for(Index p = 0; p < A.cols; ++p)
+                C(i, j) -= A(i, p) * B(p, j);
+}
+
+/// Compute C -= tr(A) * B for all matrices in the batch.
+auto subtractTransposeProduct(BatchBlock C, BatchBlock A, BatchBlock B) -> void
+{
+    assert(C.rows == A.cols && C.cols == B.cols && A.rows == B.rows);
+    for(Index j = 0; j < C.cols; ++j)
+        for(Index i = 0; i < C.rows; ++i)
+            for(Index p = 0; p < A.rows; ++p)
+                C(i, j) -= A(p, i) * B(p, j);
+}
+
+/// Compute C = A (or C = tr(A) if *transpose* is true) for all matrices in the batch.
+auto assign(BatchBlock C, BatchBlock A, bool transpose = false) -> void
+{
+    for(Index j = 0; j < C.cols; ++j)
+        for(Index i = 0; i < C.rows; ++i)
+            if(transpose) C(i, j) = A(j, i);
+            else C(i, j) = A(i, j);
+}
+
+/// Compute C = I for all matrices in the batch.
+auto assignIdentity(BatchBlock C) -> void
+{
+    for(Index j = 0; j < C.cols; ++j)
+        for(Index i = 0; i < C.rows; ++i)
+            C(i, j).setConstant(i == j ? 1.0 : 0.0);
+}
+
+/// Compute C = 0 for all matrices in the batch.
+auto assignZero(BatchBlock C) -> void
+{
+    for(Index j = 0; j < C.cols; ++j)
+        for(Index i = 0; i < C.rows; ++i)
+            C(i, j).setZero();
+}
+
+} // namespace
+
+struct LinearSolverNullspaceBatch::Impl
+{
+    Index nmatrices = 0; ///< The number of canonical matrices in the batch.
+    Index ns = 0;        ///< The number of stable variables in the canonical matrices.
+    Index np = 0;        ///< The number of variables p in the canonical matrices.
+    Matrix Hss;          ///< The reduced matrices Hss of the batch in flattened form (one per row).
+    Matrix Hsp;          ///< The reduced matrices Hsp of the batch in flattened form (one per row).
+    Matrix Vps;          ///< The reduced matrices Vps of the batch in flattened form (one per row).
+    Matrix Vpp;          ///< The reduced matrices Vpp of the batch in flattened form (one per row).
+    Matrix Sbsns;        ///< The matrices Sbsns of the batch in flattened form (one per row).
+    Matrix Sbsp;         ///< The matrices Sbsp of the batch in flattened form (one per row).
+    Matrix M;            ///< The matrices M of the batch in flattened form (one per row).
+    BatchLU lu;          ///< The LU decompositions of the matrices M of the batch.
+
+    Impl()
+    {}
+
+    auto decompose(const std::vector<CanonicalMatrix>& Js) -> void
+    {
+        nmatrices = Js.size();
+
+        if(nmatrices == 0)
+            return;
+
+        const auto dims = Js[0].dims;
+
+        for(const auto& J : Js)
+            errorif(J.dims.ns != dims.ns || J.dims.np != dims.np || J.dims.nbe != dims.nbe || J.dims.nbi != dims.nbi || J.dims.nns != dims.nns,
+                "Expecting canonical matrices with the same dimensions in the batch.");
+
+        ns = dims.ns;
+        np = dims.np;
+
+        const auto nbs = dims.nbs;
+        const auto nbe = dims.nbe;
+        const auto nbi = dims.nbi;
+        const auto nns = dims.nns;
+
+        const auto m = nmatrices;
+
+        Hss.resize(m, ns*ns);
+        Hsp.resize(m, ns*np);
+        Vps.resize(m, np*ns);
+        Vpp.resize(m, np*np);
+        Sbsns.resize(m, nbs*nns);
+        Sbsp.resize(m, nbs*np);
+
+        for(Index k = 0; k < m; ++k)
+        {
+            const auto& J = Js[k];
+            flatten(J.Hss, Hss, k);
+            flatten(J.Hsp, Hsp, k);
+            flatten(J.Vps, Vps, k);
+            flatten(J.Vpp, Vpp, k);
+            flatten(J.Sbsns, Sbsns, k);
+            flatten(J.Sbsp, Sbsp, k);
+
+            // Hbsns = 0 and Hnsns = 0 are not stored in Hss, so these blocks are given only by the elimination of xbi below
+            if(J.isHss4BasicVars)
+                Hss.row(k).tail(ns*nns).fill(0.0);
+        }
+
+        const auto HssB = blockOf(Hss, ns, 0, 0, ns, ns);
+        const auto HspB = blockOf(Hsp, ns, 0, 0, ns, np);
+        const auto VpsB = blockOf(Vps, np, 0, 0, np, ns);
+        const auto VppB = blockOf(Vpp, np, 0, 0, np, np);
+
+        const auto Hbebe = HssB.block(0, 0, nbe, nbe);
+        const auto Hbebi = HssB.block(0, nbe, nbe, nbi);
+        const auto Hbibe = HssB.block(nbe, 0, nbi, nbe);
+        const auto Hbibi = HssB.block(nbe, nbe, nbi, nbi);
+        const auto Hbens = HssB.block(0, nbs, nbe, nns);
+        const auto Hbins = HssB.block(nbe, nbs, nbi, nns);
+        const auto Hnsbe = HssB.block(nbs, 0, nns, nbe);
+        const auto Hnsbi = HssB.block(nbs, nbe, nns, nbi);
+        const auto Hnsns = HssB.block(nbs, nbs, nns, nns);
+
+        const auto Hbep = HspB.block(0, 0, nbe, np);
+        const auto Hbip = HspB.block(nbe, 0, nbi, np);
+        const auto Hnsp = HspB.block(nbs, 0, nns, np);
+
+        const auto Vpbe = VpsB.block(0, 0, np, nbe);
+        const auto Vpbi = VpsB.block(0, nbe, np, nbi);
+        const auto Vpns = VpsB.block(0, nbs, np, nns);
+
+        const auto Sbens = blockOf(Sbsns, nbs, 0, 0, nbe, nns);
+        const auto Sbins = blockOf(Sbsns, nbs, nbe, 0, nbi, nns);
+        const auto Sbep  = blockOf(Sbsp, nbs, 0, 0, nbe, np);
+        const auto Sbip  = blockOf(Sbsp, nbs, nbe, 0, nbi, np);
+
+        // The same sequence of reductions of LinearSolverNullspace::decompose, applied to all matrices of the batch
+        subtractProduct(Hbins, Hbibi, Sbins);
+        subtractProduct(Hbens, Hbebi, Sbins);
+        subtractProduct(Hnsns, Hnsbi, Sbins);
+        subtractProduct(Vpns, Vpbi, Sbins);
+
+        subtractProduct(Hbip, Hbibi, Sbip);
+        subtractProduct(Hbep, Hbebi, Sbip);
+        subtractProduct(Hnsp, Hnsbi, Sbip);
+        subtractProduct(VppB, Vpbi, Sbip);
+
+        subtractTransposeProduct(Hnsbe, Sbins, Hbibe);
+        subtractTransposeProduct(Hnsns, Sbins, Hbins);
+        subtractTransposeProduct(Hnsp, Sbins, Hbip);
+
+        const auto t = nbe + nns + np + nbe;
+
+        M.resize(m, t*t);
+
+        const auto MB = blockOf(M, t, 0, 0, t, t);
+
+        const auto r1 = 0;
+        const auto r2 = nbe;
+        const auto r3 = nbe + nns;
+        const auto r4 = nbe + nns + np;
+
+        assign(MB.block(r1, r1, nbe, nbe), Hbebe);
+        assign(MB.block(r1, r2, nbe, nns), Hbens);
+        assign(MB.block(r1, r3, nbe, np), Hbep);
+        assignIdentity(MB.block(r1, r4, nbe, nbe));
+
+        assign(MB.block(r2, r1, nns, nbe), Hnsbe);
+        assign(MB.block(r2, r2, nns, nns), Hnsns);
+        assign(MB.block(r2, r3, nns, np), Hnsp);
+        assign(MB.block(r2, r4, nns, nbe), Sbens, true);
+
+        assign(MB.block(r3, r1, np, nbe), Vpbe);
+        assign(MB.block(r3, r2, np, nns), Vpns);
+        assign(MB.block(r3, r3, np, np), VppB);
+        assignZero(MB.block(r3, r4, np, nbe));
+
+        assignIdentity(MB.block(r4, r1, nbe, nbe));
+        assign(MB.block(r4, r2, nbe, nns), Sbens);
+        assign(MB.block(r4, r3, nbe, np), Sbep);
+        assignZero(MB.block(r4, r4, nbe, nbe));
+
+        if(t) lu.decompose(M);
+    }
+
+    auto solve(Index k, CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) const -> void
+    {
+        assert(k < nmatrices);
+
+        const auto dims = J.dims;
+
+        const auto nx  = dims.nx;
+        const auto nbs = dims.nbs;
+        const auto nbe = dims.nbe;
+        const auto nbi = dims.nbi;
+        const auto nns = dims.nns;
+        const auto nw  = dims.nw;
+
+        assert(dims.ns == ns);
+        assert(dims.np == np);
+
+        const auto Hss = unflatten(this->Hss, k, ns, ns);
+        const auto Hsp = unflatten(this->Hsp, k, ns, np);
+        const auto Vps = unflatten(this->Vps, k, np, ns);
+
+        const auto Hbsbs = Hss.topRows(nbs).leftCols(nbs);
+        const auto Hbsns = Hss.topRows(nbs).rightCols(nns);
+        const auto Hnsbs = Hss.bottomRows(nns).leftCols(nbs);
+
+        const auto Hbebi = Hbsbs.topRows(nbe).rightCols(nbi);
+        const auto Hbibe = Hbsbs.bottomRows(nbi).leftCols(nbe);
+        const auto Hbibi = Hbsbs.bottomRows(nbi).rightCols(nbi);
+
+        const auto Hbins = Hbsns.bottomRows(nbi);
+        const auto Hnsbi = Hnsbs.rightCols(nbi);
+
+        const auto Hbsp = Hsp.topRows(nbs);
+        const auto Hbip = Hbsp.bottomRows(nbi);
+
+        const auto Vpbs = Vps.leftCols(nbs);
+        const auto Vpbi = Vpbs.rightCols(nbi);
+
+        const auto Sbsns = J.Sbsns;
+        const auto Sbsp  = J.Sbsp;
+
+        const auto Sbins = Sbsns.bottomRows(nbi);
+        const auto Sbip  = Sbsp.bottomRows(nbi);
+
+        Vector ax(nx);
+        auto as  = ax.head(ns);
+        auto abs = as.head(nbs);
+        auto ans = as.tail(nns);
+        auto abe = abs.head(nbe);
+        auto abi = abs.tail(nbi);
+
+        Vector aw(nw);
+        auto awbs = aw.head(nbs);
+        auto awbe = awbs.head(nbe);
+        auto awbi = awbs.tail(nbi);
+
+        Vector ap;
+
+        as = a.xs;
+        ap = a.p;
+        awbs = a.wbs;
+
+        abi.noalias() -= Hbibi * awbi;
+        abe.noalias() -= Hbebi * awbi;
+        ans.noalias() -= Hnsbi * awbi;
+        ap.noalias()  -= Vpbi * awbi;
+
+        ans -= tr(Sbins) * abi;
+
+        const auto t = nbe + nns + np + nbe;
+
+        Vector r(t);
+
+        auto dxbe = r.head(nbe);
+        auto dxns = r.segment(nbe, nns);
+        auto dp   = r.segment(nbe + nns, np);
+        auto dwbe = r.tail(nbe);
+
+        if(t) r << abe, ans, ap, awbe;
+
+        if(t) lu.solve(k, r);
+
+        auto dxbi = awbi;
+        auto dwbi = abi;
+
+        dxbi.noalias() = awbi - Sbins*dxns - Sbip*dp;
+        dwbi.noalias() = abi - Hbibe*dxbe - Hbins*dxns - Hbip*dp;
+
+        u.xs << dxbe, dxbi, dxns;
+        u.p = dp;
+        u.wbs << dwbe, dwbi;
+    }
+};
+
+LinearSolverNullspaceBatch::LinearSolverNullspaceBatch()
+: pimpl(new Impl())
+{}
+
+LinearSolverNullspaceBatch::LinearSolverNullspaceBatch(const LinearSolverNullspaceBatch& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+LinearSolverNullspaceBatch::~LinearSolverNullspaceBatch()
+{}
+
+auto LinearSolverNullspaceBatch::operator=(LinearSolverNullspaceBatch other) -> LinearSolverNullspaceBatch&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto LinearSolverNullspaceBatch::size() const -> Index
+{
+    return pimpl->nmatrices;
+}
+
+auto LinearSolverNullspaceBatch::decompose(const std::vector<CanonicalMatrix>& Ms) -> void
+{
+    pimpl->decompose(Ms);
+}
+
+auto LinearSolverNullspaceBatch::solve(Index k, CanonicalMatrix M, CanonicalVectorView a, CanonicalVectorRef u) const -> void
+{
+    pimpl->solve(k, M, a, u);
+}
+
+auto threadNullspaceBatchFunction() -> LinearSolverNullspaceBatchFunction&
+{
+    thread_local LinearSolverNullspaceBatchFunction function;
+    return function;
+}
+
+} // namespace Optima
@@ -0,0 +1,90 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Optima includes
+#include <Optima/CanonicalMatrix.hpp>
+#include <Optima/CanonicalVector.hpp>
+
+namespace Optima {
+
+/// Used to solve linear problems in their canonical form for many canonical matrices with the same dimensions together.
+/// This is the batch counterpart of LinearSolverNullspace. The reduction of the canonical matrices and the LU
+/// decompositions of the reduced matrices are computed for all of them at once, one canonical matrix per SIMD lane
+/// (see @ref BatchLU), after which the linear problem of each canonical matrix can be solved independently.
+class LinearSolverNullspaceBatch
+{
+public:
+    /// Construct a LinearSolverNullspaceBatch instance.
+    LinearSolverNullspaceBatch();
+
+    /// Construct a copy of a LinearSolverNullspaceBatch instance.
+    LinearSolverNullspaceBatch(const LinearSolverNullspaceBatch& other);
+
+    /// Destroy this LinearSolverNullspaceBatch instance.
+    virtual ~LinearSolverNullspaceBatch();
+
+    /// Assign a LinearSolverNullspaceBatch instance to this.
+    auto operator=(LinearSolverNullspaceBatch other) -> LinearSolverNullspaceBatch&;
+
+    /// Return the number of canonical matrices decomposed in the batch.
+    auto size() const -> Index;
+
+    /// Decompose the canonical matrices, which must have the same dimensions.
+    auto decompose(const std::vector<CanonicalMatrix>& Ms) -> void;
+
+    /// Solve the linear problem in its canonical form with the *k*-th canonical matrix in the batch.
+    /// Using this method presumes method @ref decompose has already been
+    /// called. It can be called concurrently for different canonical matrices.
+    /// @param k The index of the canonical matrix in the batch.
+    /// @param M The *k*-th canonical matrix given to @ref decompose.
+    /// @param a The right-hand side canonical vector in the canonical linear problem.
+    /// @param[out] u The solution vector in the canonical linear problem.
+    auto solve(Index k, CanonicalMatrix M, CanonicalVectorView a, CanonicalVectorRef u) const -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+/// Used to refer to the decomposition of a canonical matrix in a LinearSolverNullspaceBatch object.
+struct LinearSolverNullspaceBatchEntry
+{
+    /// The batch in which the canonical matrix has been decomposed (empty if it has not).
+    std::shared_ptr<const LinearSolverNullspaceBatch> batch;
+
+    /// The index of the canonical matrix in the batch.
+    Index index = 0;
+};
+
+/// The function type used to decompose a canonical matrix together with the canonical matrices of other calculations.
+using LinearSolverNullspaceBatchFunction = std::function<LinearSolverNullspaceBatchEntry(CanonicalMatrix)>;
+
+/// Return the function used by LinearSolver with method Nullspace in the current thread to decompose canonical matrices in batches.
+/// This is set by BatchSolver in the threads of its calculations only, for the duration of each calculation, so that
+/// the canonical matrices of its calculations with the same dimensions are decomposed at once. The canonical matrix
+/// is decomposed on its own if this function is empty, which is the case in any other thread.
+auto threadNullspaceBatchFunction() -> LinearSolverNullspaceBatchFunction&;
+
+} // namespace Optima
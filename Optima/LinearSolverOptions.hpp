@@ -50,6 +50,22 @@ enum class LinearSolverMethod
     /// n_x}, and matrix \eq{W_x}, \eq{n_w \times n_x}.
     /// @warning This method should only be used when the Hessian matrix is diagonal.
     Rangespace,
+
+    /// This method solves the linear problem using a sparse LU decomposition of the canonical master matrix.
+    /// This method is equivalent to @ref Fullspace, but the canonical master
+    /// matrix is assembled in sparse format and decomposed with a sparse LU
+    /// solver that uses a fill-reducing column ordering. The symbolic analysis
+    /// of the sparsity pattern is reused for as long as this pattern (which
+    /// depends on the sets of basic, non-basic and stable variables) remains
+    /// unchanged. This method only reduces the cost of the factorization:
+    /// the canonical master matrix is assembled by scanning the dense blocks
+    /// produced by the dense canonicalization of \eq{W_x}, not from the
+    /// declared structure of \eq{H_{xx}} and \eq{W_x}, so the memory and the
+    /// assembly cost still grow with the square of the number of variables.
+    /// This method is suitable for problems of moderate size whose canonical
+    /// master matrices remain sparse (e.g., with diagonal or block-diagonal
+    /// \eq{H_{xx}} and few non-zero entries in \eq{S} and \eq{V_{px}}).
+    SparseFullspace,
 };
 
 /// Used to specify the options for the solution of linear problems.
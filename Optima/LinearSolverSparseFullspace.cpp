@@ -0,0 +1,290 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "LinearSolverSparseFullspace.hpp"
+
+// C++ includes
+#include <vector>
+
+// Eigen includes
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+
+// Optima includes
+#include <Optima/LinearSolverFullspace.hpp>
+
+namespace Optima {
+
+struct LinearSolverSparseFullspace::Impl
+{
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using SparseLU = Eigen::SparseLU<SparseMatrix, Eigen::COLAMDOrdering<int>>;
+    using Triplet = Eigen::Triplet<double>;
+
+    SparseMatrix mat;              ///< The sparse canonical master matrix assembled in the decompose method.
+    SparseMatrix pattern;          ///< The sparse matrix whose sparsity pattern was last used in the symbolic analysis of the LU solver.
+    Index nbs = 0;                 ///< The number of stable basic variables in the canonical master matrix whose sparsity pattern was last analyzed.
+    Index nns = 0;                 ///< The number of stable non-basic variables in the canonical master matrix whose sparsity pattern was last analyzed.
+    Index np = 0;                  ///< The number of variables p in the canonical master matrix whose sparsity pattern was last analyzed.
+    Indices jb;                    ///< The basic variables of the canonical master matrix whose sparsity pattern was last analyzed.
+    Indices js;                    ///< The stable variables of the canonical master matrix whose sparsity pattern was last analyzed.
+    bool isHss4BasicVars = false;  ///< The structure flag of Hss of the canonical master matrix whose sparsity pattern was last analyzed.
+    bool isHssDiagonal = false;    ///< The diagonal flag of Hss of the canonical master matrix whose sparsity pattern was last analyzed.
+    std::vector<Triplet> triplets; ///< The workspace for the non-zero entries of the sparse canonical master matrix.
+    Vector vec;                    ///< The vector used as a workspace for the solve method.
+    Vector sol;                    ///< The vector used as a workspace for the solution in the solve method.
+    SparseLU lu;                   ///< The sparse LU decomposition solver.
+    LinearSolverFullspace dense;   ///< The dense linear solver used when the sparse LU decomposition fails (e.g., singular canonical matrix).
+    bool analyzed = false;         ///< The flag that indicates whether a symbolic analysis of the sparsity pattern is available.
+    bool usedense = false;         ///< The flag that indicates whether the last decomposition was performed with the dense linear solver.
+
+    Impl()
+    {}
+
+    Impl(const Impl& other)
+    : mat(other.mat), pattern(other.pattern), nbs(other.nbs), nns(other.nns), np(other.np), jb(other.jb), js(other.js),
+      isHss4BasicVars(other.isHss4BasicVars), isHssDiagonal(other.isHssDiagonal),
+      triplets(other.triplets), vec(other.vec), sol(other.sol),
+      dense(other.dense), analyzed(other.analyzed), usedense(other.usedense)
+    {
+        // The sparse LU solver cannot be copied, so redo its decomposition if needed
+        if(analyzed) lu.analyzePattern(pattern);
+        if(analyzed && !usedense && mat.rows()) lu.factorize(mat);
+    }
+
+    /// Append the non-zero entries of a dense block starting at row `i0` and column `j0` of the canonical master matrix.
+    template<typename Block>
+    auto append(const Block& B, Index i0, Index j0) -> void
+    {
+        for(Index j = 0; j < B.cols(); ++j)
+            for(Index i = 0; i < B.rows(); ++i)
+                if(B(i, j) != 0.0)
+                    triplets.emplace_back(i0 + i, j0 + j, B(i, j));
+    }
+
+    /// Append the non-zero entries of the transpose of a dense block starting at row `i0` and column `j0` of the canonical master matrix.
+    template<typename Block>
+    auto appendTransposed(const Block& B, Index i0, Index j0) -> void
+    {
+        for(Index j = 0; j < B.cols(); ++j)
+            for(Index i = 0; i < B.rows(); ++i)
+                if(B(i, j) != 0.0)
+                    triplets.emplace_back(i0 + j, j0 + i, B(i, j));
+    }
+
+    /// Append the entries of an identity block of dimension `n` starting at row `i0` and column `j0` of the canonical master matrix.
+    auto appendIdentity(Index n, Index i0, Index j0) -> void
+    {
+        for(Index i = 0; i < n; ++i)
+            triplets.emplace_back(i0 + i, j0 + i, 1.0);
+    }
+
+    /// Append the diagonal entries of a dense square block starting at row and column `i0` of the canonical master matrix, zero or not.
+    template<typename Block>
+    auto appendDiagonal(const Block& B, Index i0) -> void
+    {
+        for(Index i = 0; i < B.rows(); ++i)
+            triplets.emplace_back(i0 + i, i0 + i, B(i, i));
+    }
+
+    /// Append explicit zeros at the positions of the sparsity pattern used in the last symbolic analysis.
+    auto appendPattern() -> void
+    {
+        for(Index j = 0; j < pattern.outerSize(); ++j)
+            for(SparseMatrix::InnerIterator it(pattern, j); it; ++it)
+                triplets.emplace_back(it.row(), it.col(), 0.0);
+    }
+
+    /// Return true if the structure of the canonical master matrix is the same as the one whose sparsity pattern was last analyzed.
+    auto sameStructureAsAnalyzed(const CanonicalMatrix& J) const -> bool
+    {
+        return analyzed &&
+            J.dims.nbs == nbs && J.dims.nns == nns && J.dims.np == np &&
+            J.isHss4BasicVars == isHss4BasicVars && J.isHssDiagonal == isHssDiagonal &&
+            J.jb.size() == jb.size() && J.jb == jb &&
+            J.js.size() == js.size() && J.js == js;
+    }
+
+    auto decompose(CanonicalMatrix J) -> void
+    {
+        const auto dims = J.dims;
+
+        const auto ns  = dims.ns;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+        const auto np  = dims.np;
+
+        const auto t = ns + np + nbs;
+
+        const auto Hbsbs = J.Hss.topRows(nbs).leftCols(nbs);
+        const auto Hbsns = J.Hss.topRows(nbs).rightCols(nns);
+        const auto Hnsbs = J.Hss.bottomRows(nns).leftCols(nbs);
+        const auto Hnsns = J.Hss.bottomRows(nns).rightCols(nns);
+
+        const auto Hbsp = J.Hsp.topRows(nbs);
+        const auto Hnsp = J.Hsp.bottomRows(nns);
+
+        const auto Sbsns = J.Sbsns;
+        const auto Sbsp  = J.Sbsp;
+
+        const auto Vpbs = J.Vps.leftCols(nbs);
+        const auto Vpns = J.Vps.rightCols(nns);
+        const auto Vpp  = J.Vpp;
+
+        // The offsets of the block rows/columns in M = [M1; M2; M3; M4] and u = (xbs, xns, p, wbs)
+        const auto ibs = 0;
+        const auto ins = nbs;
+        const auto ip  = nbs + nns;
+        const auto iw  = nbs + nns + np;
+
+        // The off-diagonal entries of Hss are structurally zero if Hxx was declared diagonal
+        const auto offdiagHss = !J.isHssDiagonal;
+
+        // Keep the analyzed sparsity pattern, with explicit zeros where needed, while the structure of the matrix is unchanged
+        const auto samestructure = sameStructureAsAnalyzed(J);
+
+        triplets.clear();
+
+        if(samestructure)
+            appendPattern();
+
+        // Assemble M1 = [Hbsbs Hbsns Hbsp Ibsbs]
+        if(offdiagHss) append(Hbsbs, ibs, ibs);
+        else appendDiagonal(Hbsbs, ibs);
+        if(offdiagHss && !J.isHss4BasicVars) append(Hbsns, ibs, ins);
+        append(Hbsp, ibs, ip);
+        appendIdentity(nbs, ibs, iw);
+
+        // Assemble M2 = [Hnsbs Hnsns Hnsp tr(Sbsns)]
+        if(offdiagHss) append(Hnsbs, ins, ibs);
+        if(offdiagHss && !J.isHss4BasicVars) append(Hnsns, ins, ins);
+        else if(!J.isHss4BasicVars) appendDiagonal(Hnsns, ins);
+        append(Hnsp, ins, ip);
+        appendTransposed(Sbsns, ins, iw);
+
+        // Assemble M3 = [Vpbs Vpns Vpp 0]
+        append(Vpbs, ip, ibs);
+        append(Vpns, ip, ins);
+        append(Vpp, ip, ip);
+
+        // Assemble M4 = [Ibsbs Sbsns Sbsp 0]
+        appendIdentity(nbs, iw, ibs);
+        append(Sbsns, iw, ins);
+        append(Sbsp, iw, ip);
+
+        mat.resize(t, t);
+        mat.setFromTriplets(triplets.begin(), triplets.end());
+        mat.makeCompressed();
+
+        usedense = false;
+
+        if(t == 0) return;
+
+        // The assembled matrix contains the analyzed pattern if the structure is unchanged, so a new non-zero entry is detected by its count
+        if(!samestructure || mat.nonZeros() != pattern.nonZeros())
+        {
+            lu.analyzePattern(mat);
+            pattern = mat;
+            this->nbs = nbs;
+            this->nns = nns;
+            this->np = np;
+            jb = J.jb;
+            js = J.js;
+            isHss4BasicVars = J.isHss4BasicVars;
+            isHssDiagonal = J.isHssDiagonal;
+            analyzed = true;
+        }
+
+        lu.factorize(mat);
+
+        // Resort to the dense linear solver, which is rank-revealing, if the sparse LU decomposition failed
+        if(lu.info() != Eigen::Success)
+        {
+            dense.decompose(J);
+            usedense = true;
+        }
+    }
+
+    auto solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+    {
+        if(usedense)
+        {
+            dense.solve(J, a, u);
+            return;
+        }
+
+        const auto dims = J.dims;
+
+        const auto ns  = dims.ns;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+        const auto np  = dims.np;
+        const auto nt  = dims.nt;
+
+        const auto t = ns + np + nbs;
+
+        vec.resize(nt);
+        auto r = vec.head(t);
+
+        const auto axs  = a.xs;
+        const auto ap   = a.p;
+        const auto awbs = a.wbs;
+
+        r << axs, ap, awbs;
+
+        sol.resize(t);
+        if(t) sol = lu.solve(r);
+
+        const auto xbs = sol.head(nbs);
+        const auto xns = sol.segment(nbs, nns);
+        const auto p   = sol.segment(nbs + nns, np);
+        const auto wbs = sol.tail(nbs);
+
+        u.xs << xbs, xns;
+        u.p = p;
+        u.wbs = wbs;
+    }
+};
+
+LinearSolverSparseFullspace::LinearSolverSparseFullspace()
+: pimpl(new Impl())
+{}
+
+LinearSolverSparseFullspace::LinearSolverSparseFullspace(const LinearSolverSparseFullspace& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+LinearSolverSparseFullspace::~LinearSolverSparseFullspace()
+{}
+
+auto LinearSolverSparseFullspace::operator=(LinearSolverSparseFullspace other) -> LinearSolverSparseFullspace&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto LinearSolverSparseFullspace::decompose(CanonicalMatrix M) -> void
+{
+    pimpl->decompose(M);
+}
+
+auto LinearSolverSparseFullspace::solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+{
+    pimpl->solve(J, a, u);
+}
+
+} // namespace Optima
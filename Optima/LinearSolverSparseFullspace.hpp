@@ -0,0 +1,71 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/MasterDims.hpp>
+#include <Optima/CanonicalMatrix.hpp>
+#include <Optima/CanonicalVector.hpp>
+
+namespace Optima {
+
+/// Used to solve linear problems in their canonical form using a sparse LU decomposition.
+/// The canonical master matrix is assembled in sparse format and decomposed
+/// with a sparse LU solver that uses a fill-reducing column ordering. The
+/// off-diagonal entries of Hss are skipped when Hxx is declared diagonal. The
+/// symbolic analysis of the sparsity pattern is reused in subsequent
+/// decompositions for as long as the partition of the variables is unchanged
+/// and no entry becomes non-zero outside this pattern. Entries of the pattern
+/// that happen to be zero in a decomposition are stored as explicit zeros.
+class LinearSolverSparseFullspace
+{
+public:
+    /// Construct a LinearSolverSparseFullspace instance.
+    LinearSolverSparseFullspace();
+
+    /// Construct a copy of a LinearSolverSparseFullspace instance.
+    LinearSolverSparseFullspace(const LinearSolverSparseFullspace& other);
+
+    /// Destroy this LinearSolverSparseFullspace instance.
+    virtual ~LinearSolverSparseFullspace();
+
+    /// Assign a LinearSolverSparseFullspace instance to this.
+    auto operator=(LinearSolverSparseFullspace other) -> LinearSolverSparseFullspace&;
+
+    /// Decompose the canonical matrix.
+    auto decompose(CanonicalMatrix M) -> void;
+
+    /// Solve the linear problem in its canonical form.
+    /// Using this method presumes method @ref decompose has already been
+    /// called. This will allow you to reuse the decomposition of the master
+    /// matrix for multiple solve computations if needed.
+    /// @param M The canonical matrix in the canonical linear problem.
+    /// @param a The right-hand side canonical vector in the canonical linear problem.
+    /// @param[out] u The solution  vector in the canonical linear problem.
+    auto solve(CanonicalMatrix M, CanonicalVectorView a, CanonicalVectorRef u) -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -40,6 +40,9 @@ struct MasterDims
     MasterDims(Index nx, Index np, Index ny, Index nz)
     : nx(nx), np(np), ny(ny), nz(nz), nw(ny + nz), nt(nx + np + nw) {}
 
+    /// Construct a copy of a MasterDims object.
+    MasterDims(const MasterDims& other) = default;
+
     /// Assign another MasterDims object to this.
     auto operator=(const MasterDims& other) -> MasterDims&
     {
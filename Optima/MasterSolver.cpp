@@ -17,8 +17,17 @@
 
 #include "MasterSolver.hpp"
 
+// C++ includes
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
 // Optima includes
 #include <Optima/Convergence.hpp>
+#include <Optima/Decomposer.hpp>
 #include <Optima/ErrorControl.hpp>
 #include <Optima/Exception.hpp>
 #include <Optima/MasterProblem.hpp>
@@ -29,7 +38,9 @@
 #include <Optima/ResidualErrors.hpp>
 #include <Optima/ResidualFunction.hpp>
 #include <Optima/Result.hpp>
+#include <Optima/Scaler.hpp>
 #include <Optima/SensitivitySolver.hpp>
+#include <Optima/Timing.hpp>
 #include <Optima/TransformStep.hpp>
 
 namespace Optima {
@@ -40,6 +51,16 @@ const auto STOP     = false;
 struct MasterSolver::Impl
 {
     MasterDims dims;
+    Decomposer decomposer;
+    std::vector<MasterSolver> bsolvers;      ///< The solvers of the independent blocks of the master problem.
+    std::vector<MasterState> bstates;        ///< The states of the independent blocks of the master problem.
+    std::vector<Result> bresults;            ///< The results of the independent blocks of the master problem.
+    bool decomposed = false;                 ///< True if the master problem was solved as independent blocks in the last solve.
+    const MasterProblem* pproblem = nullptr; ///< The master problem in the current calculation.
+    MasterState* pstate = nullptr;           ///< The master state in the current calculation.
+    bool iterating = false;                  ///< True if the current calculation needs further iterations.
+    bool hasconverged = false;               ///< True if the current calculation has converged.
+    Scaler scaler;
     ResidualFunction F;
     ResidualErrors E;
     MasterVector uo;
@@ -51,6 +72,9 @@ struct MasterSolver::Impl
     Outputter outputter; ///< The object used to output the current state of the computation.
     Result result;
     Options options;
+    Time tstart;        ///< The time at which the last solve started.
+    MasterVector ubest; ///< The iterate with the smallest error so far in the current solve.
+    double errorbest;   ///< The error of the iterate with the smallest error so far in the current solve.
 
     Impl()
     {}
@@ -114,18 +138,226 @@ struct MasterSolver::Impl
 
     auto solve(const MasterProblem& problem, MasterState& state) -> Result
     {
-        auto& u = state.u;
-        initialize(problem, u);
-        do step(u); while(stepping(u));
-        finalize(state);
-        return result;
+        if(decompose(problem, state))
+            return solveBlocks(state);
+        start(problem, state);
+        while(step()) {}
+        return finish();
     }
 
-    auto solve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitity) -> Result
+    auto solve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitivity) -> Result
     {
         solve(problem, state);
+        return sensitivities(sensitivity);
+    }
+
+    auto begin(const MasterProblem& problem, MasterState& state) -> void
+    {
+        if(decompose(problem, state))
+            beginBlocks(state);
+        else start(problem, state);
+    }
+
+    auto step() -> bool
+    {
+        if(decomposed)
+            return stepBlocks();
+        if(!iterating)
+            return false;
+        auto& u = pstate->u;
+        step(u);
+        iterating = stepping(u);
+        return iterating;
+    }
+
+    auto converged() const -> bool
+    {
+        if(decomposed)
+        {
+            for(const auto& bsolver : bsolvers)
+                if(!bsolver.converged()) return false;
+            return true;
+        }
+        return hasconverged;
+    }
+
+    auto finish() -> Result
+    {
+        if(decomposed)
+            return finishBlocks();
+        if(iterating) // the host stopped stepping the calculation before it ended
+        {
+            result.failure_reason = "cancelled";
+            restoreBestIterate(pstate->u);
+            iterating = false;
+        }
+        finalize(*pstate);
+        scaler.unscale(*pstate);
+        return result;
+    }
+
+    auto finish(MasterSensitivity& sensitivity) -> Result
+    {
+        finish();
+        return sensitivities(sensitivity);
+    }
+
+    /// Compute the sensitivity derivatives at the end of the current calculation.
+    auto sensitivities(MasterSensitivity& sensitivity) -> Result
+    {
+        auto& state = *pstate;
+        if(decomposed) // the sensitivities are computed for the entire problem, which has not been initialized
+        {
+            scaler.initialize(*pproblem);
+            F.initialize(scaler.problem());
+            sensitivitysolver.initialize(scaler.problem());
+        }
+        scaler.scale(state.u); // the scaling factors are powers of two, so state.u is recovered exactly
         F.updateOnlyJacobian(state.u); // update the Jacobian matrices wrt x, p, c
-        sensitivitysolver.solve(F, state, sensitity);
+        sensitivitysolver.solve(F, state, sensitivity);
+        scaler.unscale(state.u);
+        scaler.unscale(sensitivity);
+        return result;
+    }
+
+    /// Initialize the decomposition of the master problem and return `true` if it is solved as independent blocks.
+    auto decompose(const MasterProblem& problem, MasterState& state) -> bool
+    {
+        tstart = timenow();
+        pproblem = &problem;
+        pstate = &state;
+        iterating = false;
+        hasconverged = false;
+        decomposer.initialize(problem, state.u);
+        decomposed = decomposer.blocks().size() > 1;
+        return decomposed;
+    }
+
+    /// Start the calculation of the master problem as a whole, before its iterations.
+    auto start(const MasterProblem& problem, MasterState& state) -> void
+    {
+        auto& u = state.u;
+        scaler.initialize(problem);
+        scaler.scale(u);
+        initialize(scaler.problem(), u);
+        result.failure_reason = convergence.failure(); // e.g., the linear equality constraints are inconsistent
+        if(result.failure_reason.empty())
+            result.failure_reason = interruption();
+        iterating = result.failure_reason.empty();
+    }
+
+    /// Return the options used for the blocks of the master problem.
+    auto blockOptions() const -> Options
+    {
+        auto bopts = options;
+        bopts.decomposer.active = false;
+        bopts.output.active = false; // the blocks cannot share the output of the entire problem
+        if(options.timeout > 0.0) // the blocks share the wall time of the entire problem
+            bopts.timeout = std::max(options.timeout - elapsed(tstart), std::numeric_limits<double>::min());
+        return bopts;
+    }
+
+    /// Prepare the solvers and states of the blocks of the master problem.
+    auto prepareBlocks(MasterState& state) -> void
+    {
+        const auto& blocks = decomposer.blocks();
+        const auto nblocks = blocks.size();
+
+        bsolvers.resize(nblocks);
+        bstates.resize(nblocks);
+        bresults.resize(nblocks);
+
+        for(auto k = 0U; k < nblocks; ++k)
+        {
+            bstates[k].u.resize(blocks[k].problem.dims);
+            decomposer.split(state.u, k, bstates[k].u);
+        }
+    }
+
+    /// Solve the independent blocks of the master problem, concurrently if more than one thread is allowed.
+    auto solveBlocks(MasterState& state) -> Result
+    {
+        const auto& blocks = decomposer.blocks();
+        const auto nblocks = blocks.size();
+
+        prepareBlocks(state);
+
+        std::vector<std::exception_ptr> errors(nblocks);
+
+        auto solveblock = [&](std::size_t k)
+        {
+            try { bsolvers[k].setOptions(blockOptions()); bresults[k] = bsolvers[k].solve(blocks[k].problem, bstates[k]); }
+            catch(...) { errors[k] = std::current_exception(); }
+        };
+
+        const auto nthreads = std::min<std::size_t>(options.decomposer.threads, nblocks);
+
+        if(nthreads < 2)
+            for(auto k = 0U; k < nblocks; ++k)
+                solveblock(k);
+        else
+        {
+            std::atomic<std::size_t> next(0);
+            std::vector<std::thread> workers;
+            workers.reserve(nthreads);
+            for(auto i = 0U; i < nthreads; ++i)
+                workers.emplace_back([&] { for(auto k = next++; k < nblocks; k = next++) solveblock(k); });
+            for(auto& worker : workers)
+                worker.join();
+        }
+
+        for(const auto& error : errors)
+            if(error) std::rethrow_exception(error);
+
+        return mergeBlocks(state);
+    }
+
+    /// Start the calculations of the independent blocks of the master problem, before their iterations.
+    auto beginBlocks(MasterState& state) -> void
+    {
+        const auto& blocks = decomposer.blocks();
+
+        prepareBlocks(state);
+
+        for(auto k = 0U; k < blocks.size(); ++k)
+        {
+            bsolvers[k].setOptions(blockOptions());
+            bsolvers[k].begin(blocks[k].problem, bstates[k]);
+        }
+    }
+
+    /// Perform one iteration in each block of the master problem whose calculation has not ended.
+    auto stepBlocks() -> bool
+    {
+        auto unfinished = false;
+        for(auto& bsolver : bsolvers)
+            unfinished = bsolver.step() || unfinished;
+        return unfinished;
+    }
+
+    /// End the calculations of the independent blocks of the master problem.
+    auto finishBlocks() -> Result
+    {
+        for(auto k = 0U; k < bsolvers.size(); ++k)
+            bresults[k] = bsolvers[k].finish();
+        return mergeBlocks(*pstate);
+    }
+
+    /// Assemble the state and result of the master problem from those of its independent blocks.
+    auto mergeBlocks(MasterState& state) -> Result
+    {
+        decomposer.merge(bstates, state);
+
+        result = {};
+        result.succeeded = true;
+        for(const auto& bresult : bresults)
+        {
+            if(!bresult.succeeded && result.succeeded)
+                result.failure_reason = bresult.failure_reason;
+            result.succeeded = result.succeeded && bresult.succeeded;
+            result.iterations = std::max(result.iterations, bresult.iterations);
+        }
+
         return result;
     }
 
@@ -134,6 +366,9 @@ struct MasterSolver::Impl
         options = opts;
         newtonstep.setOptions(opts.newtonstep);
         convergence.setOptions(opts.convergence);
+        F.setOptions(opts.residualfunction);
+        scaler.setOptions(opts.scaler);
+        decomposer.setOptions(opts.decomposer);
         errorcontrol.setOptions({opts.errorstatus, opts.backtracksearch, opts.linesearch});
         outputter.setOptions(opts.output);
     }
@@ -148,12 +383,15 @@ struct MasterSolver::Impl
         uo = u;
         F.initialize(problem);
         F.update(u);
-        E.initialize(problem);
+        if(scaler.scaled()) E.initialize(problem, scaler.dx(), scaler.dw());
+        else E.initialize(problem);
         E.update(u, F);
+        ubest = u;
+        errorbest = E.error();
         transformstep.initialize(problem);
         newtonstep.initialize(problem);
         errorcontrol.initialize(problem);
-        convergence.initialize(problem);
+        convergence.initialize(problem, F);
         sensitivitysolver.initialize(problem);
         outputter.clear();
         outputHeaderTop();
@@ -162,12 +400,53 @@ struct MasterSolver::Impl
     auto stepping(MasterVectorRef u) -> bool
     {
         convergence.update(E);
+        if(E.error() < errorbest)
+        {
+            ubest = u;
+            errorbest = E.error();
+        }
         if(result.iterations > options.maxiters)
+        {
+            result.failure_reason = "maxiters";
             return STOP;
+        }
         ConvergenceCheckArgs args{dims, F, E, uo, u, result};
         auto converged = convergence.converged(args);
         uo = u;
-        return converged ? STOP : CONTINUE;
+        hasconverged = converged;
+        if(converged)
+            return STOP;
+        result.failure_reason = convergence.failure();
+        if(!result.failure_reason.empty())
+            return STOP;
+        result.failure_reason = interruption();
+        if(!result.failure_reason.empty())
+        {
+            restoreBestIterate(u);
+            return STOP;
+        }
+        return CONTINUE;
+    }
+
+    /// Return `cancelled` or `timeout` if the calculation must be interrupted (empty otherwise).
+    auto interruption() const -> std::string
+    {
+        if(options.cancellation.cancelled())
+            return "cancelled";
+        if(options.timeout > 0.0 && elapsed(tstart) > options.timeout)
+            return "timeout";
+        return "";
+    }
+
+    /// Replace the current iterate by the one with the smallest error so far.
+    auto restoreBestIterate(MasterVectorRef u) -> void
+    {
+        if(errorbest >= E.error())
+            return;
+        u = ubest;
+        uo = u;
+        F.update(u);
+        E.update(u, F);
     }
 
     auto step(MasterVectorRef u) -> void
@@ -183,7 +462,7 @@ struct MasterSolver::Impl
 
     auto finalize(MasterState& state) -> void
     {
-        result.succeeded = result.iterations <= options.maxiters;
+        result.succeeded = result.failure_reason.empty();
         outputCurrentState();
         outputHeaderBottom();
         auto const& Fresult = F.result();
@@ -244,4 +523,29 @@ auto MasterSolver::solve(const MasterProblem& problem, MasterState& state, Maste
     return pimpl->solve(problem, state, sensitivity);
 }
 
+auto MasterSolver::begin(const MasterProblem& problem, MasterState& state) -> void
+{
+    pimpl->begin(problem, state);
+}
+
+auto MasterSolver::step() -> bool
+{
+    return pimpl->step();
+}
+
+auto MasterSolver::converged() const -> bool
+{
+    return pimpl->converged();
+}
+
+auto MasterSolver::finish() -> Result
+{
+    return pimpl->finish();
+}
+
+auto MasterSolver::finish(MasterSensitivity& sensitivity) -> Result
+{
+    return pimpl->finish(sensitivity);
+}
+
 } // namespace Optima
@@ -59,6 +59,26 @@ public:
 
     /// Solve the given master optimization problem and compute the sensitivity derivatives at the end.
     auto solve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitivity) -> Result;
+
+    /// Start the calculation of the given master optimization problem without performing any iteration.
+    /// The calculation is then advanced one iteration at a time with @ref step and ended with @ref finish,
+    /// so that many calculations can be interleaved on a single thread (e.g., one per cell in a simulation).
+    /// The master problem and state must outlive the calculation, and the latter is only consistent after @ref finish.
+    auto begin(const MasterProblem& problem, MasterState& state) -> void;
+
+    /// Perform one iteration of the calculation started with @ref begin.
+    /// @return Return `true` if further iterations are needed, or `false` if the calculation has converged or failed.
+    auto step() -> bool;
+
+    /// Return `true` if the calculation started with @ref begin has converged.
+    auto converged() const -> bool;
+
+    /// End the calculation started with @ref begin and update its master state.
+    /// If the calculation still needed further iterations, it stops with the best iterate so far and failure reason `cancelled`.
+    auto finish() -> Result;
+
+    /// End the calculation started with @ref begin, update its master state, and compute the sensitivity derivatives.
+    auto finish(MasterSensitivity& sensitivity) -> Result;
 };
 
 } // namespace Optima
@@ -0,0 +1,57 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ObjectiveBatchFunction.hpp"
+
+// C++ includes
+#include <algorithm>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+
+namespace Optima {
+
+ObjectiveBatchFunction::ObjectiveBatchFunction()
+{}
+
+ObjectiveBatchFunction::ObjectiveBatchFunction(const Signature& func)
+{
+    error(func == nullptr, "ObjectiveBatchFunction cannot be constructed with a non-initialized function.");
+    fn = func;
+}
+
+auto ObjectiveBatchFunction::operator()(ObjectiveBatchResult& res, MatrixView X, MatrixView P, MatrixView C, const ObjectiveBatchOptions& opts) const -> void
+{
+    // Ensure clear state before evaluation
+    res.resize(X.rows(), X.cols(), P.cols(), C.cols());
+    res.f.fill(0.0);
+    res.fx.fill(0.0);
+    if(opts.eval.fxx) res.fxx.fill(0.0);
+    if(opts.eval.fxp) res.fxp.fill(0.0);
+    if(opts.eval.fxc) res.fxc.fill(0.0);
+    res.diagfxx = false;
+    res.fxx4basicvars = false;
+    std::fill(res.succeeded.begin(), res.succeeded.end(), true);
+    fn(res, X, P, C, opts);
+}
+
+auto ObjectiveBatchFunction::initialized() const -> bool
+{
+    return fn != nullptr;
+}
+
+} // namespace Optima
@@ -0,0 +1,126 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <functional>
+#include <vector>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/ObjectiveFunction.hpp>
+
+namespace Optima {
+
+/// The result of a batch of objective function evaluations in structure-of-arrays layout.
+/// Row *k* of every member corresponds to the *k*-th evaluation in the batch, and each column
+/// stores one component of the result for all evaluations contiguously (e.g., column *i* of `fx`
+/// stores *fx[i]* of every evaluation). The Jacobian matrices are flattened in column-major
+/// order, so that column *i + j*nx* of `fxx` stores *fxx(i, j)* of every evaluation.
+/// @see ObjectiveBatchFunction
+struct ObjectiveBatchResult
+{
+    /// The evaluated objective functions *f(x, p, c)* with dimension *n*.
+    Vector f;
+
+    /// The evaluated gradient vectors of *f(x, p, c)* with respect to *x* with dimensions *n* by *nx*.
+    Matrix fx;
+
+    /// The evaluated Jacobian matrices of *fx(x, p, c)* with respect to *x* with dimensions *n* by *nx*nx*.
+    Matrix fxx;
+
+    /// The evaluated Jacobian matrices of *fx(x, p, c)* with respect to *p* with dimensions *n* by *nx*np*.
+    Matrix fxp;
+
+    /// The evaluated Jacobian matrices of *fx(x, p, c)* with respect to *c* with dimensions *n* by *nx*nc*.
+    Matrix fxc;
+
+    /// True if the matrices `fxx` of all evaluations are diagonal.
+    bool diagfxx = false;
+
+    /// True if the matrices `fxx` of all evaluations are non-zero only on columns corresponding to basic variables in *x*.
+    bool fxx4basicvars = false;
+
+    /// The flags indicating whether each evaluation succeeded with dimension *n*.
+    std::vector<bool> succeeded;
+
+    /// Resize this ObjectiveBatchResult object with given dimensions.
+    /// @param n The number of evaluations in the batch.
+    /// @param nx The number of variables in *x*.
+    /// @param np The number of parameters in *p*.
+    /// @param nc The number of sensitive parameters in *c*.
+    auto resize(Index n, Index nx, Index np, Index nc) -> void
+    {
+        f.resize(n);
+        fx.resize(n, nx);
+        fxx.resize(n, nx*nx);
+        fxp.resize(n, nx*np);
+        fxc.resize(n, nx*nc);
+        succeeded.resize(n);
+    }
+};
+
+/// The options transmitted to the evaluation of a batch of objective functions.
+/// @see ObjectiveBatchFunction, ObjectiveBatchResult
+struct ObjectiveBatchOptions
+{
+    /// The objective function components that need to be evaluated for at least one evaluation in the batch.
+    ObjectiveOptions::Eval eval;
+
+    /// The indices of the problems in the batch solver associated with each evaluation.
+    Indices iproblems;
+
+    /// The indices of the basic variables in *x* for each evaluation.
+    std::vector<Indices> ibasicvars;
+};
+
+/// Used to represent an objective function *f(x, p, c)* evaluated for a batch of points at once.
+/// The points are given in structure-of-arrays layout, with row *k* of matrices *X*, *P*, *C*
+/// corresponding to the *k*-th evaluation and column *i* of *X* storing *x[i]* of every evaluation.
+/// @see ObjectiveFunction, BatchSolver
+class ObjectiveBatchFunction
+{
+public:
+    /// The main functional signature of a batch of objective functions *f(x, p, c)*.
+    /// @param[out] res The evaluated results of the objective functions and their derivatives.
+    /// @param X The primal variables *x* of each evaluation with dimensions *n* by *nx*.
+    /// @param P The parameter variables *p* of each evaluation with dimensions *n* by *np*.
+    /// @param C The sensitive parameter variables *c* of each evaluation with dimensions *n* by *nc*.
+    /// @param opts The options transmitted to the evaluation of the batch.
+    using Signature = std::function<void(ObjectiveBatchResult& res, MatrixView X, MatrixView P, MatrixView C, const ObjectiveBatchOptions& opts)>;
+
+    /// Construct a default ObjectiveBatchFunction object.
+    ObjectiveBatchFunction();
+
+    /// Construct an ObjectiveBatchFunction object with given function.
+    ObjectiveBatchFunction(const Signature& fn);
+
+    /// Evaluate the batch of objective functions.
+    /// The components of `res` are zeroed before the evaluation.
+    auto operator()(ObjectiveBatchResult& res, MatrixView X, MatrixView P, MatrixView C, const ObjectiveBatchOptions& opts) const -> void;
+
+    /// Return `true` if this ObjectiveBatchFunction object has been initialized.
+    auto initialized() const -> bool;
+
+private:
+    /// The batch of objective functions with main functional signature.
+    Signature fn;
+};
+
+} // namespace Optima
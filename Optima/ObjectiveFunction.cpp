@@ -48,13 +48,18 @@ ObjectiveFunction::ObjectiveFunction(const Signature4py& func)
 auto ObjectiveFunction::operator()(ObjectiveResultRef res, VectorView x, VectorView p, VectorView c, ObjectiveOptions opts) const -> void
 {
     // Ensure clear state before evaluation
+    // A constant Hessian that is not requested keeps its values from the evaluation in which it was computed
+    const auto keepfxx = constantfxxfxp && !opts.eval.fxx;
+    const auto keepfxp = constantfxxfxp && !opts.eval.fxp;
     res.f = 0.0;
     res.fx.fill(0.0);
-    res.fxx.fill(0.0);
-    res.fxp.fill(0.0);
+    if(!keepfxx) {
+        res.fxx.fill(0.0);
+        res.diagfxx = false;
+        res.fxx4basicvars = false;
+    }
+    if(!keepfxp) res.fxp.fill(0.0);
     res.fxc.fill(0.0);
-    res.diagfxx = false;
-    res.fxx4basicvars = false;
     res.succeeded = true;
     fn(res, x, p, c, opts);
 }
@@ -63,6 +68,9 @@ auto ObjectiveFunction::operator=(const Signature& func) -> ObjectiveFunction&
 {
     error(func == nullptr, "ObjectiveFunction cannot be constructed with a non-initialized function.");
     fn = func;
+    constantfxxfxp = false;
+    fxxblocks.resize(0);
+    fxxblockdiagonal = false; // the blocks of fxx need to be declared again for the new function
     return *this;
 }
 
@@ -71,4 +79,31 @@ auto ObjectiveFunction::initialized() const -> bool
     return fn != nullptr;
 }
 
+auto ObjectiveFunction::setConstantHessian(bool constant) -> void
+{
+    constantfxxfxp = constant;
+}
+
+auto ObjectiveFunction::constantHessian() const -> bool
+{
+    return constantfxxfxp;
+}
+
+auto ObjectiveFunction::setBlocksHessian(IndicesView blocks) -> void
+{
+    errorif(blocks.size() && blocks.minCoeff() < 0, "The blocks of the Hessian matrix fxx cannot be identified by negative numbers.");
+    fxxblocks = blocks;
+    fxxblockdiagonal = true;
+}
+
+auto ObjectiveFunction::blockDiagonalHessian() const -> bool
+{
+    return fxxblockdiagonal;
+}
+
+auto ObjectiveFunction::blocksHessian() const -> IndicesView
+{
+    return fxxblocks;
+}
+
 } // namespace Optima
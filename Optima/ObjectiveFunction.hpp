@@ -50,6 +50,8 @@ struct ObjectiveResultBase
     Bool diagfxx;
 
     /// True if `fxx` is non-zero only on columns corresponding to basic varibles in *x*.
+    /// When set, the zero columns of `fxx` corresponding to non-basic variables are skipped in the
+    /// canonicalization of the Jacobian matrix and in the linear solvers.
     Bool fxx4basicvars;
 
     /// True if the objective function evaluation succeeded.
@@ -152,17 +154,53 @@ public:
     // : ObjectiveFunction(fn) {}
 
     /// Evaluate the objective function.
+    /// All entries in `res` are reset before the evaluation, except the derivatives declared constant that are not requested in `opts`.
     auto operator()(ObjectiveResultRef res, VectorView x, VectorView p, VectorView c, ObjectiveOptions opts) const -> void;
 
     /// Assign another objective function to this.
+    /// Any previously declared constant or block diagonal Hessian is discarded.
     auto operator=(const Signature& fn) -> ObjectiveFunction&;
 
     /// Return `true` if this ObjectiveFunction object has been initialized.
     auto initialized() const -> bool;
 
+    /// Declare the Jacobian matrices `fxx` and `fxp` constant (e.g., *f(x, p, c)* is quadratic in *x* and *p*).
+    /// Once `fxx` and `fxp` have been evaluated, the next evaluations are
+    /// requested without them (see ObjectiveOptions::Eval), and their
+    /// values in the result are kept instead of being reset. If `fxx` was evaluated
+    /// only on the columns of basic variables (see ObjectiveResult::fxx4basicvars),
+    /// it is evaluated again whenever the basic variables change.
+    /// @param constant True if `fxx` and `fxp` do not depend on *x* and *p*.
+    auto setConstantHessian(bool constant) -> void;
+
+    /// Return `true` if `fxx` and `fxp` have been declared constant.
+    auto constantHessian() const -> bool;
+
+    /// Declare the Hessian matrix `fxx` block diagonal.
+    /// The entry `fxx(i, j)` is then assumed zero at all times whenever the
+    /// variables *x[i]* and *x[j]* are in different blocks. This declaration
+    /// is used to decompose the problem into independent blocks (see DecomposerOptions).
+    /// @param blocks The block of each variable in *x*, a non-negative number (e.g., the indices of the variables if `fxx` is diagonal).
+    auto setBlocksHessian(IndicesView blocks) -> void;
+
+    /// Return `true` if the Hessian matrix `fxx` has been declared block diagonal.
+    auto blockDiagonalHessian() const -> bool;
+
+    /// Return the block of each variable in *x* if @ref blockDiagonalHessian is `true`.
+    auto blocksHessian() const -> IndicesView;
+
 private:
     /// The objective function with main functional signature.
     Signature fn;
+
+    /// True if `fxx` and `fxp` have been declared constant.
+    bool constantfxxfxp = false;
+
+    /// The block of each variable in *x* in the block diagonal Hessian matrix `fxx`.
+    Indices fxxblocks;
+
+    /// True if `fxx` has been declared block diagonal.
+    bool fxxblockdiagonal = false;
 };
 
 } // namespace Optima
@@ -18,11 +18,14 @@
 #pragma once
 
 // Optima includes
+#include <Optima/BatchLU.hpp>
+#include <Optima/BatchSolver.hpp>
 #include <Optima/CanonicalDims.hpp>
 #include <Optima/Canonicalizer.hpp>
 #include <Optima/CanonicalMatrix.hpp>
 #include <Optima/CanonicalVector.hpp>
 #include <Optima/Constants.hpp>
+#include <Optima/ConstraintBatchFunction.hpp>
 #include <Optima/ConstraintFunction.hpp>
 #include <Optima/Dims.hpp>
 #include <Optima/Echelonizer.hpp>
@@ -32,11 +35,16 @@
 #include <Optima/LinearSolver.hpp>
 #include <Optima/LU.hpp>
 #include <Optima/Matrix.hpp>
+#include <Optima/ObjectiveBatchFunction.hpp>
 #include <Optima/ObjectiveFunction.hpp>
 #include <Optima/Options.hpp>
+#include <Optima/Presolver.hpp>
 #include <Optima/Problem.hpp>
 #include <Optima/Result.hpp>
+#include <Optima/Sensitivity.hpp>
+#include <Optima/SensitivityBatch.hpp>
 #include <Optima/Solver.hpp>
 #include <Optima/Stability.hpp>
 #include <Optima/State.hpp>
+#include <Optima/StateBatch.hpp>
 #include <Optima/Timing.hpp>
@@ -23,12 +23,18 @@
 
 // Optima includes
 #include <Optima/BacktrackSearchOptions.hpp>
+#include <Optima/BatchOptions.hpp>
+#include <Optima/CancellationToken.hpp>
 #include <Optima/ConvergenceOptions.hpp>
+#include <Optima/DecomposerOptions.hpp>
 #include <Optima/ErrorStatusOptions.hpp>
 #include <Optima/LinearSolverOptions.hpp>
 #include <Optima/LineSearchOptions.hpp>
 #include <Optima/NewtonStepOptions.hpp>
 #include <Optima/OutputterOptions.hpp>
+#include <Optima/PresolverOptions.hpp>
+#include <Optima/ResidualFunctionOptions.hpp>
+#include <Optima/ScalerOptions.hpp>
 #include <Optima/TransformFunction.hpp>
 
 namespace Optima {
@@ -81,6 +87,14 @@ public:
     /// The maximum number of iterations in the optimization calculations.
     unsigned maxiters = 200;
 
+    /// The maximum wall time of the optimization calculations (in unit of s, disabled if zero).
+    /// Once exceeded, the calculation stops with the best iterate so far and failure reason `timeout`.
+    double timeout = 0.0;
+
+    /// The token used to cancel the optimization calculations from elsewhere (e.g., another thread).
+    /// Once cancelled, the calculation stops with the best iterate so far and failure reason `cancelled`.
+    CancellationToken cancellation;
+
     /// The options for assessing error status.
     ErrorStatusOptions errorstatus;
 
@@ -98,6 +112,21 @@ public:
 
     /// The options used for convergence analysis.
     ConvergenceOptions convergence;
+
+    /// The options used for residual function evaluations.
+    ResidualFunctionOptions residualfunction;
+
+    /// The options used for the presolve stage that reduces the optimization problem before it is solved.
+    PresolverOptions presolver;
+
+    /// The options used for the scaling of the master optimization problem before it is solved.
+    ScalerOptions scaler;
+
+    /// The options used for the decomposition of the master optimization problem into independent blocks solved separately.
+    DecomposerOptions decomposer;
+
+    /// The options used for the solution of batches of optimization problems with BatchSolver.
+    BatchOptions batch;
 };
 
 } // namespace Optima
@@ -0,0 +1,358 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Presolver.hpp"
+
+// C++ includes
+#include <cmath>
+
+// Eigen includes
+#include <Eigen/QR>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/IndexUtils.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+struct Presolver::Impl
+{
+    PresolverOptions options; ///< The options for the presolve stage.
+
+    Indices jx;        ///< The indices of the variables in x that remain in the reduced problem.
+    Indices jf;        ///< The indices of the eliminated variables in x (only the first `nf` entries are used).
+    Indices kf;        ///< The indices of the rows of Aex that determined the eliminated variables (or -1 if determined by their bounds).
+    Indices ie;        ///< The indices of the rows of Aex that remain in the reduced problem.
+    Vector xf;         ///< The values of the eliminated variables (only the first `nf` entries are used).
+    Vector xlower;     ///< The lower bounds of the variables in x, tightened with the linear equality constraints.
+    Vector xupper;     ///< The upper bounds of the variables in x, tightened with the linear equality constraints.
+    Vector r;          ///< The right-hand side of the linear equality constraints without the contributions of the eliminated variables.
+    Vector rscale;     ///< The magnitudes of the terms in the right-hand side vector `r`, used to scale the tolerances of each row.
+    Indices freevars;  ///< The flags (1 or 0) indicating the variables in x that have not been eliminated.
+    Indices activerows; ///< The flags (1 or 0) indicating the rows of Aex that have not been removed.
+    Indices rowswithp; ///< The flags (1 or 0) indicating the rows of Aep that are non-zero.
+    Index nf = 0;      ///< The number of eliminated variables.
+
+    Matrix Aexdep;     ///< The matrix Aex used in the last search of linearly dependent rows (to avoid repeating the search).
+    Matrix Aepdep;     ///< The matrix Aep used in the last search of linearly dependent rows (to avoid repeating the search).
+    Indices colsdep;   ///< The indices of the variables in x considered in the last search of linearly dependent rows.
+    Indices rowsdep;   ///< The indices of the rows of Aex considered in the last search of linearly dependent rows.
+    Indices perm;      ///< The rows in `rowsdep` ordered as (linearly independent, linearly dependent) by the last search.
+    Matrix lambda;     ///< The coefficients expressing each linearly dependent row as a combination of the linearly independent ones.
+    Index rank = 0;    ///< The number of linearly independent rows found in the last search.
+
+    Impl()
+    {}
+
+    auto update(PresolverUpdateArgs args) -> void
+    {
+        const auto& [Aex, Aep, be, xl, xu] = args;
+
+        const auto nx = xl.size();
+        const auto me = be.size();
+        const auto np = Aep.cols();
+
+        assert(xu.size() == nx);
+        assert(Aex.rows() == me || nx == 0);
+        assert(Aex.cols() == nx || me == 0);
+        assert(Aep.rows() == me || np == 0);
+
+        xlower = xl;
+        xupper = xu;
+        r = be;
+        rscale = be.cwiseAbs();
+        jf.resize(nx);
+        kf.resize(nx);
+        xf.resize(nx);
+        freevars.setOnes(nx);
+        activerows.setOnes(me);
+        nf = 0;
+
+        if(options.active)
+        {
+            rowswithp.setZero(me);
+            if(np) for(auto i = 0; i < me; ++i)
+                rowswithp[i] = (Aep.row(i).array() != 0.0).any();
+
+            if(options.fixed)
+                for(auto j = 0; j < nx; ++j)
+                    if(xlower[j] == xupper[j])
+                        eliminate(Aex, j, xlower[j], -1);
+
+            auto changed = true;
+            for(auto pass = 0U; pass < options.maxpasses && changed; ++pass)
+            {
+                changed = false;
+                for(auto i = 0; i < me; ++i)
+                    if(activerows[i] && !rowswithp[i])
+                        changed = reduceRow(Aex, xl, xu, i) || changed;
+            }
+
+            if(options.redundant)
+                removeDependentRows(Aex, Aep);
+
+            // Undo all reductions if no variable remains or if no remaining row of Aex contains a remaining variable
+            // (the master problem needs at least one variable and, if Aex has rows, at least one that is not empty)
+            auto nonempty = false;
+            for(auto i = 0; i < me && !nonempty; ++i)
+                for(auto j = 0; j < nx && !nonempty; ++j)
+                    nonempty = activerows[i] && freevars[j] && Aex(i, j) != 0.0;
+
+            if(nf == nx || (me && !nonempty))
+            {
+                xlower = xl;
+                xupper = xu;
+                freevars.setOnes(nx);
+                activerows.setOnes(me);
+                nf = 0;
+            }
+        }
+
+        jx = indices(nx);
+        ie = indices(me);
+        jx.conservativeResize(stableMoveLeftIf(jx, [&](Index j) { return freevars[j]; }));
+        ie.conservativeResize(stableMoveLeftIf(ie, [&](Index i) { return activerows[i]; }));
+    }
+
+    /// Eliminate variable `j` with given value, which was determined by row `k` of Aex (or by its bounds if `k` is -1).
+    auto eliminate(MatrixView Aex, Index j, double value, Index k) -> void
+    {
+        freevars[j] = 0;
+        jf[nf] = j;
+        kf[nf] = k;
+        xf[nf] = value;
+        ++nf;
+        for(auto i = 0; i < Aex.rows(); ++i)
+        {
+            const auto aij = Aex(i, j);
+            if(aij == 0.0) continue;
+            r[i] -= aij * value;
+            rscale[i] += std::abs(aij * value);
+        }
+    }
+
+    /// Remove row `i` of Aex if empty or a singleton, otherwise use it to tighten the bounds of its variables.
+    auto reduceRow(MatrixView Aex, VectorView xl, VectorView xu, Index i) -> bool
+    {
+        const auto nx = Aex.cols();
+        const auto tol = options.tolerance;
+
+        Index nnz = 0, jlast = -1;
+        for(auto j = 0; j < nx; ++j)
+            if(freevars[j] && Aex(i, j) != 0.0)
+                ++nnz, jlast = j;
+
+        // The row has no remaining variables and it can be removed if satisfied by the eliminated ones
+        if(nnz == 0)
+        {
+            if(!options.redundant || std::abs(r[i]) > tol * rscale[i])
+                return false;
+            activerows[i] = 0;
+            return true;
+        }
+
+        // The row determines the value of its only remaining variable
+        if(nnz == 1)
+        {
+            if(!options.singletons)
+                return false;
+            const auto j = jlast;
+            const auto aij = Aex(i, j);
+            const auto xj = r[i] / aij;
+            const auto tolj = tol * rscale[i] / std::abs(aij);
+            if(xj < xlower[j] - tolj || xj > xupper[j] + tolj) // an infeasible row is left for the solver to handle
+                return false;
+            eliminate(Aex, j, std::min(std::max(xj, xl[j]), xu[j]), i);
+            activerows[i] = 0;
+            return true;
+        }
+
+        if(!options.bounds)
+            return false;
+
+        // The minimum and maximum values of the terms aij*xj in the row (the infinite ones are counted instead)
+        double minsum = 0.0, maxsum = 0.0, scale = rscale[i];
+        Index mininfs = 0, maxinfs = 0;
+
+        const auto termmin = [&](Index j, double aij) { return aij > 0.0 ? aij * xlower[j] : aij * xupper[j]; };
+        const auto termmax = [&](Index j, double aij) { return aij > 0.0 ? aij * xupper[j] : aij * xlower[j]; };
+
+        for(auto j = 0; j < nx; ++j)
+        {
+            const auto aij = Aex(i, j);
+            if(!freevars[j] || aij == 0.0) continue;
+            const auto tmin = termmin(j, aij);
+            const auto tmax = termmax(j, aij);
+            if(std::isinf(tmin)) ++mininfs; else minsum += tmin, scale += std::abs(tmin);
+            if(std::isinf(tmax)) ++maxinfs; else maxsum += tmax, scale += std::abs(tmax);
+        }
+
+        if(mininfs > 1 && maxinfs > 1)
+            return false;
+
+        auto changed = false;
+
+        for(auto j = 0; j < nx; ++j)
+        {
+            const auto aij = Aex(i, j);
+            if(!freevars[j] || aij == 0.0) continue;
+
+            const auto tmin = termmin(j, aij);
+            const auto tmax = termmax(j, aij);
+
+            // The minimum and maximum values of the sum of the other terms in the row
+            const auto othersmin = mininfs == 0 ? minsum - tmin : (mininfs == 1 && std::isinf(tmin)) ? minsum : -infinity();
+            const auto othersmax = maxinfs == 0 ? maxsum - tmax : (maxinfs == 1 && std::isinf(tmax)) ? maxsum : infinity();
+
+            // The implied bounds of aij*xj and then of xj
+            const auto axmin = r[i] - othersmax;
+            const auto axmax = r[i] - othersmin;
+            const auto xmin = aij > 0.0 ? axmin / aij : axmax / aij;
+            const auto xmax = aij > 0.0 ? axmax / aij : axmin / aij;
+
+            const auto tolj = tol * scale / std::abs(aij);
+
+            if(xmin > xupper[j] + tolj || xmax < xlower[j] - tolj) // conflicting bounds are left for the solver to handle
+                continue;
+
+            if(xmin > xlower[j] + tolj) xlower[j] = xmin, changed = true;
+            if(xmax < xupper[j] - tolj) xupper[j] = xmax, changed = true;
+
+            // The variable is fixed if its tightened bounds coincide, but it is eliminated only if fixed at one of its
+            // original bounds, since its value would otherwise depend on the right-hand side of the linear equality constraints
+            if(xupper[j] - xlower[j] <= tolj)
+            {
+                const auto xj = 0.5*(xlower[j] + xupper[j]);
+                const auto atlower = std::abs(xj - xl[j]) <= tolj;
+                const auto atupper = std::abs(xj - xu[j]) <= tolj;
+                if(!atlower && !atupper)
+                    continue;
+                xlower[j] = xupper[j] = atlower ? xl[j] : xu[j];
+                eliminate(Aex, j, xlower[j], -1);
+                return true;
+            }
+        }
+
+        return changed;
+    }
+
+    /// Remove the rows of [Aex Aep] that are linear combinations of others and consistent with them.
+    auto removeDependentRows(MatrixView Aex, MatrixView Aep) -> void
+    {
+        const auto nx = Aex.cols();
+        const auto me = Aex.rows();
+        const auto np = Aep.cols();
+
+        Indices cols = indices(nx);
+        Indices rows = indices(me);
+        cols.conservativeResize(stableMoveLeftIf(cols, [&](Index j) { return freevars[j]; }));
+        rows.conservativeResize(stableMoveLeftIf(rows, [&](Index i) { return activerows[i]; }));
+
+        const auto m = rows.size();
+        const auto n = cols.size() + np;
+
+        if(m == 0 || n == 0)
+            return;
+
+        // Search for linearly dependent rows only if Aex, Aep, or the remaining rows and variables have changed since the last search
+        const auto unchanged =
+            Aexdep.rows() == Aex.rows() && Aexdep.cols() == Aex.cols() && Aexdep == Aex &&
+            Aepdep.rows() == Aep.rows() && Aepdep.cols() == Aep.cols() && Aepdep == Aep &&
+            colsdep.size() == cols.size() && colsdep == cols &&
+            rowsdep.size() == rows.size() && rowsdep == rows;
+
+        if(!unchanged)
+        {
+            Matrix M(m, n);
+            M << Aex(rows, cols), Aep(rows, all);
+
+            Eigen::ColPivHouseholderQR<Matrix> qr(tr(M));
+            rank = qr.rank();
+            perm = qr.colsPermutation().indices().cast<Index>();
+
+            if(rank == 0)
+                lambda = zeros(0, m);
+            else if(rank < m)
+            {
+                const Matrix Mi = M(perm.head(rank), all);
+                const Matrix Md = M(perm.tail(m - rank), all);
+                lambda = Eigen::ColPivHouseholderQR<Matrix>(tr(Mi)).solve(tr(Md));
+            }
+
+            Aexdep = Aex;
+            Aepdep = Aep;
+            colsdep = cols;
+            rowsdep = rows;
+        }
+
+        if(rank == m)
+            return;
+
+        const auto ind = rows(perm.head(rank));
+        const auto dep = rows(perm.tail(m - rank));
+
+        // The linearly dependent rows are removed only if consistent with the linearly independent ones
+        const Vector residuals = r(dep) - tr(lambda) * r(ind);
+        const Vector scales = rscale(dep) + tr(lambda.cwiseAbs()) * rscale(ind);
+
+        if((residuals.cwiseAbs().array() > options.tolerance * scales.array()).any())
+            return;
+
+        activerows(dep).fill(0);
+    }
+};
+
+Presolver::Presolver()
+: pimpl(new Impl())
+{}
+
+Presolver::Presolver(const Presolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+Presolver::~Presolver()
+{}
+
+auto Presolver::operator=(Presolver other) -> Presolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto Presolver::setOptions(const PresolverOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto Presolver::update(PresolverUpdateArgs args) -> void
+{
+    pimpl->update(args);
+}
+
+auto Presolver::reduced() const -> bool
+{
+    return pimpl->nf > 0 || pimpl->ie.size() < pimpl->activerows.size();
+}
+
+auto Presolver::status() const -> PresolverStatus
+{
+    const auto nf = pimpl->nf;
+    return { pimpl->jx, pimpl->jf.head(nf), pimpl->kf.head(nf), pimpl->ie, pimpl->xf.head(nf), pimpl->xlower, pimpl->xupper };
+}
+
+} // namespace Optima
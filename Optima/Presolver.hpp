@@ -0,0 +1,97 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/PresolverOptions.hpp>
+
+namespace Optima {
+
+/// The arguments in method @ref Presolver::update.
+struct PresolverUpdateArgs
+{
+    MatrixView Aex;    ///< The coefficient matrix *Aex* in the linear equality constraints *Aex*x + Aep*p = be*.
+    MatrixView Aep;    ///< The coefficient matrix *Aep* in the linear equality constraints *Aex*x + Aep*p = be*.
+    VectorView be;     ///< The right-hand side vector *be* in the linear equality constraints *Aex*x + Aep*p = be*.
+    VectorView xlower; ///< The lower bounds of the primal variables *x*.
+    VectorView xupper; ///< The upper bounds of the primal variables *x*.
+};
+
+/// The reductions of an optimization problem determined in the presolve stage.
+/// @see Presolver::status
+struct PresolverStatus
+{
+    IndicesView jx;    ///< The indices of the variables in *x* that remain in the reduced problem (in ascending order).
+    IndicesView jf;    ///< The indices of the variables in *x* eliminated from the problem (in the order they were eliminated).
+    IndicesView kf;    ///< The indices of the rows of *Aex* that determined the eliminated variables in *jf* (or -1 if determined by their bounds).
+    IndicesView ie;    ///< The indices of the rows of *Aex* that remain in the reduced problem (in ascending order).
+    VectorView xf;     ///< The values of the eliminated variables in *jf*.
+    VectorView xlower; ///< The lower bounds of the variables in *x* implied by the linear equality constraints (used only to find reductions, not actual bounds).
+    VectorView xupper; ///< The upper bounds of the variables in *x* implied by the linear equality constraints (used only to find reductions, not actual bounds).
+};
+
+/// Used to reduce the size of an optimization problem before it is solved.
+/// The presolve stage eliminates variables with identical lower and upper
+/// bounds, eliminates variables determined by a single linear equality
+/// constraint (singleton rows in *[Aex Aep]*), and removes linearly dependent
+/// linear equality constraints. The bounds of the variables implied by the
+/// linear equality constraints are used only to find variables fixed at one of
+/// their bounds, which are then also eliminated; the reduced problem keeps the
+/// original bounds of the remaining variables. The reductions are repeated until
+/// no further reduction is found (or the maximum number of passes is reached).
+class Presolver
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a default Presolver object.
+    Presolver();
+
+    /// Construct a copy of a Presolver object.
+    Presolver(const Presolver& other);
+
+    /// Destroy this Presolver object.
+    virtual ~Presolver();
+
+    /// Assign a Presolver object to this.
+    auto operator=(Presolver other) -> Presolver&;
+
+    /// Set the options for the presolve stage.
+    auto setOptions(const PresolverOptions& options) -> void;
+
+    /// Determine the reductions of the optimization problem with given linear equality constraints and bounds.
+    /// If the presolve stage is not active, no reduction is performed.
+    auto update(PresolverUpdateArgs args) -> void;
+
+    /// Return true if the last update has eliminated variables or removed constraints.
+    auto reduced() const -> bool;
+
+    /// Return the reductions of the optimization problem determined in the last update.
+    auto status() const -> PresolverStatus;
+};
+
+} // namespace Optima
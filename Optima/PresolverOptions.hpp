@@ -0,0 +1,51 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace Optima {
+
+/// Used to organize the options for the presolve stage in which the optimization problem is reduced before it is solved.
+struct PresolverOptions
+{
+    /// The boolean flag that indicates if the presolve stage is performed before the optimization problem is solved.
+    bool active = false;
+
+    /// The boolean flag that indicates if variables with identical lower and upper bounds are eliminated from the problem.
+    bool fixed = true;
+
+    /// The boolean flag that indicates if variables determined by a single linear equality constraint are eliminated from the problem.
+    /// The multiplier *ye* of the eliminated constraint is afterwards computed so that the stability of the eliminated variable is zero.
+    bool singletons = true;
+
+    /// The boolean flag that indicates if linear equality constraints that are linearly dependent on others are removed from the problem.
+    /// These constraints are removed only if they are consistent with the others, and their multipliers *ye* are set to zero.
+    bool redundant = true;
+
+    /// The boolean flag that indicates if the bounds implied by the linear equality constraints are used to find fixed variables.
+    /// Variables whose implied lower and upper bounds coincide with one of their bounds are eliminated from the problem.
+    /// The implied bounds are not imposed on the remaining variables.
+    bool bounds = true;
+
+    /// The maximum number of passes over the linear equality constraints in search of further reductions.
+    unsigned maxpasses = 10;
+
+    /// The relative tolerance used to decide if a linear equality constraint is satisfied or if two bounds coincide.
+    double tolerance = 1.0e-12;
+};
+
+} // namespace Optima
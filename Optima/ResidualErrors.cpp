@@ -31,6 +31,9 @@ struct ResidualErrors::Impl
     Vector plower; ///< The lower bounds for variables *p*.
     Vector pupper; ///< The upper bounds for variables *p*.
 
+    Vector dx; ///< The scaling factors of the variables *x* (empty if the master problem is not scaled).
+    Vector dw; ///< The scaling factors of the Lagrange multipliers *w* (empty if the master problem is not scaled).
+
     Vector ex; ///< The residual errors associated with the first-order optimality conditions.
     Vector ep; ///< The residual errors associated with the external constraint equations.
     Vector ew; ///< The residual errors associated with the linear and non-linear constraint equations.
@@ -55,6 +58,15 @@ struct ResidualErrors::Impl
         ep = zeros(dims.np);
         ew = zeros(dims.nw);
         ewbar = zeros(dims.nw);
+        dx.resize(0);
+        dw.resize(0);
+    }
+
+    auto initialize(const MasterProblem& problem, VectorView dxscaling, VectorView dwscaling) -> void
+    {
+        initialize(problem);
+        dx = dxscaling;
+        dw = dwscaling;
     }
 
     auto update(MasterVectorView u, const ResidualFunction& F) -> void
@@ -76,9 +88,6 @@ struct ResidualErrors::Impl
         const auto jbs = js.head(nbs);
 
         const auto x = u.x;
-        const auto xbs = x(jbs);
-        const auto xbslower = xlower(jbs);
-        const auto xbsupper = xupper(jbs);
 
         ex = abs(Fm.x);
         ep = abs(Fm.p);
@@ -90,6 +99,14 @@ struct ResidualErrors::Impl
         ewbs = abs(Fc.wbs);
         ewbl.fill(0.0);
 
+        // Measure the errors in the units of the original problem if the master problem is scaled
+        if(dx.size())
+        {
+            ex.array() /= dx.array();
+            ew.array() /= dw.array();
+            ewbs.array() *= dx(jbs).array(); // each row of the canonical form has the units of its basic variable
+        }
+
         // Ensure currently unstable x variables have zero optimality errors.
         ex(ju).fill(0.0);
 
@@ -98,9 +115,10 @@ struct ResidualErrors::Impl
         // variable. Ensure optimality errors associated with such basic
         // variables attached to their bounds are zeroed out below.
 
-        // Ensure basic variables on the bounds have zero optimality error
-        ex(jbs) = (xbs.array() == xbslower.array()).select(0.0, ex(jbs));
-        ex(jbs) = (xbs.array() == xbsupper.array()).select(0.0, ex(jbs));
+        // Ensure basic variables on the bounds have zero optimality error (without gathering x, xlower, xupper at jbs)
+        for(const auto i : jbs)
+            if(x[i] == xlower[i] || x[i] == xupper[i])
+                ex[i] = 0.0;
 
         errorx = norminf(ex);
         errorp = norminf(ep);
@@ -143,6 +161,11 @@ auto ResidualErrors::initialize(const MasterProblem& problem) -> void
     return pimpl->initialize(problem);
 }
 
+auto ResidualErrors::initialize(const MasterProblem& problem, VectorView dx, VectorView dw) -> void
+{
+    return pimpl->initialize(problem, dx, dw);
+}
+
 auto ResidualErrors::update(MasterVectorView u, const ResidualFunction& F) -> void
 {
     pimpl->update(u, F);
@@ -50,6 +50,14 @@ public:
     /// Initialize the residual errors once before update computations.
     auto initialize(const MasterProblem& problem) -> void;
 
+    /// Initialize the residual errors once before update computations on a scaled master problem.
+    /// The residual errors are then measured in the units of the original master problem.
+    /// @param problem The scaled master problem.
+    /// @param dx The scaling factors of the variables *x* (with *x = Dx·x'*).
+    /// @param dw The scaling factors of the Lagrange multipliers *w* (with *w = Dw·w'*).
+    /// @see Scaler
+    auto initialize(const MasterProblem& problem, VectorView dx, VectorView dw) -> void;
+
     /// Update the residual errors.
     auto update(MasterVectorView u, const ResidualFunction& F) -> void;
 
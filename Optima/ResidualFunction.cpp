@@ -17,6 +17,12 @@
 
 #include "ResidualFunction.hpp"
 
+// C++ includes
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
 // Optima includes
 #include <Optima/Canonicalizer.hpp>
 #include <Optima/EchelonizerW.hpp>
@@ -28,6 +34,44 @@
 
 namespace Optima {
 
+/// Return true if vectors `a` and `b` have different sizes or different entries.
+template<typename VectorA, typename VectorB>
+auto differ(const VectorA& a, const VectorB& b) -> bool
+{
+    return a.size() != b.size() || a != b;
+}
+
+/// Return true if vectors `a` and `b` have the same size and bitwise identical entries.
+template<typename VectorA, typename VectorB>
+auto identical(const VectorA& a, const VectorB& b) -> bool
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+/// Used to store the results of an evaluation of f, h, v for reuse when these functions are evaluated again at the same point.
+struct ResidualFunctionEvalCacheEntry
+{
+    /// The vectors x, p, c at which f, h, v were evaluated.
+    Vector x, p, c;
+
+    /// The flags indicating which derivatives of f, h, v wrt x, p, c were evaluated.
+    bool ddx = false, ddp = false, ddc = false;
+
+    /// The results of the evaluation of f, h, v.
+    ObjectiveResult fres;
+    ConstraintResult hres;
+    ConstraintResult vres;
+
+    /// The indices of the basic variables in x used in the evaluation.
+    Indices jbfeval;
+
+    /// The identifier of the evaluation (see ResidualFunction::Impl::evalid).
+    Index evalid = -1;
+
+    /// The value of ResidualFunction::Impl::evalcount when this entry was last used (for least-recently-used replacement).
+    Index lastused = -1;
+};
+
 struct ResidualFunction::Impl
 {
     /// The dimensions of the master variables.
@@ -42,6 +86,14 @@ struct ResidualFunction::Impl
     /// The result of the evaluation of v(x, p).
     ConstraintResult vres;
 
+    /// The results of the evaluations of f, h, v without derivatives, whose values are then copied to `fres`, `hres`, `vres` (see updateSkipJacobian).
+    ObjectiveResult fresval;
+    ConstraintResult hresval;
+    ConstraintResult vresval;
+
+    /// The options for the evaluation of the residual function.
+    ResidualFunctionOptions options;
+
     /// The echelonizer of matrix W = [Wx Wp] = [Ax Ap; Jx Jp].
     EchelonizerW echelonizerW;
 
@@ -69,6 +121,9 @@ struct ResidualFunction::Impl
     /// The external nonlinear constraint function *v(x, p)*.
     ConstraintFunction v;
 
+    /// The indices of the columns of Jx that can be non-zero.
+    Indices Jxcols;
+
     /// The right-hand side vector b in the linear equality constraints.
     Vector b;
 
@@ -81,12 +136,70 @@ struct ResidualFunction::Impl
     /// The vector with the sensitive parameters *c*.
     Vector c;
 
+    /// The indices of the basic variables used in the last evaluation of f(x, p).
+    Indices jbfeval;
+
+    /// The auxiliary flags used to check if the basic variables changed since the last evaluation of f(x, p).
+    Indices jbflags;
+
+    /// True if fxx is non-zero only on columns corresponding to the current basic variables.
+    bool fxx4basicvars = false;
+
+    /// True if fxx and fxp are constant and have already been evaluated (see ObjectiveFunction::setConstantHessian).
+    bool fconstevaluated = false;
+
+    /// True if the Jacobian matrices of h and v are constant and have already been evaluated (see ConstraintFunction::setConstantDerivatives).
+    bool hconstevaluated = false, vconstevaluated = false;
+
+    /// True if the echelon form of W has been computed with the constant Jacobian matrices Jx and Jp (or W = [Ax Ap] since there are no h constraints).
+    bool Wconstechelonized = false;
+
     /// True if the last update call succeeded.
     bool succeeded = false;
 
+    /// The number of requests for evaluations of f, h, v so far, including those served from the evaluation cache.
+    Index evalcount = 0;
+
+    /// The identifier of the evaluation of f, h, v whose results are currently in fres, hres, vres.
+    Index evalid = -1;
+
+    /// The value of `evalid` in the last execution of the stages after the function evaluations.
+    Index evalidlast = -1;
+
+    /// The most recent evaluations of f, h, v, which are reused when these functions are evaluated again at the same (x, p, c).
+    std::vector<ResidualFunctionEvalCacheEntry> evalcache;
+
+    /// The vectors x, p, w in the last execution of the stages after the function evaluations.
+    Vector xlast, plast, wlast;
+
+    /// The priority weights for selection of basic variables in x in the last update of the echelon form of W.
+    Vector wxlast;
+
+    /// The indices of the stable and unstable variables in x in the last update of the canonical form of the Jacobian matrix.
+    Indices jslast, julast;
+
+    /// True if the canonical form of the Jacobian matrix is outdated (e.g., it was skipped in an update without Jacobian evaluations).
+    bool canonicaldirty = true;
+
+    /// True if the residual vector is outdated (e.g., it was skipped in an update of only the Jacobian matrices).
+    bool residualdirty = true;
+
+    /// The stability vector s = g + tr(Wx)*w computed in updates skipping Jacobian evaluations.
+    Vector sfrozen;
+
+    /// The result of the evaluation of the residual function assembled at the end of the last update.
+    std::optional<ResidualFunctionResult> res;
+
     Impl()
     {}
 
+    auto setOptions(const ResidualFunctionOptions& opts) -> void
+    {
+        options = opts;
+        echelonizerW.setOptions(options.echelonizer);
+        evalcache.clear();
+    }
+
     auto initialize(const MasterProblem& problem) -> void
     {
         const auto nx = problem.dims.nx;
@@ -98,8 +211,18 @@ struct ResidualFunction::Impl
         fres.resize(nx, np, nc);
         hres.resize(nz, nx, np, nc);
         vres.resize(np, nx, np, nc);
+        fresval.resize(nx, np, nc);
+        hresval.resize(nz, nx, np, nc);
+        vresval.resize(np, nx, np, nc);
         wx.resize(nx);
-        echelonizerW.initialize(dims, problem.Ax, problem.Ap);
+        hres.ddx.fill(0.0); // ensure zero columns in Jx if h(x, p) has sparse Jacobian matrix (see ConstraintFunction::setNonZeroColumnsDdx)
+        Jxcols = problem.h.sparseDdx() ? Indices(problem.h.nonZeroColumnsDdx()) : Indices(indices(nx));
+        errorif(Jxcols.size() && (Jxcols.minCoeff() < 0 || Jxcols.maxCoeff() >= nx),
+            "The declared non-zero columns of the Jacobian matrix of h(x, p) contain indices out of range.");
+        echelonizerW.initialize(dims, problem.Ax, problem.Ap, Jxcols);
+        residual = ResidualVector();
+        if(Jxcols.size() < nx)
+            residual.setNonZeroColumnsJx(Jxcols);
         r = problem.r;
         f = problem.f;
         h = problem.h;
@@ -108,36 +231,100 @@ struct ResidualFunction::Impl
         xlower = problem.xlower;
         xupper = problem.xupper;
         c = problem.c;
+        evalid = -1;
+        evalidlast = -1;
+        evalcache.clear();
+        fconstevaluated = false;
+        hconstevaluated = false;
+        vconstevaluated = false;
+        Wconstechelonized = false;
+        wxlast.resize(0);
+        canonicaldirty = true;
+        residualdirty = true;
+        res.reset();
     }
 
     auto update(MasterVectorView u) -> void
     {
         sanitycheck(u);
         succeeded = updateFunctionEvals(u); // currently, even if succeeded==false, let the remaining lines be executed, otherwise result() fails (at least in Windows).
-        updateEchelonFormMatrixW(u);
-        updateIndicesStableVariables(u);
-        updateCanonicalFormJacobianMatrix(u);
-        updateResidualVector(u);
+        updateStages(u, true);
     }
 
     auto updateSkipJacobian(MasterVectorView u) -> void
     {
         sanitycheck(u);
         succeeded = updateFunctionEvalsSkippingJacobianEvals(u);
-        updateEchelonFormMatrixW(u);
-        updateIndicesStableVariables(u);
-        updateCanonicalFormJacobianMatrix(u);
-        updateResidualVector(u);
+
+        // Without a previous update, there are no Jacobian matrices and echelon and canonical forms to reuse
+        if(!res.has_value())
+        {
+            updateStages(u, true);
+            return;
+        }
+
+        // Reuse the echelon and canonical forms and the partition of stable and unstable variables of the last
+        // update with Jacobian evaluations, so that only the stability vector and the residual vector are computed
+        const auto& Wx = echelonizerW.W().Wx;
+        sfrozen.noalias() = fres.fx + tr(Wx)*u.w;
+        updateResidualVector(u, sfrozen);
+
+        // Ensure all stages are executed in the next update with Jacobian evaluations
+        evalidlast = -1;
+        residualdirty = true;
+
+        assembleResult();
     }
 
     auto updateOnlyJacobian(MasterVectorView u) -> void
     {
         sanitycheck(u);
         succeeded = updateFunctionEvalsWithAllJacobianEvals(u);
-        updateEchelonFormMatrixW(u);
-        updateIndicesStableVariables(u);
-        updateCanonicalFormJacobianMatrix(u);
-        // no need to update residual vector here using `updateResidualVector(u);`
+        updateStages(u, false); // no need to update residual vector here
+    }
+
+    /// Execute the stages after the function evaluations, each one only if its inputs have changed since its last execution.
+    auto updateStages(MasterVectorView u, bool withresidual) -> void
+    {
+        const auto evalchanged = evalid != evalidlast;
+        const auto uchanged = differ(u.x, xlast) || differ(u.p, plast) || differ(u.w, wlast);
+
+        const auto echelonized = updateEchelonFormMatrixW(u);
+
+        fxx4basicvars = fres.fxx4basicvars && !basicVariablesChangedSinceLastEval();
+
+        if(echelonized || evalchanged || uchanged)
+            updateIndicesStableVariables(u);
+
+        const auto& js = stability.status().js;
+        const auto& ju = stability.status().ju;
+        const auto stabilitychanged = differ(js, jslast) || differ(ju, julast);
+
+        canonicaldirty = canonicaldirty || echelonized || evalchanged || stabilitychanged;
+
+        if(canonicaldirty)
+        {
+            updateCanonicalFormJacobianMatrix(u);
+            jslast = js;
+            julast = ju;
+            canonicaldirty = false;
+            residualdirty = true;
+        }
+
+        residualdirty = residualdirty || evalchanged || uchanged || echelonized;
+
+        if(withresidual && residualdirty)
+        {
+            updateResidualVector(u);
+            residualdirty = false;
+        }
+
+        evalidlast = evalid;
+        xlast = u.x;
+        plast = u.p;
+        wlast = u.w;
+
+        assembleResult();
     }
 
     auto updateFunctionEvalsAux(MasterVectorView u, bool eval_ddx, bool eval_ddp, bool eval_ddc) -> bool
@@ -147,16 +334,112 @@ struct ResidualFunction::Impl
         const auto np = dims.np;
         const auto nz = dims.nz;
         const auto nc = c.size();
-        const auto RWQ = echelonizerW.RWQ();
-        const auto ibasicvars = RWQ.jb;
-        ObjectiveOptions  fopts{{eval_ddx, eval_ddp && np, eval_ddc && nc}, ibasicvars};
-        ConstraintOptions hopts{{eval_ddx, eval_ddp && np, eval_ddc && nc}, ibasicvars};
-        ConstraintOptions vopts{{eval_ddx, eval_ddp && np, eval_ddc && nc}, ibasicvars};
+        ++evalcount;
+        if(restoreFunctionEvals(x, p, eval_ddx, eval_ddp, eval_ddc))
+            return succeeded;
+        const auto ibasicvars = echelonizerW.RWQ().jb;
+        const auto fskip = fconstevaluated && !(fres.fxx4basicvars && basicVariablesChangedSinceLastEval()); // skip evaluation of fxx and fxp if constant and already evaluated, unless fxx was evaluated only for other basic variables
+        const auto hskip = hconstevaluated; // skip evaluation of Jx and Jp if constant and already evaluated
+        const auto vskip = vconstevaluated; // skip evaluation of Vpx and Vpp if constant and already evaluated
+        ObjectiveOptions  fopts{{eval_ddx && !fskip, eval_ddp && np && !fskip, eval_ddc && nc}, ibasicvars};
+        ConstraintOptions hopts{{eval_ddx && !hskip, eval_ddp && np && !hskip, eval_ddc && nc}, ibasicvars};
+        ConstraintOptions vopts{{eval_ddx && !vskip, eval_ddp && np && !vskip, eval_ddc && nc}, ibasicvars};
         r(x, p, c, fopts, hopts, vopts);
-        f(fres, x, p, c, fopts);
-        if(nz) h(hres, x, p, c, hopts);
-        if(np) v(vres, x, p, c, vopts);
-        return succeeded = fres.succeeded && hres.succeeded && vres.succeeded;
+        if(!eval_ddx && !eval_ddp && !eval_ddc)
+            evalFunctionValues(x, p, fopts, hopts, vopts);
+        else
+        {
+            f(fres, x, p, c, fopts);
+            if(nz) h(hres, x, p, c, hopts);
+            if(np) v(vres, x, p, c, vopts);
+        }
+        if(fopts.eval.fxx) jbfeval = ibasicvars; // the basic variables used in the last evaluation of fxx (see fxx4basicvars)
+        evalid = evalcount;
+        succeeded = fres.succeeded && hres.succeeded && vres.succeeded;
+        fconstevaluated = fconstevaluated || (f.constantHessian() && eval_ddx && eval_ddp && fres.succeeded);
+        hconstevaluated = hconstevaluated || (h.constantDerivatives() && eval_ddx && eval_ddp && hres.succeeded);
+        vconstevaluated = vconstevaluated || (v.constantDerivatives() && eval_ddx && eval_ddp && vres.succeeded);
+        storeFunctionEvals(x, p, eval_ddx, eval_ddp, eval_ddc);
+        return succeeded;
+    }
+
+    /// Evaluate f, h, v without derivatives and update only their values, so that the derivatives of the last evaluation with them are kept.
+    auto evalFunctionValues(VectorView x, VectorView p, ObjectiveOptions const& fopts, ConstraintOptions const& hopts, ConstraintOptions const& vopts) -> void
+    {
+        f(fresval, x, p, c, fopts);
+        fres.f = fresval.f;
+        fres.fx = fresval.fx;
+        fres.succeeded = fresval.succeeded;
+        if(dims.nz)
+        {
+            h(hresval, x, p, c, hopts);
+            hres.val = hresval.val;
+            hres.succeeded = hresval.succeeded;
+        }
+        if(dims.np)
+        {
+            v(vresval, x, p, c, vopts);
+            vres.val = vresval.val;
+            vres.succeeded = vresval.succeeded;
+        }
+    }
+
+    /// Restore the results of a cached evaluation of f, h, v at the same (x, p, c) with at least the requested derivatives and return true if found.
+    auto restoreFunctionEvals(VectorView x, VectorView p, bool ddx, bool ddp, bool ddc) -> bool
+    {
+        for(auto& entry : evalcache)
+        {
+            const auto covered = (entry.ddx || !ddx) && (entry.ddp || !ddp) && (entry.ddc || !ddc);
+            if(!covered || !identical(entry.x, x) || !identical(entry.p, p) || !identical(entry.c, c))
+                continue;
+            if(!ddx && !ddp && !ddc) // only the values are restored, so that the derivatives of the last evaluation with them are kept (see updateSkipJacobian)
+            {
+                fres.f = entry.fres.f;
+                fres.fx = entry.fres.fx;
+                fres.succeeded = entry.fres.succeeded;
+                hres.val = entry.hres.val;
+                hres.succeeded = entry.hres.succeeded;
+                vres.val = entry.vres.val;
+                vres.succeeded = entry.vres.succeeded;
+                evalid = evalcount; // a new combination of values and derivatives
+            }
+            else if(entry.evalid != evalid) // no need to copy the results if they are the current ones
+            {
+                fres = entry.fres;
+                hres = entry.hres;
+                vres = entry.vres;
+                jbfeval = entry.jbfeval;
+                evalid = entry.evalid;
+            }
+            entry.lastused = evalcount;
+            succeeded = fres.succeeded && hres.succeeded && vres.succeeded;
+            return true;
+        }
+        return false;
+    }
+
+    /// Store the results of the last evaluation of f, h, v in the evaluation cache, replacing its least recently used entry if full.
+    auto storeFunctionEvals(VectorView x, VectorView p, bool ddx, bool ddp, bool ddc) -> void
+    {
+        const auto size = options.evalcachesize;
+        if(size <= 0)
+            return;
+        if(evalcache.size() < static_cast<std::size_t>(size))
+            evalcache.emplace_back();
+        auto entry = std::min_element(evalcache.begin(), evalcache.end(),
+            [](const auto& l, const auto& r) { return l.lastused < r.lastused; });
+        entry->x = x;
+        entry->p = p;
+        entry->c = c;
+        entry->ddx = ddx;
+        entry->ddp = ddp;
+        entry->ddc = ddc;
+        entry->fres = fres;
+        entry->hres = hres;
+        entry->vres = vres;
+        entry->jbfeval = jbfeval;
+        entry->evalid = evalid;
+        entry->lastused = evalcount;
     }
 
     auto updateFunctionEvals(MasterVectorView u) -> bool
@@ -177,7 +460,8 @@ struct ResidualFunction::Impl
         return updateFunctionEvalsAux(u, ddx, ddp, ddc);
     }
 
-    auto updateEchelonFormMatrixW(MasterVectorView u) -> void
+    /// Update the echelon form of matrix W if the priority weights wx or the Jacobian matrices Jx and Jp have changed and return true if so.
+    auto updateEchelonFormMatrixW(MasterVectorView u) -> bool
     {
         const auto& x = u.x;
         const auto& Jx = hres.ddx;
@@ -186,7 +470,45 @@ struct ResidualFunction::Impl
         for(auto i = 0; i < x.size(); ++i)
             wx[i] = x[i] != xlower[i] && x[i] != xupper[i] ? std::abs(x[i]) : -1.0; // Enforce weak priority for variables on the bounds.
 
+        // With constant Jx and Jp already in W, only the priority weights can change the echelon form
+        if(Wconstechelonized)
+        {
+            if(!differ(wx, wxlast))
+                return false;
+
+            echelonizerW.update(wx);
+
+            wxlast = wx;
+
+            return true;
+        }
+
+        const auto& W = echelonizerW.W();
+
+        const auto unchanged = !differ(wx, wxlast)
+            && !differ(Jx(all, Jxcols), W.Jx(all, Jxcols))
+            && !differ(Jp, W.Jp);
+
+        if(unchanged)
+            return false;
+
         echelonizerW.update(Jx, Jp, wx);
+
+        wxlast = wx;
+
+        Wconstechelonized = hconstevaluated || dims.nz == 0; // W = [Ax Ap] is constant if there are no h constraints
+
+        return true;
+    }
+
+    auto basicVariablesChangedSinceLastEval() -> bool
+    {
+        const auto& jb = echelonizerW.RWQ().jb;
+        if(jb.size() != jbfeval.size())
+            return true;
+        jbflags.setZero(dims.nx);
+        jbflags(jbfeval).fill(1);
+        return (jbflags(jb).array() == 0).any();
     }
 
     auto updateIndicesStableVariables(MasterVectorView u) -> void
@@ -205,6 +527,11 @@ struct ResidualFunction::Impl
     }
 
     auto updateResidualVector(MasterVectorView u) -> void
+    {
+        updateResidualVector(u, stability.status().s);
+    }
+
+    auto updateResidualVector(MasterVectorView u, VectorView s) -> void
     {
         const auto& fx = fres.fx;
         const auto& h = hres.val;
@@ -218,7 +545,7 @@ struct ResidualFunction::Impl
         const auto& y = w.head(dims.ny);
         const auto& z = w.tail(dims.nz);
         const auto& Jc = jacobianMatrixCanonicalForm();
-        residual.update({Jc, Wx, Wp, x, p, y, z, fx, v, b, h});
+        residual.update({Jc, Wx, Wp, x, p, y, z, fx, v, b, h, s});
     }
 
     auto jacobianMatrixMasterForm() const -> MasterMatrix
@@ -226,7 +553,7 @@ struct ResidualFunction::Impl
         const auto& stabilitystatus = stability.status();
         const auto& js = stabilitystatus.js;
         const auto& ju = stabilitystatus.ju;
-        const auto& H = MatrixViewH{fres.fxx, fres.fxp, fres.diagfxx};
+        const auto& H = MatrixViewH{fres.fxx, fres.fxp, fres.diagfxx, fxx4basicvars};
         const auto& V = MatrixViewV{vres.ddx, vres.ddp};
         const auto& W = echelonizerW.W();
         const auto& RWQ = echelonizerW.RWQ();
@@ -248,15 +575,23 @@ struct ResidualFunction::Impl
         return residual.canonicalVector();
     }
 
-    auto result() const -> ResidualFunctionResult
+    /// Assemble the result of the evaluation of the residual function, whose views remain valid until the next update.
+    auto assembleResult() -> void
     {
-        const auto Jm = jacobianMatrixMasterForm();
-        const auto Jc = jacobianMatrixCanonicalForm();
-        const auto Fm = residualVectorMasterForm();
-        const auto Fc = residualVectorCanonicalForm();
-        const auto stabilitystatus = stability.status();
+        res.reset();
+        res.emplace(ResidualFunctionResult{ fres, hres, vres,
+            jacobianMatrixMasterForm(),
+            jacobianMatrixCanonicalForm(),
+            residualVectorMasterForm(),
+            residualVectorCanonicalForm(),
+            stability.status(),
+            succeeded });
+    }
 
-        return { fres, hres, vres, Jm, Jc, Fm, Fc, stabilitystatus, succeeded };
+    auto result() const -> ResidualFunctionResult
+    {
+        errorif(!res.has_value(), "ResidualFunction::result() cannot be called before ResidualFunction::update() or ResidualFunction::updateSkipJacobian().");
+        return *res;
     }
 
     auto sanitycheck(MasterVectorView u) const -> void
@@ -276,7 +611,10 @@ ResidualFunction::ResidualFunction()
 
 ResidualFunction::ResidualFunction(const ResidualFunction& other)
 : pimpl(new Impl(*other.pimpl))
-{}
+{
+    if(pimpl->res.has_value())
+        pimpl->assembleResult(); // the copied result has views to the data in `other`
+}
 
 ResidualFunction::~ResidualFunction()
 {}
@@ -287,6 +625,11 @@ auto ResidualFunction::operator=(ResidualFunction other) -> ResidualFunction&
     return *this;
 }
 
+auto ResidualFunction::setOptions(const ResidualFunctionOptions& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
 auto ResidualFunction::initialize(const MasterProblem& problem) -> void
 {
     return pimpl->initialize(problem);
@@ -29,6 +29,7 @@
 #include <Optima/MasterProblem.hpp>
 #include <Optima/MasterVector.hpp>
 #include <Optima/ObjectiveFunction.hpp>
+#include <Optima/ResidualFunctionOptions.hpp>
 #include <Optima/Stability.hpp>
 
 namespace Optima {
@@ -89,6 +90,9 @@ public:
     /// Assign a ResidualFunction object to this.
     auto operator=(ResidualFunction other) -> ResidualFunction&;
 
+    /// Set the options for the evaluation of the residual function.
+    auto setOptions(const ResidualFunctionOptions& options) -> void;
+
     /// Initialize the residual function once before update computations.
     auto initialize(const MasterProblem& problem) -> void;
 
@@ -96,6 +100,8 @@ public:
     auto update(MasterVectorView u) -> void;
 
     /// Update the residual function with given *u = (x, p, y, z)* skipping Jacobian evaluations.
+    /// Only the residual vector is computed at *u*. The Jacobian matrices, their echelon and canonical forms, and
+    /// the partition of stable and unstable variables are those of the last update with Jacobian evaluations.
     auto updateSkipJacobian(MasterVectorView u) -> void;
 
     /// Update only the Jacobian matrices with respect to variables *x*, *p*, and *c*.
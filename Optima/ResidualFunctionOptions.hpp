@@ -0,0 +1,36 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/EchelonizerOptions.hpp>
+#include <Optima/Index.hpp>
+
+namespace Optima {
+
+/// Used to organize the options for the evaluation of the residual function in ResidualFunction.
+struct ResidualFunctionOptions
+{
+    /// The options for the echelonization of matrix *W = [Ax Ap; Jx Jp]*.
+    EchelonizerOptions echelonizer;
+
+    /// The number of most recent evaluations of *f*, *h*, *v* kept for reuse when evaluated again at the same *(x, p, c)* (zero disables it).
+    Index evalcachesize = 0;
+};
+
+} // namespace Optima
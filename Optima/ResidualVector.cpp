@@ -42,6 +42,10 @@ struct ResidualVector::Impl
     Vector awbs;
     Vector awstar;  ///< The workspace for auxiliary vector aw(star)
     Vector xsu;
+    Vector xsmask;  ///< The workspace for auxiliary vector x with zero entries for unstable variables when Jx is sparse
+
+    Indices Jxcols;         ///< The indices of the columns of Jx that can be non-zero.
+    bool sparseJx = false;  ///< True if only the columns of Jx in Jxcols can be non-zero.
 
     Impl()
     {
@@ -49,7 +53,7 @@ struct ResidualVector::Impl
 
     auto update(ResidualVectorUpdateArgs args) -> void
     {
-        const auto [Mc, Wx, Wp, x, p, y, z, g, v, b, h] = args;
+        const auto [Mc, Wx, Wp, x, p, y, z, g, v, b, h, s] = args;
 
         const auto dims = Mc.dims;
         const auto nx = dims.nx;
@@ -66,6 +70,7 @@ struct ResidualVector::Impl
         assert(v.size() == np);
         assert(b.size() == ny);
         assert(h.size() == nz);
+        assert(s.size() == nx);
 
         ns  = Mc.dims.ns;
         nu  = Mc.dims.nu;
@@ -81,7 +86,6 @@ struct ResidualVector::Impl
         const auto Jx = Wx.bottomRows(nz);
         const auto Jp = Wp.bottomRows(nz);
 
-        const auto As = Ax(all, js);
         const auto Au = Ax(all, ju);
 
         const auto Js = Jx(all, js);
@@ -90,8 +94,6 @@ struct ResidualVector::Impl
         const auto Sbsns = Mc.Sbsns;
         const auto Sbsp  = Mc.Sbsp;
 
-        const auto gs = g(js);
-
         asu.resize(nx);
         auto as = asu.head(ns);
         auto au = asu.tail(nu);
@@ -110,8 +112,9 @@ struct ResidualVector::Impl
         xs = x(js);
         xu = x(ju);
 
-        ax.resize(nx);
-        ax(js).noalias() = -(gs + tr(As)*y + tr(Js)*z);
+        // The optimality residuals ax(js) = -(gs + tr(As)*y + tr(Js)*z) are the stable entries of -s, with s = g + tr(Wx)*w
+        // already computed in the stability check, so that the product tr(Wx)*w is not computed again with gathered columns
+        ax.noalias() = -s;
         ax(ju).fill(0.0);
 
         as = ax(js);
@@ -124,7 +127,14 @@ struct ResidualVector::Impl
 
         awstar.resize(nw);
         awstar.head(ny) = b - Au*xu;
-        awstar.tail(nz) = Js*xs + Jp*p - h;
+
+        if(sparseJx)
+        {
+            xsmask = x;
+            xsmask(ju).fill(0.0);
+            awstar.tail(nz) = Jx(all, Jxcols)*xsmask(Jxcols) + Jp*p - h;
+        }
+        else awstar.tail(nz) = Js*xs + Jp*p - h;
 
         awbs = multiplyMatrixVectorWithoutResidualRoundOffError(Rbs, awstar);
         awbs.noalias() -= xbs + Sbsns*xns + Sbsp*args.p;
@@ -160,6 +170,12 @@ auto ResidualVector::operator=(ResidualVector other) -> ResidualVector&
     return *this;
 }
 
+auto ResidualVector::setNonZeroColumnsJx(IndicesView Jxcols) -> void
+{
+    pimpl->Jxcols = Jxcols;
+    pimpl->sparseJx = true;
+}
+
 auto ResidualVector::update(ResidualVectorUpdateArgs args) -> void
 {
     pimpl->update(args);
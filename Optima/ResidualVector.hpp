@@ -41,6 +41,7 @@ struct ResidualVectorUpdateArgs
     VectorView v;
     VectorView b;
     VectorView h;
+    VectorView s; ///< The stability vector *s = g + tr(Wx)*w* (see Stability), whose stable entries negated are the optimality residuals.
 };
 
 /// Used to represent the residual vector in the optimization problem.
@@ -64,6 +65,12 @@ public:
     /// Assign a ResidualVector instance to this.
     auto operator=(ResidualVector other) -> ResidualVector&;
 
+    /// Declare the columns of *Jx* in *Wx = [Ax; Jx]* that can be non-zero.
+    /// The columns of *Jx* not in `Jxcols` are then skipped in the
+    /// computation of the residual vector. By default, all columns of *Jx*
+    /// are considered.
+    auto setNonZeroColumnsJx(IndicesView Jxcols) -> void;
+
     /// Update the residual vector.
     auto update(ResidualVectorUpdateArgs args) -> void;
 
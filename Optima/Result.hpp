@@ -32,7 +32,9 @@ public:
     /// The flag that indicates if the optimization calculation converged.
     bool succeeded = false;
 
-    /// The reason for the failure in the optimization calculation.
+    /// The reason for the failure in the optimization calculation (empty if it succeeded).
+    /// It is one of `maxiters`, `infeasibility`, `divergence` and `stagnation` (see ConvergenceOptions),
+    /// or `timeout` and `cancelled` (see Options), in which cases the state is the best iterate so far.
     std::string failure_reason;
 
     /// The number of iterations in the optimization calculation.
@@ -0,0 +1,337 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Scaler.hpp"
+
+// C++ includes
+#include <cmath>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+
+namespace Optima {
+namespace {
+
+/// Return the power of two closest to a given positive number (so that scaling with it introduces no round-off errors).
+auto nearestPowerOfTwo(double x) -> double
+{
+    return std::exp2(std::round(std::log2(x)));
+}
+
+/// Return the smallest non-zero entry in a vector of non-negative entries (or zero if all entries are zero).
+template<typename VectorType>
+auto minNonZero(const VectorType& v) -> double
+{
+    auto res = 0.0;
+    for(auto i = 0; i < v.size(); ++i)
+        if(v[i] > 0.0 && (res == 0.0 || v[i] < res))
+            res = v[i];
+    return res;
+}
+
+} // namespace
+
+struct Scaler::Impl
+{
+    ScalerOptions options;        ///< The options for the scaling of the master optimization problem.
+    MasterProblem sproblem;       ///< The scaled master optimization problem.
+    const MasterProblem* current; ///< The master optimization problem to be solved (the scaled one or the original one if not scaled).
+    Vector dr;                    ///< The scaling factors of the rows of [Ax Ap] and b.
+    Vector dx;                    ///< The scaling factors of the variables x.
+    Vector dw;                    ///< The scaling factors of the Lagrange multipliers w = (y, z).
+    Matrix S;                     ///< The absolute values of the entries in the scaled matrix [Ax Ap] (auxiliary).
+    bool scaled = false;          ///< True if the master optimization problem has been scaled in the last initialization.
+
+    Impl()
+    : current(&sproblem)
+    {}
+
+    Impl(const Impl& other)
+    : options(other.options), sproblem(other.sproblem), current(other.scaled ? &sproblem : other.current),
+      dr(other.dr), dx(other.dx), dw(other.dw), scaled(other.scaled)
+    {}
+
+    auto initialize(const MasterProblem& problem) -> void
+    {
+        const auto [nx, np, ny, nz, nw, nt] = problem.dims;
+
+        dr.setOnes(ny);
+        dx.setOnes(nx);
+        dw.setOnes(nw);
+
+        scaled = options.active && ny > 0;
+        current = &problem;
+
+        if(!scaled)
+            return;
+
+        S.resize(ny, nx + np);
+        S.leftCols(nx) = problem.Ax.cwiseAbs();
+        S.rightCols(np) = problem.Ap.cwiseAbs();
+
+        switch(options.method)
+        {
+            case ScalingMethod::Ruiz: computeRuizScaling(nx); break;
+            case ScalingMethod::Geometric: computeGeometricScaling(nx); break;
+        }
+
+        dr = dr.unaryExpr(&nearestPowerOfTwo);
+        dx = dx.unaryExpr(&nearestPowerOfTwo);
+        dw.head(ny) = dr;
+
+        updateScaledProblem(problem);
+
+        current = &sproblem;
+    }
+
+    /// Compute the scaling factors with Ruiz equilibration of matrix S.
+    auto computeRuizScaling(Index nx) -> void
+    {
+        const auto ny = S.rows();
+        const auto tol = options.tolerance;
+
+        // Return true if a given largest entry in a row or column is sufficiently close to one (or zero, if the row or column is zero)
+        const auto equilibrated = [&](double smax) { return smax == 0.0 || std::abs(1.0 - smax) <= tol; };
+
+        Vector rmax, cmax;
+
+        for(auto pass = 0U; pass < options.maxpasses; ++pass)
+        {
+            rmax = S.rowwise().maxCoeff();
+            cmax = options.columns && ny ? Vector(S.leftCols(nx).colwise().maxCoeff()) : Vector();
+
+            if(rmax.unaryExpr(equilibrated).all() && cmax.unaryExpr(equilibrated).all())
+                break;
+
+            for(auto i = 0; i < ny; ++i)
+                if(rmax[i] > 0.0)
+                    dr[i] /= std::sqrt(rmax[i]), S.row(i) /= std::sqrt(rmax[i]);
+
+            for(auto j = 0; j < cmax.size(); ++j)
+                if(cmax[j] > 0.0)
+                    dx[j] /= std::sqrt(cmax[j]), S.col(j) /= std::sqrt(cmax[j]);
+        }
+    }
+
+    /// Compute the scaling factors with geometric scaling of matrix S.
+    auto computeGeometricScaling(Index nx) -> void
+    {
+        const auto ny = S.rows();
+        const auto tol = options.tolerance;
+
+        auto ratioold = std::numeric_limits<double>::infinity();
+
+        for(auto pass = 0U; pass < options.maxpasses; ++pass)
+        {
+            auto ratio = 0.0;
+
+            for(auto i = 0; i < ny; ++i)
+            {
+                const auto smin = minNonZero(S.row(i));
+                const auto smax = S.row(i).maxCoeff();
+                if(smax == 0.0) continue;
+                ratio = std::max(ratio, smax/smin);
+                const auto factor = 1.0/std::sqrt(smin * smax);
+                dr[i] *= factor, S.row(i) *= factor;
+            }
+
+            if(options.columns) for(auto j = 0; j < nx; ++j)
+            {
+                const auto smin = minNonZero(S.col(j));
+                const auto smax = S.col(j).maxCoeff();
+                if(smax == 0.0) continue;
+                ratio = std::max(ratio, smax/smin);
+                const auto factor = 1.0/std::sqrt(smin * smax);
+                dx[j] *= factor, S.col(j) *= factor;
+            }
+
+            if(ratioold - ratio <= tol * ratioold)
+                break;
+
+            ratioold = ratio;
+        }
+    }
+
+    /// Update the scaled master optimization problem with the current scaling factors.
+    auto updateScaledProblem(const MasterProblem& problem) -> void
+    {
+        sproblem.dims = problem.dims;
+        sproblem.Ax = dr.asDiagonal() * problem.Ax * dx.asDiagonal();
+        sproblem.Ap = dr.asDiagonal() * problem.Ap;
+        sproblem.b = dr.cwiseProduct(problem.b);
+        sproblem.xlower = problem.xlower.cwiseQuotient(dx);
+        sproblem.xupper = problem.xupper.cwiseQuotient(dx);
+        sproblem.plower = problem.plower;
+        sproblem.pupper = problem.pupper;
+        sproblem.c = problem.c;
+        sproblem.bc = problem.bc.size() ? Matrix(dr.asDiagonal() * problem.bc) : problem.bc;
+
+        // The functions of the scaled problem evaluate those of the original problem at x = Dx*x'.
+        // Each function keeps its own copy of the scaling factors and of the auxiliary vector for
+        // x, so that copies of these functions can be evaluated concurrently.
+
+        sproblem.r = [r = problem.r, dx = dx, xu = Vector()](VectorView x, VectorView p, VectorView c, ObjectiveOptions fopts, ConstraintOptions hopts, ConstraintOptions vopts) mutable
+        {
+            xu.noalias() = dx.cwiseProduct(x);
+            r(xu, p, c, fopts, hopts, vopts);
+        };
+
+        sproblem.f = [f = problem.f, dx = dx, xu = Vector()](ObjectiveResultRef res, VectorView x, VectorView p, VectorView c, ObjectiveOptions opts) mutable
+        {
+            xu.noalias() = dx.cwiseProduct(x);
+            f(res, xu, p, c, opts);
+            res.fx.array() *= dx.array();
+            if(opts.eval.fxx)
+            {
+                if(res.diagfxx) res.fxx.diagonal().array() *= dx.array().square();
+                else res.fxx.array().colwise() *= dx.array(), res.fxx.array().rowwise() *= dx.transpose().array();
+            }
+            if(opts.eval.fxp) res.fxp.array().colwise() *= dx.array();
+            if(opts.eval.fxc) res.fxc.array().colwise() *= dx.array();
+        };
+
+        sproblem.h = [h = problem.h, dx = dx, xu = Vector()](ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts) mutable
+        {
+            xu.noalias() = dx.cwiseProduct(x);
+            h(res, xu, p, c, opts);
+            if(opts.eval.ddx) res.ddx.array().rowwise() *= dx.transpose().array();
+        };
+
+        sproblem.v = [v = problem.v, dx = dx, xu = Vector()](ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts) mutable
+        {
+            xu.noalias() = dx.cwiseProduct(x);
+            v(res, xu, p, c, opts);
+            if(opts.eval.ddx) res.ddx.array().rowwise() *= dx.transpose().array();
+        };
+
+        sproblem.phi = nullptr;
+        if(problem.phi) sproblem.phi = [phi = problem.phi, dx = dx, xou = Vector(), xu = Vector()](VectorView xo, VectorRef x) mutable
+        {
+            xou.noalias() = dx.cwiseProduct(xo);
+            xu.noalias() = dx.cwiseProduct(x);
+            const auto succeeded = phi(xou, xu);
+            x.noalias() = xu.cwiseQuotient(dx);
+            return succeeded;
+        };
+
+        // The scaling of the columns of the Jacobian matrices preserves their sparsity and whether they are constant
+        sproblem.f.setConstantHessian(problem.f.constantHessian());
+        if(problem.f.blockDiagonalHessian()) sproblem.f.setBlocksHessian(problem.f.blocksHessian());
+        if(problem.h.sparseDdx()) sproblem.h.setNonZeroColumnsDdx(problem.h.nonZeroColumnsDdx());
+        if(problem.v.sparseDdx()) sproblem.v.setNonZeroColumnsDdx(problem.v.nonZeroColumnsDdx());
+        sproblem.h.setConstantDerivatives(problem.h.constantDerivatives());
+        sproblem.v.setConstantDerivatives(problem.v.constantDerivatives());
+    }
+
+    auto scale(MasterVectorRef u) const -> void
+    {
+        if(!scaled) return;
+        u.x.array() /= dx.array();
+        u.w.array() /= dw.array();
+    }
+
+    auto unscale(MasterVectorRef u) const -> void
+    {
+        if(!scaled) return;
+        u.x.array() *= dx.array();
+        u.w.array() *= dw.array();
+    }
+
+    auto unscale(MasterState& state) const -> void
+    {
+        if(!scaled) return;
+        unscale(state.u);
+        state.s.array() /= dx.array();
+    }
+
+    auto unscale(MasterSensitivity& sensitivity) const -> void
+    {
+        if(!scaled) return;
+        sensitivity.xc.array().colwise() *= dx.array();
+        sensitivity.wc.array().colwise() *= dw.array();
+        sensitivity.sc.array().colwise() /= dx.array();
+    }
+};
+
+Scaler::Scaler()
+: pimpl(new Impl())
+{}
+
+Scaler::Scaler(const Scaler& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+Scaler::~Scaler()
+{}
+
+auto Scaler::operator=(Scaler other) -> Scaler&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto Scaler::setOptions(const ScalerOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto Scaler::initialize(const MasterProblem& problem) -> void
+{
+    pimpl->initialize(problem);
+}
+
+auto Scaler::scaled() const -> bool
+{
+    return pimpl->scaled;
+}
+
+auto Scaler::problem() const -> const MasterProblem&
+{
+    return *pimpl->current;
+}
+
+auto Scaler::dx() const -> VectorView
+{
+    return pimpl->dx;
+}
+
+auto Scaler::dw() const -> VectorView
+{
+    return pimpl->dw;
+}
+
+auto Scaler::scale(MasterVectorRef u) const -> void
+{
+    pimpl->scale(u);
+}
+
+auto Scaler::unscale(MasterVectorRef u) const -> void
+{
+    pimpl->unscale(u);
+}
+
+auto Scaler::unscale(MasterState& state) const -> void
+{
+    pimpl->unscale(state);
+}
+
+auto Scaler::unscale(MasterSensitivity& sensitivity) const -> void
+{
+    pimpl->unscale(sensitivity);
+}
+
+} // namespace Optima
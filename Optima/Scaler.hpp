@@ -0,0 +1,91 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/MasterProblem.hpp>
+#include <Optima/MasterSensitivity.hpp>
+#include <Optima/MasterState.hpp>
+#include <Optima/ScalerOptions.hpp>
+
+namespace Optima {
+
+/// Used to scale a master optimization problem so that it is better conditioned.
+/// The scaled master problem is obtained with the change of variables *x = Dx·x'*
+/// and the scaling of the linear equality constraints *Dr·(Ax·x + Ap·p) = Dr·b*,
+/// where *Dx* and *Dr* are diagonal matrices whose entries are powers of two
+/// (so that scaling and unscaling introduce no round-off errors). The
+/// Lagrange multipliers are then related by *y = Dr·y'* and the stabilities
+/// of the variables by *s = Dx⁻¹·s'*.
+class Scaler
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a default Scaler object.
+    Scaler();
+
+    /// Construct a copy of a Scaler object.
+    Scaler(const Scaler& other);
+
+    /// Destroy this Scaler object.
+    virtual ~Scaler();
+
+    /// Assign a Scaler object to this.
+    auto operator=(Scaler other) -> Scaler&;
+
+    /// Set the options for the scaling of the master optimization problem.
+    auto setOptions(const ScalerOptions& options) -> void;
+
+    /// Initialize the scaling factors and the scaled master optimization problem.
+    /// If scaling is not active, the master optimization problem is used as is,
+    /// and it must then outlive the use of @ref problem.
+    auto initialize(const MasterProblem& problem) -> void;
+
+    /// Return `true` if the master optimization problem has been scaled in the last initialization.
+    auto scaled() const -> bool;
+
+    /// Return the scaled master optimization problem (or the original one if not scaled).
+    auto problem() const -> const MasterProblem&;
+
+    /// Return the scaling factors *Dx* of the variables *x* (with *x = Dx·x'*).
+    auto dx() const -> VectorView;
+
+    /// Return the scaling factors *Dw* of the Lagrange multipliers *w = (y, z)* (with *w = Dw·w'*).
+    auto dw() const -> VectorView;
+
+    /// Convert the master variables *u = (x, p, w)* of the original problem into those of the scaled problem.
+    auto scale(MasterVectorRef u) const -> void;
+
+    /// Convert the master variables *u = (x, p, w)* of the scaled problem into those of the original problem.
+    auto unscale(MasterVectorRef u) const -> void;
+
+    /// Convert the master state of the scaled problem into that of the original problem.
+    auto unscale(MasterState& state) const -> void;
+
+    /// Convert the sensitivity derivatives of the scaled problem into those of the original problem.
+    auto unscale(MasterSensitivity& sensitivity) const -> void;
+};
+
+} // namespace Optima
@@ -0,0 +1,64 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace Optima {
+
+/// Used to describe the possible methods for computing the scaling factors of the master optimization problem.
+enum class ScalingMethod
+{
+    /// The scaling factors of each row (column) are the inverse of the square root of the largest entry in the row (column).
+    /// This method, known as Ruiz equilibration, is repeated until the largest
+    /// entries in all rows and columns of the scaled matrix are close to one.
+    Ruiz,
+
+    /// The scaling factors of each row (column) are the inverse of the geometric mean of the smallest and largest entries in the row (column).
+    /// This method is repeated until the ratios between the largest and
+    /// smallest entries in the rows and columns of the scaled matrix no longer
+    /// decrease significantly.
+    Geometric,
+};
+
+/// Used to organize the options for the scaling of the master optimization problem.
+struct ScalerOptions
+{
+    /// The boolean flag that indicates if the master optimization problem is scaled before it is solved.
+    /// The rows of *[Ax Ap]* and *b* and the variables *x* are scaled so that
+    /// the entries of the scaled matrix *Ax* have magnitudes close to one.
+    /// The objective and constraint functions, the bounds of *x*, the residual
+    /// errors, and the sensitivity derivatives are scaled consistently, so that
+    /// the solution of the original problem is recovered at the end.
+    bool active = false;
+
+    /// The method for computing the scaling factors.
+    ScalingMethod method = ScalingMethod::Ruiz;
+
+    /// The boolean flag that indicates if the variables *x* (i.e., the columns of *Ax*) are scaled, in addition to the rows of *[Ax Ap]*.
+    bool columns = true;
+
+    /// The maximum number of passes over the rows and columns of *Ax* in the computation of the scaling factors.
+    unsigned maxpasses = 20;
+
+    /// The tolerance used to stop the computation of the scaling factors.
+    /// For @ref ScalingMethod::Ruiz, the largest entries in the rows and columns of the
+    /// scaled matrix need to be within this tolerance from one. For @ref ScalingMethod::Geometric,
+    /// the largest ratio between the entries of the scaled matrix needs to decrease by less than this relative tolerance.
+    double tolerance = 1.0e-1;
+};
+
+} // namespace Optima
@@ -35,6 +35,8 @@ Sensitivity::Sensitivity(const Dims& dims)
   xhgc(zeros(dims.hg, dims.c))
 {}
 
+Sensitivity::Sensitivity(const Sensitivity& other) = default;
+
 auto Sensitivity::operator=(const Sensitivity& other) -> Sensitivity&
 {
     const_cast<Dims&>(dims) = other.dims;
@@ -45,6 +45,9 @@ public:
     /// Construct a Sensitivity object with given dimensions.
     Sensitivity(const Dims& dims);
 
+    /// Construct a copy of a Sensitivity object.
+    Sensitivity(const Sensitivity& other);
+
     /// Assign a Sensitivity instance to this.
     auto operator=(const Sensitivity& other) -> Sensitivity&;
 
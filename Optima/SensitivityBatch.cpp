@@ -0,0 +1,278 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "SensitivityBatch.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <array>
+
+// Optima includes
+#include <Optima/BatchStorage.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/Sensitivity.hpp>
+
+namespace Optima {
+namespace {
+
+/// The number of entries in the header of the buffer of a SensitivityBatch object (the dimensions and the number of cells).
+const Index nheader = 8;
+
+/// Return the header of the buffer of a SensitivityBatch object.
+auto header(const Dims& dims, Index size) -> std::array<Index, nheader>
+{
+    return { dims.x, dims.p, dims.be, dims.bg, dims.he, dims.hg, dims.c, size };
+}
+
+/// Return the number of bytes in the buffer of a SensitivityBatch object.
+auto bytes(const Dims& dims, Index size) -> std::size_t
+{
+    const auto nrows = 2*dims.x + dims.p + dims.be + 2*dims.bg + dims.he + 2*dims.hg;
+    return nheader*sizeof(Index) + size*nrows*dims.c*sizeof(double);
+}
+
+} // namespace
+
+SensitivityRef::SensitivityRef(const Dims& dims, MatrixRef xc, MatrixRef pc, MatrixRef yec, MatrixRef ygc, MatrixRef zec, MatrixRef zgc, MatrixRef sc, MatrixRef xbgc, MatrixRef xhgc)
+: dims(dims), xc(xc), pc(pc), yec(yec), ygc(ygc), zec(zec), zgc(zgc), sc(sc), xbgc(xbgc), xhgc(xhgc)
+{}
+
+auto SensitivityRef::operator=(const Sensitivity& other) -> SensitivityRef&
+{
+    resize(other.dims);
+    xc = other.xc;
+    pc = other.pc;
+    yec = other.yec;
+    ygc = other.ygc;
+    zec = other.zec;
+    zgc = other.zgc;
+    sc = other.sc;
+    xbgc = other.xbgc;
+    xhgc = other.xhgc;
+    return *this;
+}
+
+auto SensitivityRef::resize(const Dims& newdims) -> void
+{
+    errorif(header(dims, 0) != header(newdims, 0), "Cannot resize the sensitivity derivatives in a cell of a SensitivityBatch object.");
+}
+
+auto SensitivityRef::sensitivity() const -> Sensitivity
+{
+    Sensitivity res(dims);
+    res.xc.__assign(xc);
+    res.pc.__assign(pc);
+    res.yec.__assign(yec);
+    res.ygc.__assign(ygc);
+    res.zec.__assign(zec);
+    res.zgc.__assign(zgc);
+    res.sc.__assign(sc);
+    res.xbgc.__assign(xbgc);
+    res.xhgc.__assign(xhgc);
+    return res;
+}
+
+struct SensitivityBatch::Impl
+{
+    Dims dims;               ///< The dimensions of the variables and constraints in the optimization problems.
+    Index size = 0;          ///< The number of cells in the batch.
+    BatchStorage storage;    ///< The buffer where the header and all fields are stored.
+    double* xc   = nullptr;  ///< The beginning of the derivatives *xc* of all cells.
+    double* pc   = nullptr;  ///< The beginning of the derivatives *pc* of all cells.
+    double* yec  = nullptr;  ///< The beginning of the derivatives *yec* of all cells.
+    double* ygc  = nullptr;  ///< The beginning of the derivatives *ygc* of all cells.
+    double* zec  = nullptr;  ///< The beginning of the derivatives *zec* of all cells.
+    double* zgc  = nullptr;  ///< The beginning of the derivatives *zgc* of all cells.
+    double* sc   = nullptr;  ///< The beginning of the derivatives *sc* of all cells.
+    double* xbgc = nullptr;  ///< The beginning of the derivatives *xbgc* of all cells.
+    double* xhgc = nullptr;  ///< The beginning of the derivatives *xhgc* of all cells.
+
+    Impl()
+    {
+        setup();
+    }
+
+    Impl(const Dims& dims, Index size)
+    : dims(dims), size(size), storage(bytes(dims, size))
+    {
+        setup();
+    }
+
+    Impl(const Dims& dims, Index size, const std::string& filename)
+    : dims(dims), size(size), storage(bytes(dims, size), filename)
+    {
+        setup();
+    }
+
+    Impl(const Impl& other)
+    : dims(other.dims), size(other.size), storage(other.storage)
+    {
+        setup();
+    }
+
+    /// Initialize or check the header of the buffer and the pointers to the fields.
+    auto setup() -> void
+    {
+        if(storage.bytes() == 0)
+            return;
+
+        const auto expected = header(dims, size);
+
+        auto head = reinterpret_cast<Index*>(storage.data());
+        if(std::all_of(head, head + nheader, [](Index i) { return i == 0; })) // a new buffer
+            std::copy(expected.begin(), expected.end(), head);
+        errorif(!std::equal(expected.begin(), expected.end(), head),
+            "Expecting a SensitivityBatch buffer with the given dimensions and number of cells, but the existing one has different ones.");
+
+        const auto nc = dims.c;
+
+        xc   = reinterpret_cast<double*>(head + nheader);
+        pc   = xc   + size*dims.x*nc;
+        yec  = pc   + size*dims.p*nc;
+        ygc  = yec  + size*dims.be*nc;
+        zec  = ygc  + size*dims.bg*nc;
+        zgc  = zec  + size*dims.he*nc;
+        sc   = zgc  + size*dims.hg*nc;
+        xbgc = sc   + size*dims.x*nc;
+        xhgc = xbgc + size*dims.bg*nc;
+    }
+
+    auto cell(Index i) -> SensitivityRef
+    {
+        errorif(i < 0 || i >= size, "Expecting a cell index in [0, ", size, ") in SensitivityBatch, but got ", i, ".");
+
+        const auto nc = dims.c;
+
+        auto mat = [&](double* data, Index n) -> MatrixRef { return Eigen::Map<Matrix>(data + i*n*nc, n, nc); };
+
+        return SensitivityRef(dims,
+            mat(xc, dims.x), mat(pc, dims.p), mat(yec, dims.be), mat(ygc, dims.bg), mat(zec, dims.he), mat(zgc, dims.hg),
+            mat(sc, dims.x), mat(xbgc, dims.bg), mat(xhgc, dims.hg));
+    }
+
+    auto field(double* data, Index n) -> MatrixRef
+    {
+        return Eigen::Map<Matrix>(data, n*dims.c, size);
+    }
+};
+
+SensitivityBatch::SensitivityBatch()
+: pimpl(new Impl())
+{}
+
+SensitivityBatch::SensitivityBatch(const Dims& dims, Index size)
+: pimpl(new Impl(dims, size))
+{}
+
+SensitivityBatch::SensitivityBatch(const Dims& dims, Index size, const std::string& filename)
+: pimpl(new Impl(dims, size, filename))
+{}
+
+SensitivityBatch::SensitivityBatch(const SensitivityBatch& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+SensitivityBatch::~SensitivityBatch()
+{}
+
+auto SensitivityBatch::operator=(SensitivityBatch other) -> SensitivityBatch&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto SensitivityBatch::dims() const -> const Dims&
+{
+    return pimpl->dims;
+}
+
+auto SensitivityBatch::size() const -> Index
+{
+    return pimpl->size;
+}
+
+auto SensitivityBatch::operator[](Index i) -> SensitivityRef
+{
+    return pimpl->cell(i);
+}
+
+auto SensitivityBatch::sensitivity(Index i) const -> Sensitivity
+{
+    return pimpl->cell(i).sensitivity();
+}
+
+auto SensitivityBatch::xc() -> MatrixRef
+{
+    return pimpl->field(pimpl->xc, pimpl->dims.x);
+}
+
+auto SensitivityBatch::pc() -> MatrixRef
+{
+    return pimpl->field(pimpl->pc, pimpl->dims.p);
+}
+
+auto SensitivityBatch::yec() -> MatrixRef
+{
+    return pimpl->field(pimpl->yec, pimpl->dims.be);
+}
+
+auto SensitivityBatch::ygc() -> MatrixRef
+{
+    return pimpl->field(pimpl->ygc, pimpl->dims.bg);
+}
+
+auto SensitivityBatch::zec() -> MatrixRef
+{
+    return pimpl->field(pimpl->zec, pimpl->dims.he);
+}
+
+auto SensitivityBatch::zgc() -> MatrixRef
+{
+    return pimpl->field(pimpl->zgc, pimpl->dims.hg);
+}
+
+auto SensitivityBatch::sc() -> MatrixRef
+{
+    return pimpl->field(pimpl->sc, pimpl->dims.x);
+}
+
+auto SensitivityBatch::xbgc() -> MatrixRef
+{
+    return pimpl->field(pimpl->xbgc, pimpl->dims.bg);
+}
+
+auto SensitivityBatch::xhgc() -> MatrixRef
+{
+    return pimpl->field(pimpl->xhgc, pimpl->dims.hg);
+}
+
+auto SensitivityBatch::mapped() const -> bool
+{
+    return pimpl->storage.mapped();
+}
+
+auto SensitivityBatch::flush() -> void
+{
+    pimpl->storage.flush();
+}
+
+auto SensitivityBatch::save(const std::string& filename) const -> void
+{
+    pimpl->storage.save(filename);
+}
+
+} // namespace Optima
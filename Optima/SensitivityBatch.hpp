@@ -0,0 +1,144 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+#include <string>
+
+// Optima includes
+#include <Optima/Dims.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Sensitivity;
+
+/// A view to the sensitivity derivatives of the optimum state stored in a cell of a SensitivityBatch object.
+/// @see Sensitivity
+class SensitivityRef
+{
+public:
+    Dims const dims;   ///< The dimensions of the variables and constraints in the optimization problem.
+    MatrixRef xc;      ///< The sensitivity derivatives \eq{\partial x/\partial c} with respect to parameters \eq{c}.
+    MatrixRef pc;      ///< The sensitivity derivatives \eq{\partial p/\partial c} with respect to parameters \eq{c}.
+    MatrixRef yec;     ///< The sensitivity derivatives \eq{\partial y_{\mathrm{e}/\partial c} with respect to parameters \eq{c}.
+    MatrixRef ygc;     ///< The sensitivity derivatives \eq{\partial y_{\mathrm{g}/\partial c} with respect to parameters \eq{c}.
+    MatrixRef zec;     ///< The sensitivity derivatives \eq{\partial z_{\mathrm{e}/\partial c} with respect to parameters \eq{c}.
+    MatrixRef zgc;     ///< The sensitivity derivatives \eq{\partial z_{\mathrm{g}/\partial c} with respect to parameters \eq{c}.
+    MatrixRef sc;      ///< The sensitivity derivatives \eq{\partial s/\partial c} with respect to parameters \eq{c}.
+    MatrixRef xbgc;    ///< The sensitivity derivatives \eq{\partial x_{b_{\mathrm{g}}/\partial c} with respect to parameters \eq{c}.
+    MatrixRef xhgc;    ///< The sensitivity derivatives \eq{\partial x_{h_{\mathrm{g}}/\partial c} with respect to parameters \eq{c}.
+
+    /// Construct a SensitivityRef object with given dimensions and views to the fields of the sensitivity derivatives.
+    SensitivityRef(const Dims& dims, MatrixRef xc, MatrixRef pc, MatrixRef yec, MatrixRef ygc, MatrixRef zec, MatrixRef zgc, MatrixRef sc, MatrixRef xbgc, MatrixRef xhgc);
+
+    /// Assign a Sensitivity instance to this.
+    auto operator=(const Sensitivity& other) -> SensitivityRef&;
+
+    /// Check this view has given dimensions, since the sensitivity derivatives in a cell of a SensitivityBatch object cannot be resized.
+    auto resize(const Dims& dims) -> void;
+
+    /// Return a copy of the sensitivity derivatives in this view as a Sensitivity object.
+    auto sensitivity() const -> Sensitivity;
+};
+
+/// Used to store the sensitivity derivatives of the optimum states of many cells in structure-of-arrays layout.
+/// Each field (e.g., *xc*, *yec*) is stored for all cells in a contiguous array, with the entries of each
+/// cell contiguous in column-major order, so that the sensitivity derivatives of a cell are viewed without
+/// copies (see SensitivityRef) and the field of all cells is viewed as a matrix with one column per cell.
+/// All fields are stored in a single buffer, in memory or in a memory-mapped file (see BatchStorage).
+class SensitivityBatch
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a default SensitivityBatch object.
+    SensitivityBatch();
+
+    /// Construct a SensitivityBatch object in memory with given dimensions and number of cells.
+    SensitivityBatch(const Dims& dims, Index size);
+
+    /// Construct a SensitivityBatch object backed by a memory-mapped file with given dimensions and number of cells.
+    /// The contents of an existing file (e.g., created with @ref save) are kept if they correspond to the given dimensions and number of cells.
+    SensitivityBatch(const Dims& dims, Index size, const std::string& filename);
+
+    /// Construct a copy of a SensitivityBatch object (the copy is always in memory).
+    SensitivityBatch(const SensitivityBatch& other);
+
+    /// Destroy this SensitivityBatch object.
+    virtual ~SensitivityBatch();
+
+    /// Assign a SensitivityBatch object to this.
+    auto operator=(SensitivityBatch other) -> SensitivityBatch&;
+
+    /// Return the dimensions of the variables and constraints in the optimization problems.
+    auto dims() const -> const Dims&;
+
+    /// Return the number of cells in this batch.
+    auto size() const -> Index;
+
+    /// Return a view to the sensitivity derivatives of the cell with given index.
+    auto operator[](Index i) -> SensitivityRef;
+
+    /// Return a copy of the sensitivity derivatives of the cell with given index as a Sensitivity object.
+    auto sensitivity(Index i) const -> Sensitivity;
+
+    /// Return the derivatives *xc* of all cells with dimensions *nx*nc* by *size*.
+    auto xc() -> MatrixRef;
+
+    /// Return the derivatives *pc* of all cells with dimensions *np*nc* by *size*.
+    auto pc() -> MatrixRef;
+
+    /// Return the derivatives *yec* of all cells with dimensions *nbe*nc* by *size*.
+    auto yec() -> MatrixRef;
+
+    /// Return the derivatives *ygc* of all cells with dimensions *nbg*nc* by *size*.
+    auto ygc() -> MatrixRef;
+
+    /// Return the derivatives *zec* of all cells with dimensions *nhe*nc* by *size*.
+    auto zec() -> MatrixRef;
+
+    /// Return the derivatives *zgc* of all cells with dimensions *nhg*nc* by *size*.
+    auto zgc() -> MatrixRef;
+
+    /// Return the derivatives *sc* of all cells with dimensions *nx*nc* by *size*.
+    auto sc() -> MatrixRef;
+
+    /// Return the derivatives *xbgc* of all cells with dimensions *nbg*nc* by *size*.
+    auto xbgc() -> MatrixRef;
+
+    /// Return the derivatives *xhgc* of all cells with dimensions *nhg*nc* by *size*.
+    auto xhgc() -> MatrixRef;
+
+    /// Return `true` if this batch is backed by a memory-mapped file.
+    auto mapped() const -> bool;
+
+    /// Write the modified contents of a memory-mapped batch to its file (no effect if in memory).
+    auto flush() -> void;
+
+    /// Save the contents of this batch to a file with a single write, which can be mapped later in memory.
+    auto save(const std::string& filename) const -> void;
+};
+
+} // namespace Optima
@@ -23,10 +23,13 @@
 #include <Optima/IndexUtils.hpp>
 #include <Optima/MasterSolver.hpp>
 #include <Optima/Options.hpp>
+#include <Optima/Presolver.hpp>
 #include <Optima/Problem.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/Sensitivity.hpp>
+#include <Optima/SensitivityBatch.hpp>
 #include <Optima/State.hpp>
+#include <Optima/StateBatch.hpp>
 #include <Optima/Timing.hpp>
 #include <Optima/Utils.hpp>
 
@@ -50,6 +53,23 @@ struct Solver::Impl
     Index nwbar = 0;                ///< The number of Lagrange multipliers in wbar = (ye, yg, ze, zg).
     Vector xbarlower;               ///< The lower bounds of vector xbar = (x, xbg, xhg) in the master optimization problem.
     Vector xbarupper;               ///< The upper bounds of vector xbar = (x, xbg, xhg) in the master optimization problem.
+    Presolver presolver;            ///< The presolver that reduces the optimization problem before it is solved.
+    Indices jx;                     ///< The indices of the variables x that remain in the master optimization problem after the presolve stage.
+    Indices jf;                     ///< The indices of the variables x eliminated in the presolve stage.
+    Indices kf;                     ///< The indices of the rows of Aex that determined the eliminated variables (or -1 if determined by their bounds).
+    Indices ie;                     ///< The indices of the rows of Aex that remain in the master optimization problem after the presolve stage.
+    Vector xf;                      ///< The values of the variables x eliminated in the presolve stage.
+    Matrix xfc;                     ///< The derivatives of the eliminated variables with respect to the sensitivity parameters c.
+    Index nxr   = 0;                ///< The number of variables x that remain in the master optimization problem.
+    Index nber  = 0;                ///< The number of linear equality constraints that remain in the master optimization problem.
+    Index nf    = 0;                ///< The number of variables x eliminated in the presolve stage.
+    Vector xfull;                   ///< The variables x, including the eliminated ones, used to evaluate the functions of the problem when nf > 0.
+    ObjectiveResult fres;           ///< The evaluation of f(x, p) with respect to all variables x at the final state when nf > 0.
+    ConstraintResult heres;         ///< The evaluation of he(x, p) with respect to all variables x at the final state when nf > 0.
+    ConstraintResult hgres;         ///< The evaluation of hg(x, p) with respect to all variables x at the final state when nf > 0.
+    ConstraintResult vres;          ///< The evaluation of v(x, p) with respect to all variables x when nf > 0.
+    const Problem* pproblem = nullptr; ///< The optimization problem in the calculation started with begin.
+    State* pstate = nullptr;        ///< The state of the optimization problem in the calculation started with begin.
 
     /// Construct a Solver default instance.
     Impl()
@@ -60,6 +80,7 @@ struct Solver::Impl
     auto setOptions(const Options& opts) -> void
     {
         options = opts;
+        presolver.setOptions(opts.presolver);
     }
 
     /// Update the options for the master optimization problem.
@@ -79,11 +100,9 @@ struct Solver::Impl
             opts.output.xbgnames.clear();
             opts.output.xhgnames.clear();
 
-            // Add x variable names into options.output.xnames
-            if(options.output.xnames.empty())
-                for(auto i = 0; i < nx; ++i)
-                    opts.output.xnames.push_back(std::to_string(i));
-            else opts.output.xnames = options.output.xnames;
+            // Add x variable names into options.output.xnames (only those of the variables remaining after the presolve stage)
+            for(auto i : jx)
+                opts.output.xnames.push_back(options.output.xnames.empty() ? std::to_string(i) : options.output.xnames[i]);
 
             // Add xbg variable names into options.output.xnames
             if(options.output.xbgnames.empty())
@@ -97,6 +116,16 @@ struct Solver::Impl
                     opts.output.xnames.push_back("hg:" + std::to_string(i)); // x[hg:0], x[hg:1] for slack variables associated to non-linear inequality constraints
             else opts.output.xnames.insert(opts.output.xnames.end(), options.output.xhgnames.begin(), options.output.xhgnames.end());
 
+            // Keep in options.output.ynames only the names of the linear equality constraints remaining after the presolve stage
+            if(!options.output.ynames.empty() && nber < dims.be)
+            {
+                errorif(Index(options.output.ynames.size()) != ny, "Expecting ", ny, " Lagrange multiplier names in options.output.ynames, but got ", options.output.ynames.size(), " instead.");
+                opts.output.ynames.clear();
+                for(auto i : ie)
+                    opts.output.ynames.push_back(options.output.ynames[i]);
+                opts.output.ynames.insert(opts.output.ynames.end(), options.output.ynames.end() - dims.bg, options.output.ynames.end());
+            }
+
             msolver.setOptions(opts);
         }
         else msolver.setOptions(options);
@@ -110,11 +139,9 @@ struct Solver::Impl
         nx    = dims.x;
         nxbg  = dims.bg;
         nxhg  = dims.hg;
-        nxbar = nx + nxbg + nxhg;
         np    = dims.p;
         ny    = dims.be + dims.bg;
         nz    = dims.he + dims.hg;
-        nwbar = ny + nz;
 
         errorif(!problem.f.initialized(),
             "Cannot solve the optimization problem. "
@@ -136,9 +163,133 @@ struct Solver::Impl
             "You have not initialized the complementary constraint function v(x, p). "
             "Ensure Problem::v is properly initialized.");
 
+        // Determine the variables and linear equality constraints that can be eliminated from the problem
+        presolver.update({ problem.Aex, problem.Aep, problem.be, problem.xlower, problem.xupper });
+
+        const auto status = presolver.status();
+
+        jx = status.jx;
+        jf = status.jf;
+        kf = status.kf;
+        ie = status.ie;
+        xf = status.xf;
+
+        // Initialize dimension variables of the reduced problem
+        nxr   = jx.size();
+        nber  = ie.size();
+        nf    = jf.size();
+        nxbar = nxr + nxbg + nxhg;
+        nwbar = nber + dims.bg + nz;
+
         // Initialize the dimensions of the master optimization problem
-        mproblem.dims = MasterDims(nxbar, np, ny, nz);
+        mproblem.dims = MasterDims(nxbar, np, nber + dims.bg, nz);
+
+        // Initialize the resources, objective, and constraint functions of the master optimization problem
+        if(nf == 0) updateMasterFunctions(problem);
+        else updateMasterFunctionsWithEliminatedVariables(problem);
+
+        // Declare the Hessian matrix of the master objective function constant if so for f(x, p)
+        mproblem.f.setConstantHessian(problem.f.constantHessian());
+
+        // Declare the Hessian matrix of the master objective function block diagonal if so for f(x, p), with each variable in xbg and xhg in its own block
+        if(problem.f.blockDiagonalHessian())
+        {
+            const auto blocks = problem.f.blocksHessian();
+            errorif(blocks.size() != nx, "The declared blocks of the Hessian matrix of f(x, p) must have one entry per variable in x.");
+            const auto next = nx ? blocks.maxCoeff() + 1 : 0;
+            Indices blocksbar(nxbar);
+            blocksbar.head(nxr) = blocks(jx);
+            blocksbar.tail(nxbg + nxhg) = indices(nxbg + nxhg).array() + next;
+            mproblem.f.setBlocksHessian(blocksbar);
+        }
+
+        // Declare the non-zero columns of dh/d(xbar) if these are known for both he(x, p) and hg(x, p)
+        if((dims.he == 0 || problem.he.sparseDdx()) && (dims.hg == 0 || problem.hg.sparseDdx()))
+        {
+            const auto inrange = [&](IndicesView jcols) { return jcols.size() == 0 || jcols.maxCoeff() < nx; };
+            errorif(dims.he && !inrange(problem.he.nonZeroColumnsDdx()), "The declared non-zero columns of the Jacobian matrix of he(x, p) contain indices out of range.");
+            errorif(dims.hg && !inrange(problem.hg.nonZeroColumnsDdx()), "The declared non-zero columns of the Jacobian matrix of hg(x, p) contain indices out of range.");
+
+            Indices nonzero = Indices::Zero(nx); // 1 for columns of dh/dx that can be non-zero
+            if(dims.he) nonzero(problem.he.nonZeroColumnsDdx()).fill(1);
+            if(dims.hg) nonzero(problem.hg.nonZeroColumnsDdx()).fill(1);
+
+            Indices nonzerobar(nxbar); // 1 for columns of dh/d(xbar) that can be non-zero
+            nonzerobar << nonzero(jx), Indices::Zero(nxbg), Indices::Ones(nxhg); // dhg/dxhg = I
+
+            Indices jcols = indices(nxbar);
+            const auto k = stableMoveLeftIf(jcols, [&](Index j) { return nonzerobar[j]; });
+            mproblem.h.setNonZeroColumnsDdx(jcols.head(k));
+        }
+
+        // Declare the Jacobian matrices of h(xbar, p) constant if these are constant for both he(x, p) and hg(x, p)
+        mproblem.h.setConstantDerivatives((dims.he == 0 || problem.he.constantDerivatives()) && (dims.hg == 0 || problem.hg.constantDerivatives()));
+
+        // Declare the Jacobian matrices of v(xbar, p) constant if so for v(x, p)
+        mproblem.v.setConstantDerivatives(problem.v.constantDerivatives());
 
+        // Initialize the lower bounds of xbar = (x, xbg, xhg) (the bounds tightened in the presolve stage are not actual bounds of x)
+        xbarlower.resize(nxbar);
+        xbarlower.head(nxr) = problem.xlower(jx);
+        xbarlower.tail(nxbg + nxhg).fill(-infinity());
+
+        // Initialize the upper bounds of xbar = (x, xbg, xhg)
+        xbarupper.resize(nxbar);
+        xbarupper.head(nxr) = problem.xupper(jx);
+        xbarupper.tail(nxbg + nxhg).fill(0.0);
+
+        // Initialize vector b = (be, bg) without the contributions of the eliminated variables
+        mproblem.b.resize(nber + dims.bg);
+        mproblem.b << problem.be(ie), problem.bg;
+        if(nf) mproblem.b.head(nber) -= problem.Aex(ie, jf) * xf;
+        if(nf && dims.bg) mproblem.b.tail(dims.bg) -= problem.Agx(all, jf) * xf;
+
+        // Initialize lower and upper bounds for x in the master problem
+        mproblem.xlower = xbarlower;
+        mproblem.xupper = xbarupper;
+
+        // Initialize lower and upper bounds for p in the master problem
+        mproblem.plower = problem.plower;
+        mproblem.pupper = problem.pupper;
+
+        // Initialize matrix Ax = [ [Aex, 0, 0], [Agx, I, 0] ] in the master problem
+        mproblem.Ax.resize(nber + dims.bg, nxbar);
+        if(mproblem.Ax.size()) {
+            mproblem.Ax.leftCols(nxr) << problem.Aex(ie, jx), problem.Agx(all, jx);
+            mproblem.Ax.middleCols(nxr, nxbg).topRows(nber).fill(0.0);
+            mproblem.Ax.middleCols(nxr, nxbg).bottomRows(nxbg) = identity(nxbg, nxbg);
+            mproblem.Ax.rightCols(nxhg).fill(0.0);
+        }
+
+        // Initialize matrix Ap = [ [Aep], [Agp] ] in the master problem
+        mproblem.Ap.resize(nber + dims.bg, np);
+        if(mproblem.Ap.size())
+            mproblem.Ap << problem.Aep(ie, all), problem.Agp;
+
+        // Initialize the sensitivity parameters *c* in the master problem
+        mproblem.c = problem.c;
+
+        // Initialize the derivatives of the eliminated variables with respect to c (non-zero only for those determined by a row of Aex)
+        xfc = zeros(nf, dims.c);
+        for(auto k = 0; k < nf; ++k)
+        {
+            const auto i = kf[k];
+            if(i < 0) continue;
+            xfc.row(k) = problem.bec.row(i) - problem.Aex(i, jf.head(k)) * xfc.topRows(k);
+            xfc.row(k) /= problem.Aex(i, jf[k]);
+        }
+
+        // Initialize the Jacobian matrix of *b* with respect to the sensitivity parameters *c*.
+        mproblem.bc.resize(nber + dims.bg, dims.c);
+        mproblem.bc.topRows(nber) = problem.bec(ie, all);
+        mproblem.bc.bottomRows(dims.bg) = problem.bgc;
+        if(nf && dims.c) mproblem.bc.topRows(nber) -= problem.Aex(ie, jf) * xfc;
+        if(nf && dims.c && dims.bg) mproblem.bc.bottomRows(dims.bg) -= problem.Agx(all, jf) * xfc;
+    }
+
+    /// Update the functions of the master problem object `mproblem` when no variable has been eliminated.
+    auto updateMasterFunctions(const Problem& problem) -> void
+    {
         // Initialize the resources function in the master optimization problem
         mproblem.r = problem.r;
 
@@ -146,9 +297,9 @@ struct Solver::Impl
         mproblem.f = [&](ObjectiveResultRef resbar, VectorView xbar, VectorView p, VectorView c, ObjectiveOptions opts)
         {
             resbar.fx.fill(0.0);
-            resbar.fxx.fill(0.0);
-            resbar.fxp.fill(0.0);
-            resbar.fxc.fill(0.0);
+            if(opts.eval.fxx) resbar.fxx.fill(0.0); // otherwise fxx keeps its previously evaluated value
+            if(opts.eval.fxp) resbar.fxp.fill(0.0);
+            if(opts.eval.fxc) resbar.fxc.fill(0.0);
 
             auto x   = xbar.head(nx);
             auto fx  = resbar.fx.head(nx);
@@ -234,80 +385,148 @@ struct Solver::Impl
 
             problem.v(vres, x, p, c, opts);
         };
+    }
 
-        // Initialize the lower bounds of xbar = (x, xbg, xhg)
-        xbarlower.resize(nxbar);
-        xbarlower.head(nx) = problem.xlower;
-        xbarlower.tail(nxbg + nxhg).fill(-infinity());
+    /// Update the functions of the master problem object `mproblem` when some variables have been eliminated.
+    /// The functions of the problem are evaluated with all variables in x, in which the eliminated ones
+    /// are fixed, and their derivatives with respect to the remaining variables are then extracted.
+    /// Each function keeps its own copy of the auxiliary vectors and results with respect to all
+    /// variables x, so that copies of these functions can be evaluated concurrently.
+    auto updateMasterFunctionsWithEliminatedVariables(const Problem& problem) -> void
+    {
+        const auto nc = dims.c;
 
-        // Initialize the upper bounds of xbar = (x, xbg, xhg)
-        xbarupper.resize(nxbar);
-        xbarupper.head(nx) = problem.xupper;
-        xbarupper.tail(nxbg + nxhg).fill(0.0);
+        xfull = zeros(nx);
+        xfull(jf) = xf;
 
-        // Initialize vector b = (be, bg)
-        mproblem.b.resize(ny);
-        mproblem.b << problem.be, problem.bg;
+        fres.resize(nx, np, nc);
+        heres.resize(dims.he, nx, np, nc);
+        hgres.resize(dims.hg, nx, np, nc);
+        vres.resize(np, nx, np, nc);
 
-        // Initialize lower and upper bounds for x in the master problem
-        mproblem.xlower = xbarlower;
-        mproblem.xupper = xbarupper;
+        fres.fxx.fill(0.0);
+        heres.ddx.fill(0.0);
+        hgres.ddx.fill(0.0);
+        vres.ddx.fill(0.0);
 
-        // Initialize lower and upper bounds for p in the master problem
-        mproblem.plower = problem.plower;
-        mproblem.pupper = problem.pupper;
+        // Create the resources function for the master optimization problem
+        mproblem.r = [this, &problem, xfull = xfull, ibasicvarsfull = Indices()](VectorView xbar, VectorView p, VectorView c, ObjectiveOptions fopts, ConstraintOptions hopts, ConstraintOptions vopts) mutable
+        {
+            xfull(jx) = xbar.head(nxr);
+            const auto ibasicvars = basicVariablesFull(fopts.ibasicvars, ibasicvarsfull);
+            problem.r(xfull, p, c, {fopts.eval, ibasicvars}, {hopts.eval, ibasicvars}, {vopts.eval, ibasicvars});
+        };
 
-        // Initialize matrix Ax = [ [Aex, 0, 0], [Agx, I, 0] ] in the master problem
-        mproblem.Ax.resize(ny, nxbar);
-        if(mproblem.Ax.size()) {
-            mproblem.Ax.leftCols(nx) << problem.Aex, problem.Agx;
-            mproblem.Ax.middleCols(nx, nxbg).bottomRows(nxbg) = identity(nxbg, nxbg);
-            mproblem.Ax.rightCols(nxhg).fill(0.0);
-        }
+        // Create the objective function for the master optimization problem
+        mproblem.f = [this, &problem, xfull = xfull, fres = fres, ibasicvarsfull = Indices()](ObjectiveResultRef resbar, VectorView xbar, VectorView p, VectorView c, ObjectiveOptions opts) mutable
+        {
+            resbar.fx.fill(0.0);
+            if(opts.eval.fxx) resbar.fxx.fill(0.0); // otherwise fxx keeps its previously evaluated value
+            if(opts.eval.fxp) resbar.fxp.fill(0.0);
+            if(opts.eval.fxc) resbar.fxc.fill(0.0);
+
+            xfull(jx) = xbar.head(nxr);
+
+            problem.f(fres, xfull, p, c, {opts.eval, basicVariablesFull(opts.ibasicvars, ibasicvarsfull)});
+
+            resbar.f = fres.f;
+            resbar.fx.head(nxr) = fres.fx(jx);
+            if(opts.eval.fxx) resbar.fxx.topLeftCorner(nxr, nxr) = fres.fxx(jx, jx);
+            if(opts.eval.fxp) resbar.fxp.topRows(nxr) = fres.fxp(jx, all);
+            if(opts.eval.fxc) resbar.fxc.topRows(nxr) = fres.fxc(jx, all) + fres.fxx(jx, jf) * xfc; // the eliminated variables may depend on c
+            resbar.diagfxx = fres.diagfxx;
+            resbar.fxx4basicvars = fres.fxx4basicvars;
+            resbar.succeeded = fres.succeeded;
+        };
 
-        // Initialize matrix Ap = [ [Aep], [Agp] ] in the master problem
-        mproblem.Ap.resize(ny, np);
-        if(mproblem.Ap.size())
-            mproblem.Ap << problem.Aep, problem.Agp;
+        // Create the non-linear equality constraint for the master optimization problem
+        mproblem.h = [this, &problem, xfull = xfull, heres = heres, hgres = hgres, ibasicvarsfull = Indices()](ConstraintResultRef resbar, VectorView xbar, VectorView p, VectorView c, ConstraintOptions opts) mutable
+        {
+            xfull(jx) = xbar.head(nxr);
+
+            const ConstraintOptions hopts{opts.eval, basicVariablesFull(opts.ibasicvars, ibasicvarsfull)};
+
+            problem.he(heres, xfull, p, c, hopts);
+            problem.hg(hgres, xfull, p, c, hopts);
+
+            // The blocks of dh/d(xbar) = [ [dhe/dx dhe/dxbg dhe/dxhg], [dhg/dx dhg/dxbg dhg/dxhg] ] related to xbg and xhg are zero, except dhg/dxhg = I
+            resbar.val.head(dims.he) = heres.val;
+            resbar.val.tail(dims.hg) = hgres.val + xbar.tail(nxhg);
+            resbar.ddx.rightCols(nxbg + nxhg).fill(0.0);
+            resbar.ddx.bottomRightCorner(dims.hg, nxhg).diagonal().fill(1.0);
+            if(opts.eval.ddx) resbar.ddx.topLeftCorner(dims.he, nxr) = heres.ddx(all, jx);
+            if(opts.eval.ddx) resbar.ddx.bottomLeftCorner(dims.hg, nxr) = hgres.ddx(all, jx);
+            if(opts.eval.ddp) resbar.ddp.topRows(dims.he) = heres.ddp;
+            if(opts.eval.ddp) resbar.ddp.bottomRows(dims.hg) = hgres.ddp;
+            if(opts.eval.ddc) resbar.ddc.topRows(dims.he) = heres.ddc + heres.ddx(all, jf) * xfc;
+            if(opts.eval.ddc) resbar.ddc.bottomRows(dims.hg) = hgres.ddc + hgres.ddx(all, jf) * xfc;
+            resbar.ddx4basicvars = heres.ddx4basicvars && hgres.ddx4basicvars;
+            resbar.succeeded = heres.succeeded && hgres.succeeded;
+        };
 
-        // Initialize the sensitivity parameters *c* in the master problem
-        mproblem.c = problem.c;
+        // Create the external non-linear constraint for the master optimization problem
+        mproblem.v = [this, &problem, xfull = xfull, vres = vres, ibasicvarsfull = Indices()](ConstraintResultRef res, VectorView xbar, VectorView p, VectorView c, ConstraintOptions opts) mutable
+        {
+            xfull(jx) = xbar.head(nxr);
+
+            problem.v(vres, xfull, p, c, {opts.eval, basicVariablesFull(opts.ibasicvars, ibasicvarsfull)});
+
+            // The blocks dv/dxbg and dv/dxhg in dv/d(xbar) = [ dv/dx dv/dxbg dv/dxhg ] are zero
+            res.val = vres.val;
+            res.ddx.rightCols(nxbg + nxhg).fill(0.0);
+            if(opts.eval.ddx) res.ddx.leftCols(nxr) = vres.ddx(all, jx);
+            if(opts.eval.ddp) res.ddp = vres.ddp;
+            if(opts.eval.ddc) res.ddc = vres.ddc + vres.ddx(all, jf) * xfc;
+            res.ddx4basicvars = vres.ddx4basicvars;
+            res.succeeded = vres.succeeded;
+        };
+    }
 
-        // Initialize the Jacobian matrix of *b* with respect to the sensitivity parameters *c*.
-        mproblem.bc.resize(ny, dims.c);
-        mproblem.bc.topRows(dims.be) = problem.bec;
-        mproblem.bc.bottomRows(dims.bg) = problem.bgc;
+    /// Return the indices of the basic variables in x, including the eliminated ones, given those in xbar of the master problem.
+    auto basicVariablesFull(IndicesView ibasicvars, Indices& ibasicvarsfull) const -> IndicesView
+    {
+        ibasicvarsfull.resize(ibasicvars.size() + nf);
+        Index k = 0;
+        for(auto i : ibasicvars)
+            if(i < nxr) ibasicvarsfull[k++] = jx[i];
+        for(auto l = 0; l < nf; ++l)
+            if(kf[l] >= 0) ibasicvarsfull[k++] = jf[l]; // variables determined by a row of Aex are basic
+        return ibasicvarsfull.head(k);
     }
 
-    /// Update the master state object `mstate` with given State object.
-    auto updateMasterState(const State& state) -> void
+    /// Update the master state object `mstate` with given State or StateRef object.
+    template<typename StateType>
+    auto updateMasterState(const StateType& state) -> void
     {
         // Initialize xbar = (x, xbg, xhg)
         mstate.u.x.resize(nxbar);
-        mstate.u.x << state.x, state.xbg, state.xhg;
+        mstate.u.x << state.x(jx), state.xbg, state.xhg;
 
         // Initialize wbar = (ye, yg, ze, zg)
         mstate.u.w.resize(nwbar);
-        mstate.u.w << state.ye, state.yg, state.ze, state.zg;
+        mstate.u.w << state.ye(ie), state.yg, state.ze, state.zg;
 
         // Initialize pbar = p
         mstate.u.p = state.p;
     }
 
-    /// Update the given State object with computed MasterState object `mstate`.
-    auto updateState(State& state) -> void
+    /// Update the given State or StateRef object with computed MasterState object `mstate`.
+    template<typename StateType>
+    auto updateState(const Problem& problem, StateType& state) -> void
     {
-        state.x   = mstate.u.x.head(nx);
-        state.xbg = mstate.u.x.segment(nx, nxbg);
-        state.xhg = mstate.u.x.tail(nxhg);
-        state.ye  = mstate.u.w.head(ny).head(dims.be);
-        state.yg  = mstate.u.w.head(ny).tail(dims.bg);
-        state.ze  = mstate.u.w.tail(nz).head(dims.he);
-        state.zg  = mstate.u.w.tail(nz).tail(dims.hg);
-        state.p   = mstate.u.p;
-        state.s   = mstate.s.head(nx);
-
-        auto const is_xbg_or_xhg = [=](Index i) { return i >= nx; };
+        state.x(jx) = mstate.u.x.head(nxr);
+        state.x(jf) = xf;
+        state.xbg   = mstate.u.x.segment(nxr, nxbg);
+        state.xhg   = mstate.u.x.tail(nxhg);
+        state.ye.fill(0.0); // the removed linear equality constraints have zero Lagrange multipliers
+        state.ye(ie) = mstate.u.w.head(nber);
+        state.yg    = mstate.u.w.segment(nber, dims.bg);
+        state.ze    = mstate.u.w.tail(nz).head(dims.he);
+        state.zg    = mstate.u.w.tail(nz).tail(dims.hg);
+        state.p     = mstate.u.p;
+        state.s(jx) = mstate.s.head(nxr);
+
+        auto const is_xbg_or_xhg = [=](Index i) { return i >= nxr; };
         std::function<Index(IndicesRef)> move_right_xbg_xhg_1 = [=](IndicesRef indices) -> Index { return moveRightIf(indices, is_xbg_or_xhg); };
         std::function<Index(IndicesRef)> move_right_xbg_xhg_2 = [=](IndicesRef indices) -> Index { return indices.size(); };
         auto move_right_xbg_xhg = nxbg + nxhg > 0 ? move_right_xbg_xhg_1 : move_right_xbg_xhg_2;
@@ -319,49 +538,194 @@ struct Solver::Impl
         Index const kb  = move_right_xbg_xhg(mstate.jb);  // Move indices corresponding to variables xbg and xhg to the end of jb.
         Index const kn  = move_right_xbg_xhg(mstate.jn);  // Move indices corresponding to variables xbg and xhg to the end of jn.
 
-        state.js  = mstate.js.head(ks);
-        state.ju  = mstate.ju.head(ku);
-        state.jlu = mstate.jlu.head(klu);
-        state.juu = mstate.juu.head(kuu);
-        state.jb  = mstate.jb.head(kb);
-        state.jn  = mstate.jn.head(kn);
+        if(nf == 0)
+        {
+            state.js  = mstate.js.head(ks);
+            state.ju  = mstate.ju.head(ku);
+            state.jlu = mstate.jlu.head(klu);
+            state.juu = mstate.juu.head(kuu);
+            state.jb  = mstate.jb.head(kb);
+            state.jn  = mstate.jn.head(kn);
+            return;
+        }
+
+        state.js  = jx(mstate.js.head(ks));
+        state.ju  = jx(mstate.ju.head(ku));
+        state.jlu = jx(mstate.jlu.head(klu));
+        state.juu = jx(mstate.juu.head(kuu));
+        state.jb  = jx(mstate.jb.head(kb));
+        state.jn  = jx(mstate.jn.head(kn));
+
+        updateEliminatedVariables(problem, state);
+    }
+
+    /// Update the given State or StateRef object with the stabilities and partitions of the eliminated variables and the Lagrange multipliers of their rows of Aex.
+    template<typename StateType>
+    auto updateEliminatedVariables(const Problem& problem, StateType& state) -> void
+    {
+        const auto& x = state.x;
+        const auto& p = state.p;
+
+        // Evaluate f(x, p) and the Jacobian matrices of h(x, p) at the final state (the functions of the master problem keep their evaluations to themselves)
+        ObjectiveOptions fopts{{false, false, false}, state.jb};
+        ConstraintOptions hopts{{true, false, false}, state.jb};
+        ConstraintOptions vopts{{false, false, false}, state.jb};
+        problem.r(x, p, problem.c, fopts, hopts, vopts);
+        problem.f(fres, x, p, problem.c, fopts);
+        if(dims.he) problem.he(heres, x, p, problem.c, hopts);
+        if(dims.hg) problem.hg(hgres, x, p, problem.c, hopts);
+
+        Indices jfs(nf), jflu(nf), jfuu(nf), jfb(nf), jfn(nf);
+        Index nfs = 0, nflu = 0, nfuu = 0, nfb = 0, nfn = 0;
+
+        // The eliminated variables are processed in reverse order, since the rows of Aex that determined them only contain variables eliminated before
+        for(auto k = nf - 1; k >= 0; --k)
+        {
+            const auto i = kf[k];
+            const auto j = jf[k];
+
+            auto sj = fres.fx[j] + problem.Aex.col(j).dot(state.ye);
+            if(dims.bg) sj += problem.Agx.col(j).dot(state.yg);
+            if(dims.he) sj += heres.ddx.col(j).dot(state.ze);
+            if(dims.hg) sj += hgres.ddx.col(j).dot(state.zg);
+
+            if(i >= 0) // the Lagrange multiplier of the row that determined the variable is such that the variable is stable
+            {
+                state.ye[i] -= sj / problem.Aex(i, j);
+                state.s[j] = 0.0;
+                jfs[nfs++] = j;
+                jfb[nfb++] = j;
+                continue;
+            }
+
+            state.s[j] = sj;
+            jfn[nfn++] = j;
+
+            if(x[j] == problem.xlower[j] && sj > 0.0) jflu[nflu++] = j;
+            else if(x[j] == problem.xupper[j] && sj < 0.0) jfuu[nfuu++] = j;
+            else jfs[nfs++] = j;
+        }
+
+        const auto append = [](auto& indices, IndicesView more)
+        {
+            indices.conservativeResize(indices.size() + more.size());
+            indices.tail(more.size()) = more;
+        };
+
+        append(state.js, jfs.head(nfs));
+        append(state.ju, jflu.head(nflu));
+        append(state.ju, jfuu.head(nfuu));
+        append(state.jlu, jflu.head(nflu));
+        append(state.juu, jfuu.head(nfuu));
+        append(state.jb, jfb.head(nfb));
+        append(state.jn, jfn.head(nfn));
     }
 
-    /// Update the given Sensitivity object with computed MasterSensitivity object `msensitivity`.
-    auto updateSensitivity(Sensitivity& sensitivity) -> void
+    /// Update the given Sensitivity or SensitivityRef object with computed MasterSensitivity object `msensitivity`.
+    template<typename StateType, typename SensitivityType>
+    auto updateSensitivity(const Problem& problem, const StateType& state, SensitivityType& sensitivity) -> void
     {
         sensitivity.resize(dims);
-        sensitivity.xc   = msensitivity.xc.topRows(nx);
+        sensitivity.xc(jx, all) = msensitivity.xc.topRows(nxr);
+        sensitivity.xc(jf, all) = xfc;
         sensitivity.pc   = msensitivity.pc;
-        sensitivity.xbgc = msensitivity.xc.middleRows(nx, nxbg);
+        sensitivity.xbgc = msensitivity.xc.middleRows(nxr, nxbg);
         sensitivity.xhgc = msensitivity.xc.bottomRows(nxhg);
-        sensitivity.yec  = msensitivity.wc.topRows(ny).topRows(dims.be);
-        sensitivity.ygc  = msensitivity.wc.topRows(ny).bottomRows(dims.bg);
+        sensitivity.yec.fill(0.0);
+        sensitivity.yec(ie, all) = msensitivity.wc.topRows(nber);
+        sensitivity.ygc  = msensitivity.wc.middleRows(nber, dims.bg);
         sensitivity.zec  = msensitivity.wc.bottomRows(nz).topRows(dims.he);
         sensitivity.zgc  = msensitivity.wc.bottomRows(nz).bottomRows(dims.hg);
-        sensitivity.sc   = msensitivity.sc.topRows(nx);
+        sensitivity.sc(jx, all) = msensitivity.sc.topRows(nxr);
+
+        if(nf == 0)
+            return;
+
+        auto& xc  = sensitivity.xc;
+        auto& pc  = sensitivity.pc;
+        auto& yec = sensitivity.yec;
+        auto& sc  = sensitivity.sc;
+
+        // Evaluate the derivatives of f(x, p) needed below at the final state
+        ObjectiveOptions fopts{{true, np > 0, true}, state.jb};
+        ConstraintOptions hopts{{false, false, false}, state.jb};
+        ConstraintOptions vopts{{false, false, false}, state.jb};
+        fres.fxx.fill(0.0);
+        problem.r(state.x, state.p, problem.c, fopts, hopts, vopts);
+        problem.f(fres, state.x, state.p, problem.c, fopts);
+
+        // The derivatives of the stabilities of the eliminated variables, processed in reverse order as in updateEliminatedVariables
+        for(auto k = nf - 1; k >= 0; --k)
+        {
+            const auto i = kf[k];
+            const auto j = jf[k];
+
+            Vector sjc = fres.fxc.row(j).transpose() + tr(yec) * problem.Aex.col(j);
+            if(dims.bg) sjc += tr(sensitivity.ygc) * problem.Agx.col(j);
+            if(dims.he) sjc += tr(sensitivity.zec) * heres.ddx.col(j);
+            if(dims.hg) sjc += tr(sensitivity.zgc) * hgres.ddx.col(j);
+
+            if(i >= 0) // the stability of the variable remains zero, so the derivative of the Lagrange multiplier of its row follows
+            {
+                sjc += tr(xc) * fres.fxx.row(j).transpose();
+                if(np) sjc += tr(pc) * fres.fxp.row(j).transpose();
+                yec.row(i) -= sjc.transpose() / problem.Aex(i, j);
+                sc.row(j).fill(0.0);
+            }
+            else sc.row(j) = sjc.transpose();
+        }
     }
 
     /// Solve the optimization problem.
-    auto solve(const Problem& problem, State& state) -> Result
+    template<typename StateType>
+    auto solve(const Problem& problem, StateType& state) -> Result
     {
         updateMasterProblem(problem);
         updateMasterOptions();
         updateMasterState(state);
         const auto result = msolver.solve(mproblem, mstate);
-        updateState(state);
+        updateState(problem, state);
         return result;
     }
 
     /// Solve the optimization problem and compute the sensitivity derivatives at the end.
-    auto solve(const Problem& problem, State& state, Sensitivity& sensitivity) -> Result
+    template<typename StateType, typename SensitivityType>
+    auto solve(const Problem& problem, StateType& state, SensitivityType& sensitivity) -> Result
     {
         updateMasterProblem(problem);
         updateMasterOptions();
         updateMasterState(state);
         const auto result = msolver.solve(mproblem, mstate, msensitivity);
-        updateState(state);
-        updateSensitivity(sensitivity);
+        updateState(problem, state);
+        updateSensitivity(problem, state, sensitivity);
+        return result;
+    }
+
+    /// Start the solution of the optimization problem without performing any iteration.
+    auto begin(const Problem& problem, State& state) -> void
+    {
+        updateMasterProblem(problem);
+        updateMasterOptions();
+        updateMasterState(state);
+        pproblem = &problem;
+        pstate = &state;
+        msolver.begin(mproblem, mstate);
+    }
+
+    /// End the calculation started with begin.
+    auto finish() -> Result
+    {
+        const auto result = msolver.finish();
+        updateState(*pproblem, *pstate);
+        return result;
+    }
+
+    /// End the calculation started with begin and compute the sensitivity derivatives.
+    auto finish(Sensitivity& sensitivity) -> Result
+    {
+        const auto result = msolver.finish(msensitivity);
+        updateState(*pproblem, *pstate);
+        updateSensitivity(*pproblem, *pstate, sensitivity);
         return result;
     }
 };
@@ -398,4 +762,39 @@ auto Solver::solve(const Problem& problem, State& state, Sensitivity& sensitivit
     return pimpl->solve(problem, state, sensitivity);
 }
 
+auto Solver::solve(const Problem& problem, StateRef state) -> Result
+{
+    return pimpl->solve(problem, state);
+}
+
+auto Solver::solve(const Problem& problem, StateRef state, SensitivityRef sensitivity) -> Result
+{
+    return pimpl->solve(problem, state, sensitivity);
+}
+
+auto Solver::begin(const Problem& problem, State& state) -> void
+{
+    pimpl->begin(problem, state);
+}
+
+auto Solver::step() -> bool
+{
+    return pimpl->msolver.step();
+}
+
+auto Solver::converged() const -> bool
+{
+    return pimpl->msolver.converged();
+}
+
+auto Solver::finish() -> Result
+{
+    return pimpl->finish();
+}
+
+auto Solver::finish(Sensitivity& sensitivity) -> Result
+{
+    return pimpl->finish(sensitivity);
+}
+
 } // namespace Optima
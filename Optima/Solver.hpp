@@ -30,7 +30,9 @@ class Options;
 class Problem;
 class Result;
 class Sensitivity;
+class SensitivityRef;
 class State;
+class StateRef;
 struct Dims;
 
 /// The solver for optimization problems.
@@ -58,6 +60,30 @@ public:
     /// Solve the optimization problem and compute the sensitivity derivatives at the end.
     auto solve(const Problem& problem, State& state, Sensitivity& sensitivity) -> Result;
 
+    /// Solve the optimization problem reading from and writing to a cell of a StateBatch object directly.
+    auto solve(const Problem& problem, StateRef state) -> Result;
+
+    /// Solve the optimization problem reading from and writing to cells of StateBatch and SensitivityBatch objects directly.
+    auto solve(const Problem& problem, StateRef state, SensitivityRef sensitivity) -> Result;
+
+    /// Start the solution of the optimization problem without performing any iteration.
+    /// The calculation is then advanced one iteration at a time with @ref step and ended with @ref finish
+    /// (see MasterSolver::begin). The problem and state must outlive the calculation.
+    auto begin(const Problem& problem, State& state) -> void;
+
+    /// Perform one iteration of the calculation started with @ref begin.
+    /// @return Return `true` if further iterations are needed, or `false` if the calculation has converged or failed.
+    auto step() -> bool;
+
+    /// Return `true` if the calculation started with @ref begin has converged.
+    auto converged() const -> bool;
+
+    /// End the calculation started with @ref begin and update its state.
+    auto finish() -> Result;
+
+    /// End the calculation started with @ref begin, update its state, and compute the sensitivity derivatives.
+    auto finish(Sensitivity& sensitivity) -> Result;
+
 private:
     struct Impl;
 
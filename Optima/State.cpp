@@ -35,6 +35,8 @@ State::State(const Dims& dims)
   xhg(zeros(dims.hg))
 {}
 
+State::State(const State& other) = default;
+
 auto State::operator=(const State& other) -> State&
 {
     const_cast<Dims&>(dims) = other.dims;
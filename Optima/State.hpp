@@ -51,6 +51,9 @@ public:
     /// Construct a State object with given dimensions.
     explicit State(const Dims& dims);
 
+    /// Construct a copy of a State object.
+    State(const State& other);
+
     /// Assign a State instance to this.
     auto operator=(const State& other) -> State&;
 };
@@ -0,0 +1,295 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "StateBatch.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <array>
+
+// Optima includes
+#include <Optima/BatchStorage.hpp>
+#include <Optima/State.hpp>
+
+namespace Optima {
+namespace {
+
+/// The number of entries in the header of the buffer of a StateBatch object (the dimensions and the number of cells).
+const Index nheader = 8;
+
+/// The number of sets of indices in a state.
+const Index nslots = 6;
+
+/// Return the header of the buffer of a StateBatch object.
+auto header(const Dims& dims, Index size) -> std::array<Index, nheader>
+{
+    return { dims.x, dims.p, dims.be, dims.bg, dims.he, dims.hg, dims.c, size };
+}
+
+/// Return the number of bytes in the buffer of a StateBatch object.
+auto bytes(const Dims& dims, Index size) -> std::size_t
+{
+    const auto ndoubles = 2*dims.x + dims.p + dims.be + 2*dims.bg + dims.he + 2*dims.hg;
+    const auto nindices = nslots*dims.x + nslots;
+    return nheader*sizeof(Index) + size*(ndoubles*sizeof(double) + nindices*sizeof(Index));
+}
+
+} // namespace
+
+StateRef::StateRef(const Dims& dims, VectorRef x, VectorRef p, VectorRef ye, VectorRef yg, VectorRef ze, VectorRef zg, VectorRef s, VectorRef xbg, VectorRef xhg,
+    IndicesSlot js, IndicesSlot ju, IndicesSlot jlu, IndicesSlot juu, IndicesSlot jb, IndicesSlot jn)
+: dims(dims), x(x), p(p), ye(ye), yg(yg), ze(ze), zg(zg), s(s), xbg(xbg), xhg(xhg),
+  js(js), ju(ju), jlu(jlu), juu(juu), jb(jb), jn(jn)
+{}
+
+auto StateRef::operator=(const State& other) -> StateRef&
+{
+    errorif(header(dims, 0) != header(other.dims, 0), "Cannot assign a State object to a cell of a StateBatch object with different dimensions.");
+    x = other.x;
+    p = other.p;
+    ye = other.ye;
+    yg = other.yg;
+    ze = other.ze;
+    zg = other.zg;
+    s = other.s;
+    xbg = other.xbg;
+    xhg = other.xhg;
+    js = other.js;
+    ju = other.ju;
+    jlu = other.jlu;
+    juu = other.juu;
+    jb = other.jb;
+    jn = other.jn;
+    return *this;
+}
+
+auto StateRef::state() const -> State
+{
+    State res(dims);
+    res.x.__assign(x);
+    res.p.__assign(p);
+    res.ye.__assign(ye);
+    res.yg.__assign(yg);
+    res.ze.__assign(ze);
+    res.zg.__assign(zg);
+    res.s.__assign(s);
+    res.xbg.__assign(xbg);
+    res.xhg.__assign(xhg);
+    res.js = js.view();
+    res.ju = ju.view();
+    res.jlu = jlu.view();
+    res.juu = juu.view();
+    res.jb = jb.view();
+    res.jn = jn.view();
+    return res;
+}
+
+struct StateBatch::Impl
+{
+    Dims dims;              ///< The dimensions of the variables and constraints in the optimization problems.
+    Index size = 0;         ///< The number of cells in the batch.
+    BatchStorage storage;   ///< The buffer where the header and all fields are stored.
+    double* x   = nullptr;  ///< The beginning of the variables *x* of all cells.
+    double* p   = nullptr;  ///< The beginning of the parameter variables *p* of all cells.
+    double* ye  = nullptr;  ///< The beginning of the Lagrange multipliers *ye* of all cells.
+    double* yg  = nullptr;  ///< The beginning of the Lagrange multipliers *yg* of all cells.
+    double* ze  = nullptr;  ///< The beginning of the Lagrange multipliers *ze* of all cells.
+    double* zg  = nullptr;  ///< The beginning of the Lagrange multipliers *zg* of all cells.
+    double* s   = nullptr;  ///< The beginning of the stability measures *s* of all cells.
+    double* xbg = nullptr;  ///< The beginning of the variables *xbg* of all cells.
+    double* xhg = nullptr;  ///< The beginning of the variables *xhg* of all cells.
+    Index* slots[nslots];   ///< The beginning of the slots of the sets of indices *js*, *ju*, *jlu*, *juu*, *jb*, *jn* of all cells.
+    Index* counts = nullptr; ///< The beginning of the sizes of the sets of indices of all cells.
+
+    Impl()
+    {
+        setup();
+    }
+
+    Impl(const Dims& dims, Index size)
+    : dims(dims), size(size), storage(bytes(dims, size))
+    {
+        setup();
+    }
+
+    Impl(const Dims& dims, Index size, const std::string& filename)
+    : dims(dims), size(size), storage(bytes(dims, size), filename)
+    {
+        setup();
+    }
+
+    Impl(const Impl& other)
+    : dims(other.dims), size(other.size), storage(other.storage)
+    {
+        setup();
+    }
+
+    /// Initialize or check the header of the buffer and the pointers to the fields.
+    auto setup() -> void
+    {
+        if(storage.bytes() == 0)
+            return;
+
+        const auto expected = header(dims, size);
+
+        auto head = reinterpret_cast<Index*>(storage.data());
+        if(std::all_of(head, head + nheader, [](Index i) { return i == 0; })) // a new buffer
+            std::copy(expected.begin(), expected.end(), head);
+        errorif(!std::equal(expected.begin(), expected.end(), head),
+            "Expecting a StateBatch buffer with the given dimensions and number of cells, but the existing one has different ones.");
+
+        x   = reinterpret_cast<double*>(head + nheader);
+        p   = x   + size*dims.x;
+        ye  = p   + size*dims.p;
+        yg  = ye  + size*dims.be;
+        ze  = yg  + size*dims.bg;
+        zg  = ze  + size*dims.he;
+        s   = zg  + size*dims.hg;
+        xbg = s   + size*dims.x;
+        xhg = xbg + size*dims.bg;
+
+        auto indices = reinterpret_cast<Index*>(xhg + size*dims.hg);
+        for(auto k = 0; k < nslots; ++k)
+            slots[k] = indices + k*size*dims.x;
+        counts = indices + nslots*size*dims.x;
+    }
+
+    auto cell(Index i) -> StateRef
+    {
+        errorif(i < 0 || i >= size, "Expecting a cell index in [0, ", size, ") in StateBatch, but got ", i, ".");
+
+        auto vec = [&](double* data, Index n) -> VectorRef { return Eigen::Map<Vector>(data + i*n, n); };
+        auto slot = [&](Index k) { return IndicesSlot(Eigen::Map<Indices>(slots[k] + i*dims.x, dims.x), counts[i*nslots + k]); };
+
+        return StateRef(dims,
+            vec(x, dims.x), vec(p, dims.p), vec(ye, dims.be), vec(yg, dims.bg), vec(ze, dims.he), vec(zg, dims.hg),
+            vec(s, dims.x), vec(xbg, dims.bg), vec(xhg, dims.hg),
+            slot(0), slot(1), slot(2), slot(3), slot(4), slot(5));
+    }
+
+    auto field(double* data, Index n) -> MatrixRef
+    {
+        return Eigen::Map<Matrix>(data, n, size);
+    }
+};
+
+StateBatch::StateBatch()
+: pimpl(new Impl())
+{}
+
+StateBatch::StateBatch(const Dims& dims, Index size)
+: pimpl(new Impl(dims, size))
+{}
+
+StateBatch::StateBatch(const Dims& dims, Index size, const std::string& filename)
+: pimpl(new Impl(dims, size, filename))
+{}
+
+StateBatch::StateBatch(const StateBatch& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+StateBatch::~StateBatch()
+{}
+
+auto StateBatch::operator=(StateBatch other) -> StateBatch&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto StateBatch::dims() const -> const Dims&
+{
+    return pimpl->dims;
+}
+
+auto StateBatch::size() const -> Index
+{
+    return pimpl->size;
+}
+
+auto StateBatch::operator[](Index i) -> StateRef
+{
+    return pimpl->cell(i);
+}
+
+auto StateBatch::state(Index i) const -> State
+{
+    return pimpl->cell(i).state();
+}
+
+auto StateBatch::x() -> MatrixRef
+{
+    return pimpl->field(pimpl->x, pimpl->dims.x);
+}
+
+auto StateBatch::p() -> MatrixRef
+{
+    return pimpl->field(pimpl->p, pimpl->dims.p);
+}
+
+auto StateBatch::ye() -> MatrixRef
+{
+    return pimpl->field(pimpl->ye, pimpl->dims.be);
+}
+
+auto StateBatch::yg() -> MatrixRef
+{
+    return pimpl->field(pimpl->yg, pimpl->dims.bg);
+}
+
+auto StateBatch::ze() -> MatrixRef
+{
+    return pimpl->field(pimpl->ze, pimpl->dims.he);
+}
+
+auto StateBatch::zg() -> MatrixRef
+{
+    return pimpl->field(pimpl->zg, pimpl->dims.hg);
+}
+
+auto StateBatch::s() -> MatrixRef
+{
+    return pimpl->field(pimpl->s, pimpl->dims.x);
+}
+
+auto StateBatch::xbg() -> MatrixRef
+{
+    return pimpl->field(pimpl->xbg, pimpl->dims.bg);
+}
+
+auto StateBatch::xhg() -> MatrixRef
+{
+    return pimpl->field(pimpl->xhg, pimpl->dims.hg);
+}
+
+auto StateBatch::mapped() const -> bool
+{
+    return pimpl->storage.mapped();
+}
+
+auto StateBatch::flush() -> void
+{
+    pimpl->storage.flush();
+}
+
+auto StateBatch::save(const std::string& filename) const -> void
+{
+    pimpl->storage.save(filename);
+}
+
+} // namespace Optima
@@ -0,0 +1,206 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+#include <string>
+
+// Optima includes
+#include <Optima/Dims.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class State;
+
+/// A view to a vector of indices stored in a slot of fixed capacity, whose size can change up to this capacity.
+class IndicesSlot
+{
+public:
+    /// Construct an IndicesSlot object with given slot and reference to its current size.
+    IndicesSlot(IndicesRef slot, Index& count)
+    : slot(slot), count(count) {}
+
+    /// Construct an IndicesSlot object that refers to the same slot as another.
+    IndicesSlot(const IndicesSlot& other) = default;
+
+    /// Assign the indices of another slot to this.
+    auto operator=(const IndicesSlot& other) -> IndicesSlot&
+    {
+        return *this = other.view();
+    }
+
+    /// Assign given indices to this slot.
+    template<typename Derived>
+    auto operator=(const Eigen::DenseBase<Derived>& indices) -> IndicesSlot&
+    {
+        conservativeResize(indices.size());
+        slot.head(count) = indices;
+        return *this;
+    }
+
+    /// Change the number of indices in this slot, keeping the current ones.
+    auto conservativeResize(Index size) -> void
+    {
+        errorif(size > slot.size(), "Cannot store ", size, " indices in a slot with capacity ", slot.size(), ".");
+        count = size;
+    }
+
+    /// Return the number of indices in this slot.
+    auto size() const -> Index { return count; }
+
+    /// Return the maximum number of indices in this slot.
+    auto capacity() const -> Index { return slot.size(); }
+
+    /// Return the last `n` indices in this slot.
+    auto tail(Index n) { return slot.segment(count - n, n); }
+
+    /// Return the indices in this slot.
+    auto view() const -> IndicesView { return slot.head(count); }
+
+    /// Convert this slot to its indices.
+    operator IndicesView() const { return view(); }
+
+private:
+    /// The slot where the indices are stored.
+    IndicesRef slot;
+
+    /// The number of indices in the slot.
+    Index& count;
+};
+
+/// A view to the state of the optimization variables stored in a cell of a StateBatch object.
+/// @see State
+class StateRef
+{
+public:
+    Dims const dims;     ///< The dimensions of the variables and constraints in the optimization problem.
+    VectorRef x;         ///< The variables \eq{x} of the optimization problem.
+    VectorRef p;         ///< The parameter variables \eq{p} of the optimization problem.
+    VectorRef ye;        ///< The Lagrange multipliers \eq{y_{\mathrm{e}} with respect to constraints \eq{A_{\mathrm{ex}}x+A_{\mathrm{ep}}p=b_{\mathrm{e}}}.
+    VectorRef yg;        ///< The Lagrange multipliers \eq{y_{\mathrm{g}} with respect to constraints \eq{A_{\mathrm{gx}}x+A_{\mathrm{gp}}p\geq b_{\mathrm{g}}}.
+    VectorRef ze;        ///< The Lagrange multipliers \eq{z_{\mathrm{e}} with respect to constraints \eq{h_{\mathrm{e}}(x)=0}.
+    VectorRef zg;        ///< The Lagrange multipliers \eq{z_{\mathrm{g}} with respect to constraints \eq{h_{\mathrm{g}}(x)\geq0}.
+    VectorRef s;         ///< The stability measures of variables \eq{x}.
+    VectorRef xbg;       ///< The variables \eq{x_{b_{\mathrm{g}}}} in \eq{(x,x_{\mathrm{b_{g}}},x_{\mathrm{h_{g}}})} of the basic optimization problem.
+    VectorRef xhg;       ///< The variables \eq{x_{h_{\mathrm{g}}}} in \eq{(x,x_{\mathrm{b_{g}}},x_{\mathrm{h_{g}}})} of the basic optimization problem.
+    IndicesSlot js;      ///< The indices of the stable variables in *x*.
+    IndicesSlot ju;      ///< The indices of the unstable variables in *x*.
+    IndicesSlot jlu;     ///< The indices of the lower unstable variables in *x*.
+    IndicesSlot juu;     ///< The indices of the upper unstable variables in *x*.
+    IndicesSlot jb;      ///< The indices of the basic variables in *x*.
+    IndicesSlot jn;      ///< The indices of the non-basic variables in *x*.
+
+    /// Construct a StateRef object with given dimensions and views to the fields of the state.
+    StateRef(const Dims& dims, VectorRef x, VectorRef p, VectorRef ye, VectorRef yg, VectorRef ze, VectorRef zg, VectorRef s, VectorRef xbg, VectorRef xhg,
+        IndicesSlot js, IndicesSlot ju, IndicesSlot jlu, IndicesSlot juu, IndicesSlot jb, IndicesSlot jn);
+
+    /// Assign a State instance to this.
+    auto operator=(const State& other) -> StateRef&;
+
+    /// Return a copy of the state in this view as a State object.
+    auto state() const -> State;
+};
+
+/// Used to store the states of the optimization variables of many cells in structure-of-arrays layout.
+/// Each field of the state (e.g., *x*, *ye*, *js*) is stored for all cells in a contiguous array, with
+/// the entries of each cell contiguous, so that the state of a cell is viewed without copies (see
+/// StateRef) and the field of all cells is viewed as a matrix with one column per cell. The sets of
+/// indices (e.g., *js*, *jb*) are stored in slots with capacity *nx* together with their sizes. All
+/// fields are stored in a single buffer, in memory or in a memory-mapped file (see BatchStorage).
+class StateBatch
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a default StateBatch object.
+    StateBatch();
+
+    /// Construct a StateBatch object in memory with given dimensions and number of cells.
+    StateBatch(const Dims& dims, Index size);
+
+    /// Construct a StateBatch object backed by a memory-mapped file with given dimensions and number of cells.
+    /// The contents of an existing file (e.g., created with @ref save) are kept if they correspond to the given dimensions and number of cells.
+    StateBatch(const Dims& dims, Index size, const std::string& filename);
+
+    /// Construct a copy of a StateBatch object (the copy is always in memory).
+    StateBatch(const StateBatch& other);
+
+    /// Destroy this StateBatch object.
+    virtual ~StateBatch();
+
+    /// Assign a StateBatch object to this.
+    auto operator=(StateBatch other) -> StateBatch&;
+
+    /// Return the dimensions of the variables and constraints in the optimization problems.
+    auto dims() const -> const Dims&;
+
+    /// Return the number of cells in this batch.
+    auto size() const -> Index;
+
+    /// Return a view to the state of the cell with given index.
+    auto operator[](Index i) -> StateRef;
+
+    /// Return a copy of the state of the cell with given index as a State object.
+    auto state(Index i) const -> State;
+
+    /// Return the variables *x* of all cells with dimensions *nx* by *size*.
+    auto x() -> MatrixRef;
+
+    /// Return the parameter variables *p* of all cells with dimensions *np* by *size*.
+    auto p() -> MatrixRef;
+
+    /// Return the Lagrange multipliers *ye* of all cells with dimensions *nbe* by *size*.
+    auto ye() -> MatrixRef;
+
+    /// Return the Lagrange multipliers *yg* of all cells with dimensions *nbg* by *size*.
+    auto yg() -> MatrixRef;
+
+    /// Return the Lagrange multipliers *ze* of all cells with dimensions *nhe* by *size*.
+    auto ze() -> MatrixRef;
+
+    /// Return the Lagrange multipliers *zg* of all cells with dimensions *nhg* by *size*.
+    auto zg() -> MatrixRef;
+
+    /// Return the stability measures *s* of all cells with dimensions *nx* by *size*.
+    auto s() -> MatrixRef;
+
+    /// Return the variables *xbg* of all cells with dimensions *nbg* by *size*.
+    auto xbg() -> MatrixRef;
+
+    /// Return the variables *xhg* of all cells with dimensions *nhg* by *size*.
+    auto xhg() -> MatrixRef;
+
+    /// Return `true` if this batch is backed by a memory-mapped file.
+    auto mapped() const -> bool;
+
+    /// Write the modified contents of a memory-mapped batch to its file (no effect if in memory).
+    auto flush() -> void;
+
+    /// Save the contents of this batch to a file with a single write, which can be mapped later in memory.
+    auto save(const std::string& filename) const -> void;
+};
+
+} // namespace Optima
@@ -0,0 +1,53 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/BatchLU.hpp>
+using namespace Optima;
+
+void exportBatchLU(py::module& m)
+{
+    auto decompose = [](BatchLU& self, MatrixView4py A)
+    {
+        return self.decompose(A);
+    };
+
+    auto solve1 = [](const BatchLU& self, Eigen::Ref<Eigen::MatrixXd, 0, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>> X)
+    {
+        Matrix Xc = X; // numpy arrays are row-major by default
+        self.solve(Xc);
+        X = Xc;
+    };
+
+    auto solve2 = [](const BatchLU& self, Index k, VectorRef x)
+    {
+        self.solve(k, x);
+    };
+
+    py::class_<BatchLU>(m, "BatchLU")
+        .def(py::init<>())
+        .def("empty", &BatchLU::empty)
+        .def("size", &BatchLU::size)
+        .def("dim", &BatchLU::dim)
+        .def("decompose", decompose)
+        .def("solve", solve1)
+        .def("solve", solve2)
+        ;
+}
@@ -0,0 +1,95 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/BatchSolver.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Sensitivity.hpp>
+#include <Optima/SensitivityBatch.hpp>
+#include <Optima/State.hpp>
+#include <Optima/StateBatch.hpp>
+using namespace Optima;
+
+void exportBatchSolver(py::module& m)
+{
+    // The states are copied back to the given Python objects, and the GIL is released so that
+    // the calculations on worker threads can evaluate the functions of the problems implemented in Python
+    auto solve = [](BatchSolver& self, const std::vector<Problem>& problems, std::vector<State*> pstates)
+    {
+        std::vector<State> states;
+        for(auto pstate : pstates)
+            states.push_back(*pstate);
+        std::vector<Result> results;
+        {
+            py::gil_scoped_release release;
+            results = self.solve(problems, states);
+        }
+        for(auto k = 0U; k < states.size(); ++k)
+            *pstates[k] = states[k];
+        return results;
+    };
+
+    auto solveWithSensitivity = [](BatchSolver& self, const std::vector<Problem>& problems, std::vector<State*> pstates, std::vector<Sensitivity*> psensitivities)
+    {
+        std::vector<State> states;
+        for(auto pstate : pstates)
+            states.push_back(*pstate);
+        std::vector<Sensitivity> sensitivities;
+        for(auto psensitivity : psensitivities)
+            sensitivities.push_back(*psensitivity);
+        std::vector<Result> results;
+        {
+            py::gil_scoped_release release;
+            results = self.solve(problems, states, sensitivities);
+        }
+        for(auto k = 0U; k < states.size(); ++k)
+            *pstates[k] = states[k];
+        for(auto k = 0U; k < sensitivities.size(); ++k)
+            *psensitivities[k] = sensitivities[k];
+        return results;
+    };
+
+    auto solveStateBatch = [](BatchSolver& self, const std::vector<Problem>& problems, StateBatch& states)
+    {
+        py::gil_scoped_release release;
+        return self.solve(problems, states);
+    };
+
+    auto solveStateBatchWithSensitivity = [](BatchSolver& self, const std::vector<Problem>& problems, StateBatch& states, SensitivityBatch& sensitivities)
+    {
+        py::gil_scoped_release release;
+        return self.solve(problems, states, sensitivities);
+    };
+
+    py::class_<BatchSolver>(m, "BatchSolver")
+        .def(py::init<>())
+        .def("setOptions", &BatchSolver::setOptions)
+        .def("setObjectiveFunction", &BatchSolver::setObjectiveFunction)
+        .def("setEqualityConstraintFunction", &BatchSolver::setEqualityConstraintFunction)
+        .def("setInequalityConstraintFunction", &BatchSolver::setInequalityConstraintFunction)
+        .def("setExternalConstraintFunction", &BatchSolver::setExternalConstraintFunction)
+        .def("solve", solve)
+        .def("solve", solveWithSensitivity)
+        .def("solve", solveStateBatch)
+        .def("solve", solveStateBatchWithSensitivity)
+        ;
+}
@@ -38,5 +38,7 @@ void exportCanonicalMatrix(py::module& m)
         .def_readonly("jn"   , &CanonicalMatrix::jn)
         .def_readonly("js"   , &CanonicalMatrix::js)
         .def_readonly("ju"   , &CanonicalMatrix::ju)
+        .def_readonly("isHss4BasicVars", &CanonicalMatrix::isHss4BasicVars)
+        .def_readonly("isHssDiagonal", &CanonicalMatrix::isHssDiagonal)
         ;
 }
@@ -0,0 +1,61 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/ConstraintBatchFunction.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+void exportConstraintBatchFunction(py::module& m)
+{
+    auto get_val = [](ConstraintBatchResult& s) -> MatrixRef { return s.val; };
+    auto get_ddx = [](ConstraintBatchResult& s) -> MatrixRef { return s.ddx; };
+    auto get_ddp = [](ConstraintBatchResult& s) -> MatrixRef { return s.ddp; };
+    auto get_ddc = [](ConstraintBatchResult& s) -> MatrixRef { return s.ddc; };
+
+    auto set_val = [](ConstraintBatchResult& s, MatrixView4py val) { assignOrError(s.val, val); };
+    auto set_ddx = [](ConstraintBatchResult& s, MatrixView4py ddx) { assignOrError(s.ddx, ddx); };
+    auto set_ddp = [](ConstraintBatchResult& s, MatrixView4py ddp) { assignOrError(s.ddp, ddp); };
+    auto set_ddc = [](ConstraintBatchResult& s, MatrixView4py ddc) { assignOrError(s.ddc, ddc); };
+
+    py::class_<ConstraintBatchResult>(m, "ConstraintBatchResult")
+        .def(py::init<>())
+        .def_property("val", get_val, set_val)
+        .def_property("ddx", get_ddx, set_ddx)
+        .def_property("ddp", get_ddp, set_ddp)
+        .def_property("ddc", get_ddc, set_ddc)
+        .def_readwrite("ddx4basicvars", &ConstraintBatchResult::ddx4basicvars)
+        .def_readwrite("succeeded", &ConstraintBatchResult::succeeded)
+        .def("resize", &ConstraintBatchResult::resize)
+        ;
+
+    py::class_<ConstraintBatchOptions>(m, "ConstraintBatchOptions")
+        .def_readonly("eval", &ConstraintBatchOptions::eval, "The constraint function components that need to be evaluated for at least one evaluation in the batch.")
+        .def_readonly("iproblems", &ConstraintBatchOptions::iproblems, "The indices of the problems in the batch solver associated with each evaluation.")
+        .def_readonly("ibasicvars", &ConstraintBatchOptions::ibasicvars, "The indices of the basic variables in x for each evaluation.")
+        ;
+
+    py::class_<ConstraintBatchFunction>(m, "ConstraintBatchFunction")
+        .def(py::init<const ConstraintBatchFunction::Signature&>())
+        .def("initialized", &ConstraintBatchFunction::initialized)
+        ;
+
+    py::implicitly_convertible<ConstraintBatchFunction::Signature, ConstraintBatchFunction>();
+}
@@ -94,6 +94,11 @@ void exportConstraintFunction(py::module& m)
         .def(py::init<const ConstraintFunction::Signature4py&>())
         .def("__call__", &ConstraintFunction::operator())
         .def("initialized", &ConstraintFunction::initialized)
+        .def("setNonZeroColumnsDdx", &ConstraintFunction::setNonZeroColumnsDdx)
+        .def("sparseDdx", &ConstraintFunction::sparseDdx)
+        .def("nonZeroColumnsDdx", &ConstraintFunction::nonZeroColumnsDdx, py::return_value_policy::reference_internal)
+        .def("setConstantDerivatives", &ConstraintFunction::setConstantDerivatives)
+        .def("constantDerivatives", &ConstraintFunction::constantDerivatives)
         ;
 
     py::implicitly_convertible<ConstraintFunction::Signature4py, ConstraintFunction>();
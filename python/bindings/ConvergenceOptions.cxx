@@ -27,5 +27,10 @@ void exportConvergenceOptions(py::module& m)
     py::class_<ConvergenceOptions>(m, "ConvergenceOptions")
         .def(py::init<>())
         .def_readwrite("tolerance", &ConvergenceOptions::tolerance)
+        .def_readwrite("stagnation_iterations", &ConvergenceOptions::stagnation_iterations)
+        .def_readwrite("stagnation_tolerance", &ConvergenceOptions::stagnation_tolerance)
+        .def_readwrite("divergence_factor", &ConvergenceOptions::divergence_factor)
+        .def_readwrite("infeasibility_check", &ConvergenceOptions::infeasibility_check)
+        .def_readwrite("infeasibility_tolerance", &ConvergenceOptions::infeasibility_tolerance)
         ;
 }
@@ -0,0 +1,42 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/Decomposer.hpp>
+using namespace Optima;
+
+void exportDecomposer(py::module& m)
+{
+    py::class_<MasterBlock>(m, "MasterBlock")
+        .def_readonly("jx"     , &MasterBlock::jx)
+        .def_readonly("iy"     , &MasterBlock::iy)
+        .def_readonly("iz"     , &MasterBlock::iz)
+        .def_readonly("problem", &MasterBlock::problem)
+        ;
+
+    py::class_<Decomposer>(m, "Decomposer")
+        .def(py::init<>())
+        .def("setOptions", &Decomposer::setOptions)
+        .def("initialize", &Decomposer::initialize)
+        .def("blocks", &Decomposer::blocks, py::return_value_policy::reference_internal)
+        .def("split", &Decomposer::split)
+        .def("merge", &Decomposer::merge)
+        ;
+}
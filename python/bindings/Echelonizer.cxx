@@ -38,10 +38,12 @@ void exportEchelonizer(py::module& m)
         .def(py::init<>())
         .def(py::init<const Echelonizer&>())
         .def(py::init(init))
+        .def("setOptions", &Echelonizer::setOptions)
         .def("numVariables", &Echelonizer::numVariables)
         .def("numEquations", &Echelonizer::numEquations)
         .def("numBasicVariables", &Echelonizer::numBasicVariables)
         .def("numNonBasicVariables", &Echelonizer::numNonBasicVariables)
+        .def("memoryFootprint", &Echelonizer::memoryFootprint)
         .def("S", &Echelonizer::S, py::return_value_policy::reference_internal)
         .def("R", &Echelonizer::R, py::return_value_policy::reference_internal)
         .def("Q", &Echelonizer::Q, py::return_value_policy::reference_internal)
@@ -34,13 +34,20 @@ void exportEchelonizerExtended(py::module& m)
         return self.updateWithPriorityWeights(J, weights);
     };
 
+    auto updateWithPriorityWeightsSparseJ = [](EchelonizerExtended& self, MatrixView4py J, IndicesView Jcols, VectorView weights)
+    {
+        return self.updateWithPriorityWeights(J, Jcols, weights);
+    };
+
     py::class_<EchelonizerExtended>(m, "EchelonizerExtended")
         .def(py::init<>())
         .def(py::init(init))
+        .def("setOptions", &EchelonizerExtended::setOptions)
         .def("numVariables", &EchelonizerExtended::numVariables)
         .def("numEquations", &EchelonizerExtended::numEquations)
         .def("numBasicVariables", &EchelonizerExtended::numBasicVariables)
         .def("numNonBasicVariables", &EchelonizerExtended::numNonBasicVariables)
+        .def("memoryFootprint", &EchelonizerExtended::memoryFootprint)
         .def("S", &EchelonizerExtended::S, py::return_value_policy::reference_internal)
         .def("R", &EchelonizerExtended::R, py::return_value_policy::reference_internal)
         .def("Q", &EchelonizerExtended::Q, py::return_value_policy::reference_internal)
@@ -48,6 +55,7 @@ void exportEchelonizerExtended(py::module& m)
         .def("indicesBasicVariables", &EchelonizerExtended::indicesBasicVariables, py::return_value_policy::reference_internal)
         .def("indicesNonBasicVariables", &EchelonizerExtended::indicesNonBasicVariables, py::return_value_policy::reference_internal)
         .def("updateWithPriorityWeights", updateWithPriorityWeights)
+        .def("updateWithPriorityWeights", updateWithPriorityWeightsSparseJ)
         .def("updateOrdering", &EchelonizerExtended::updateOrdering)
         .def("cleanResidualRoundoffErrors", &EchelonizerExtended::cleanResidualRoundoffErrors)
         ;
@@ -29,15 +29,29 @@ void exportEchelonizerW(py::module& m)
         self.initialize(dims, Ax, Ap);
     };
 
+    auto initializeSparseJx = [](EchelonizerW& self, const MasterDims& dims, MatrixView4py Ax, MatrixView4py Ap, IndicesView Jxcols)
+    {
+        self.initialize(dims, Ax, Ap, Jxcols);
+    };
+
     auto update = [](EchelonizerW& self, MatrixView4py Jx, MatrixView4py Jp, VectorView weights)
     {
         self.update(Jx, Jp, weights);
     };
 
+    auto updateWithConstantJ = [](EchelonizerW& self, VectorView weights)
+    {
+        self.update(weights);
+    };
+
     py::class_<EchelonizerW>(m, "EchelonizerW")
         .def(py::init<>())
+        .def("setOptions", &EchelonizerW::setOptions)
         .def("initialize", initialize)
+        .def("initialize", initializeSparseJx)
         .def("update", update)
+        .def("update", updateWithConstantJ)
+        .def("memoryFootprint", &EchelonizerW::memoryFootprint)
         .def("W", &EchelonizerW::W, PYBIND_ENSURE_MUTUAL_EXISTENCE)
         .def("RWQ", &EchelonizerW::RWQ, PYBIND_ENSURE_MUTUAL_EXISTENCE)
         ;
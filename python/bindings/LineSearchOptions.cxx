@@ -26,9 +26,12 @@ void exportLineSearchOptions(py::module& m)
 {
     py::class_<LineSearchOptions>(m, "LineSearchOptions")
         .def(py::init<>())
+        .def_readwrite("active", &LineSearchOptions::active)
         .def_readwrite("tolerance", &LineSearchOptions::tolerance)
         .def_readwrite("maxiterations", &LineSearchOptions::maxiterations)
         .def_readwrite("trigger_when_current_error_is_greater_than_initial_error_by_factor", &LineSearchOptions::trigger_when_current_error_is_greater_than_initial_error_by_factor)
         .def_readwrite("trigger_when_current_error_is_greater_than_previous_error_by_factor", &LineSearchOptions::trigger_when_current_error_is_greater_than_previous_error_by_factor)
+        .def_readwrite("parallel_trials", &LineSearchOptions::parallel_trials)
+        .def_readwrite("threadsafe", &LineSearchOptions::threadsafe)
         ;
 }
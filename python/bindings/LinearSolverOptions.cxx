@@ -28,6 +28,7 @@ void exportLinearSolverOptions(py::module& m)
         .value("Fullspace", LinearSolverMethod::Fullspace)
         .value("Nullspace", LinearSolverMethod::Nullspace)
         .value("Rangespace", LinearSolverMethod::Rangespace)
+        .value("SparseFullspace", LinearSolverMethod::SparseFullspace)
         ;
 
     py::class_<LinearSolverOptions>(m, "LinearSolverOptions")
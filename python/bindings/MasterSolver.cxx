@@ -24,10 +24,17 @@ using namespace Optima;
 
 void exportMasterSolver(py::module& m)
 {
+    // The GIL is released during the calculations, so that the functions of the problem implemented in
+    // Python can be evaluated on worker threads (e.g., when the blocks of a decomposed problem are solved concurrently)
     py::class_<MasterSolver>(m, "MasterSolver")
         .def(py::init<>())
         .def("setOptions", &MasterSolver::setOptions)
-        .def("solve", py::overload_cast<const MasterProblem&, MasterState&>(&MasterSolver::solve))
-        .def("solve", py::overload_cast<const MasterProblem&, MasterState&, MasterSensitivity&>(&MasterSolver::solve))
+        .def("solve", py::overload_cast<const MasterProblem&, MasterState&>(&MasterSolver::solve), py::call_guard<py::gil_scoped_release>())
+        .def("solve", py::overload_cast<const MasterProblem&, MasterState&, MasterSensitivity&>(&MasterSolver::solve), py::call_guard<py::gil_scoped_release>())
+        .def("begin", &MasterSolver::begin, py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), py::call_guard<py::gil_scoped_release>())
+        .def("step", &MasterSolver::step, py::call_guard<py::gil_scoped_release>())
+        .def("converged", &MasterSolver::converged)
+        .def("finish", py::overload_cast<>(&MasterSolver::finish), py::call_guard<py::gil_scoped_release>())
+        .def("finish", py::overload_cast<MasterSensitivity&>(&MasterSolver::finish), py::call_guard<py::gil_scoped_release>())
         ;
 }
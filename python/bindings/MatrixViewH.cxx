@@ -28,8 +28,12 @@ void exportMatrixViewH(py::module& m)
         .def(py::init<MatrixView4py, MatrixView4py, bool>(),
             keep_argument_alive<0>(),
             keep_argument_alive<1>())
-        .def_readonly("Hxx"      , &MatrixViewH::Hxx)
-        .def_readonly("Hxp"      , &MatrixViewH::Hxp)
-        .def_readonly("isHxxDiag", &MatrixViewH::isHxxDiag)
+        .def(py::init<MatrixView4py, MatrixView4py, bool, bool>(),
+            keep_argument_alive<0>(),
+            keep_argument_alive<1>())
+        .def_readonly("Hxx"            , &MatrixViewH::Hxx)
+        .def_readonly("Hxp"            , &MatrixViewH::Hxp)
+        .def_readonly("isHxxDiag"      , &MatrixViewH::isHxxDiag)
+        .def_readonly("isHxx4BasicVars", &MatrixViewH::isHxx4BasicVars)
         ;
 }
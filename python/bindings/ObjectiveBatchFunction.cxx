@@ -0,0 +1,65 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/ObjectiveBatchFunction.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+void exportObjectiveBatchFunction(py::module& m)
+{
+    auto get_f   = [](ObjectiveBatchResult& s) -> VectorRef { return s.f; };
+    auto get_fx  = [](ObjectiveBatchResult& s) -> MatrixRef { return s.fx; };
+    auto get_fxx = [](ObjectiveBatchResult& s) -> MatrixRef { return s.fxx; };
+    auto get_fxp = [](ObjectiveBatchResult& s) -> MatrixRef { return s.fxp; };
+    auto get_fxc = [](ObjectiveBatchResult& s) -> MatrixRef { return s.fxc; };
+
+    auto set_f   = [](ObjectiveBatchResult& s, VectorView f)       { assignOrError(s.f, f); };
+    auto set_fx  = [](ObjectiveBatchResult& s, MatrixView4py fx)  { assignOrError(s.fx, fx); };
+    auto set_fxx = [](ObjectiveBatchResult& s, MatrixView4py fxx) { assignOrError(s.fxx, fxx); };
+    auto set_fxp = [](ObjectiveBatchResult& s, MatrixView4py fxp) { assignOrError(s.fxp, fxp); };
+    auto set_fxc = [](ObjectiveBatchResult& s, MatrixView4py fxc) { assignOrError(s.fxc, fxc); };
+
+    py::class_<ObjectiveBatchResult>(m, "ObjectiveBatchResult")
+        .def(py::init<>())
+        .def_property("f", get_f, set_f)
+        .def_property("fx", get_fx, set_fx)
+        .def_property("fxx", get_fxx, set_fxx)
+        .def_property("fxp", get_fxp, set_fxp)
+        .def_property("fxc", get_fxc, set_fxc)
+        .def_readwrite("diagfxx", &ObjectiveBatchResult::diagfxx)
+        .def_readwrite("fxx4basicvars", &ObjectiveBatchResult::fxx4basicvars)
+        .def_readwrite("succeeded", &ObjectiveBatchResult::succeeded)
+        .def("resize", &ObjectiveBatchResult::resize)
+        ;
+
+    py::class_<ObjectiveBatchOptions>(m, "ObjectiveBatchOptions")
+        .def_readonly("eval", &ObjectiveBatchOptions::eval, "The objective function components that need to be evaluated for at least one evaluation in the batch.")
+        .def_readonly("iproblems", &ObjectiveBatchOptions::iproblems, "The indices of the problems in the batch solver associated with each evaluation.")
+        .def_readonly("ibasicvars", &ObjectiveBatchOptions::ibasicvars, "The indices of the basic variables in x for each evaluation.")
+        ;
+
+    py::class_<ObjectiveBatchFunction>(m, "ObjectiveBatchFunction")
+        .def(py::init<const ObjectiveBatchFunction::Signature&>())
+        .def("initialized", &ObjectiveBatchFunction::initialized)
+        ;
+
+    py::implicitly_convertible<ObjectiveBatchFunction::Signature, ObjectiveBatchFunction>();
+}
@@ -102,6 +102,11 @@ void exportObjectiveFunction(py::module& m)
         .def(py::init<const ObjectiveFunction::Signature4py&>())
         .def("__call__", &ObjectiveFunction::operator())
         .def("initialized", &ObjectiveFunction::initialized)
+        .def("setConstantHessian", &ObjectiveFunction::setConstantHessian)
+        .def("constantHessian", &ObjectiveFunction::constantHessian)
+        .def("setBlocksHessian", &ObjectiveFunction::setBlocksHessian)
+        .def("blockDiagonalHessian", &ObjectiveFunction::blockDiagonalHessian)
+        .def("blocksHessian", &ObjectiveFunction::blocksHessian, py::return_value_policy::reference_internal)
         ;
 
     py::implicitly_convertible<ObjectiveFunction::Signature4py, ObjectiveFunction>();
@@ -20,18 +20,26 @@
 
 void exportEigen(py::module& m);
 void exportBacktrackSearchOptions(py::module& m);
+void exportBatchLU(py::module& m);
+void exportBatchOptions(py::module& m);
+void exportBatchSolver(py::module& m);
 void exportConstants(py::module& m);
+void exportCancellationToken(py::module& m);
 void exportConvergenceOptions(py::module& m);
 void exportCanonicalDims(py::module& m);
 void exportCanonicalizer(py::module& m);
 void exportCanonicalMatrix(py::module& m);
 void exportCanonicalVector(py::module& m);
 void exportErrorStatusOptions(py::module& m);
+void exportConstraintBatchFunction(py::module& m);
 void exportConstraintFunction(py::module& m);
+void exportDecomposer(py::module& m);
+void exportDecomposerOptions(py::module& m);
 void exportDims(py::module& m);
 void exportEchelonizer(py::module& m);
 void exportEchelonizerExtended(py::module& m);
 void exportEchelonizerW(py::module& m);
+void exportEchelonizerOptions(py::module& m);
 void exportIndex(py::module& m);
 void exportIndexUtils(py::module& m);
 void exportLineSearchOptions(py::module& m);
@@ -52,20 +60,28 @@ void exportMatrixViewV(py::module& m);
 void exportMatrixViewW(py::module& m);
 void exportNewtonStep(py::module& m);
 void exportNewtonStepOptions(py::module& m);
+void exportObjectiveBatchFunction(py::module& m);
 void exportObjectiveFunction(py::module& m);
 void exportOutputter(py::module& m);
 void exportOptions(py::module& m);
+void exportPresolver(py::module& m);
+void exportPresolverOptions(py::module& m);
 void exportProblem(py::module& m);
 void exportResidualFunction(py::module& m);
+void exportResidualFunctionOptions(py::module& m);
 void exportResidualVector(py::module& m);
 void exportResourcesFunction(py::module& m);
 void exportResult(py::module& m);
+void exportScaler(py::module& m);
+void exportScalerOptions(py::module& m);
 void exportSensitivity(py::module& m);
+void exportSensitivityBatch(py::module& m);
 void exportSensitivitySolver(py::module& m);
 void exportSolver(py::module& m);
 void exportStablePartition(py::module& m);
 void exportStability(py::module& m);
 void exportState(py::module& m);
+void exportStateBatch(py::module& m);
 void exportTiming(py::module& m);
 void exportUtils(py::module& m);
 
@@ -73,7 +89,9 @@ PYBIND11_MODULE(optima4py, m)
 {
     exportEigen(m);
     exportBacktrackSearchOptions(m);
+    exportBatchOptions(m);
     exportConstants(m);
+    exportCancellationToken(m);
     exportConvergenceOptions(m);
     exportCanonicalDims(m);
     exportCanonicalizer(m);
@@ -81,7 +99,11 @@ PYBIND11_MODULE(optima4py, m)
     exportCanonicalVector(m);
     exportErrorStatusOptions(m);
     exportConstraintFunction(m);
+    exportConstraintBatchFunction(m);
+    exportDecomposerOptions(m);
+    exportDecomposer(m);
     exportDims(m);
+    exportEchelonizerOptions(m);
     exportEchelonizer(m);
     exportEchelonizerExtended(m);
     exportEchelonizerW(m);
@@ -91,6 +113,7 @@ PYBIND11_MODULE(optima4py, m)
     exportLinearSolver(m);
     exportLinearSolverOptions(m);
     exportLU(m);
+    exportBatchLU(m);
     exportMasterDims(m);
     exportMasterProblem(m);
     exportMasterSensitivity(m);
@@ -106,19 +129,28 @@ PYBIND11_MODULE(optima4py, m)
     exportNewtonStep(m);
     exportNewtonStepOptions(m);
     exportObjectiveFunction(m);
+    exportObjectiveBatchFunction(m);
     exportOutputter(m);
     exportOptions(m);
+    exportPresolverOptions(m);
+    exportPresolver(m);
     exportProblem(m);
+    exportResidualFunctionOptions(m);
     exportResidualFunction(m);
     exportResidualVector(m);
     exportResourcesFunction(m);
     exportResult(m);
+    exportScalerOptions(m);
+    exportScaler(m);
     exportSensitivity(m);
+    exportSensitivityBatch(m);
     exportSensitivitySolver(m);
     exportSolver(m);
+    exportBatchSolver(m);
     exportStablePartition(m);
     exportStability(m);
     exportState(m);
+    exportStateBatch(m);
     exportTiming(m);
     exportUtils(m);
 }
@@ -43,11 +43,18 @@ void exportOptions(py::module& m)
         .def(py::init<>())
         .def_readwrite("output"         , &Options::output         , "The options for the output of the optimization calculations")
         .def_readwrite("maxiters"       , &Options::maxiters       , "The maximum number of iterations in the optimization calculations.")
+        .def_readwrite("timeout"        , &Options::timeout        , "The maximum wall time of the optimization calculations (in unit of s, disabled if zero).")
+        .def_readwrite("cancellation"   , &Options::cancellation   , "The token used to cancel the optimization calculations from elsewhere (e.g., another thread).")
         .def_readwrite("errorstatus"    , &Options::errorstatus    , "The options for assessing error status.")
         .def_readwrite("backtracksearch", &Options::backtracksearch, "The options for the backtrack search operation.")
         .def_readwrite("linesearch"     , &Options::linesearch     , "The options for the linear search minimization operation.")
         .def_readwrite("steepestdescent", &Options::steepestdescent, "The options for the steepest descent step operation when needed.")
         .def_readwrite("newtonstep"     , &Options::newtonstep     , "The options used for Newton step calculations.")
         .def_readwrite("convergence"    , &Options::convergence    , "The options used for convergence analysis.")
+        .def_readwrite("residualfunction", &Options::residualfunction, "The options used for residual function evaluations.")
+        .def_readwrite("presolver"      , &Options::presolver      , "The options used for the presolve stage that reduces the optimization problem before it is solved.")
+        .def_readwrite("scaler"         , &Options::scaler         , "The options used for the scaling of the master optimization problem before it is solved.")
+        .def_readwrite("decomposer"     , &Options::decomposer     , "The options used for the decomposition of the master optimization problem into independent blocks solved separately.")
+        .def_readwrite("batch"          , &Options::batch          , "The options used for the solution of batches of optimization problems with BatchSolver.")
         ;
 }
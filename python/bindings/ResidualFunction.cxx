@@ -46,6 +46,7 @@ void exportResidualFunction(py::module& m)
 
     py::class_<ResidualFunction>(m, "ResidualFunction")
         .def(py::init<>())
+        .def("setOptions"                  , &ResidualFunction::setOptions)
         .def("initialize"                  , &ResidualFunction::initialize)
         .def("update"                      , &ResidualFunction::update)
         .def("updateSkipJacobian"          , &ResidualFunction::updateSkipJacobian)
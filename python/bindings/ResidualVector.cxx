@@ -37,12 +37,16 @@ void exportResidualVector(py::module& m)
         VectorView b,
         VectorView h)
     {
-        self.update({Mc, Wx, Wp, x, p, y, z, g, v, b, h});
+        Vector w(y.size() + z.size());
+        w << y, z;
+        const Vector s = g + Wx.transpose()*w;
+        self.update({Mc, Wx, Wp, x, p, y, z, g, v, b, h, s});
     };
 
     py::class_<ResidualVector>(m, "ResidualVector")
         .def(py::init<>())
         .def(py::init<const ResidualVector&>())
+        .def("setNonZeroColumnsJx", &ResidualVector::setNonZeroColumnsJx)
         .def("update", update)
         .def("masterVector", &ResidualVector::masterVector, PYBIND_ENSURE_MUTUAL_EXISTENCE)
         .def("canonicalVector", &ResidualVector::canonicalVector, PYBIND_ENSURE_MUTUAL_EXISTENCE)
@@ -0,0 +1,40 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/Scaler.hpp>
+using namespace Optima;
+
+void exportScaler(py::module& m)
+{
+    py::class_<Scaler>(m, "Scaler")
+        .def(py::init<>())
+        .def("setOptions", &Scaler::setOptions)
+        .def("initialize", &Scaler::initialize, py::keep_alive<1, 2>())
+        .def("scaled", &Scaler::scaled)
+        .def("problem", &Scaler::problem, py::return_value_policy::reference_internal)
+        .def("dx", &Scaler::dx, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("dw", &Scaler::dw, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("scale", &Scaler::scale)
+        .def("unscale", py::overload_cast<MasterVectorRef>(&Scaler::unscale, py::const_))
+        .def("unscale", py::overload_cast<MasterState&>(&Scaler::unscale, py::const_))
+        .def("unscale", py::overload_cast<MasterSensitivity&>(&Scaler::unscale, py::const_))
+        ;
+}
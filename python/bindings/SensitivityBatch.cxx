@@ -0,0 +1,88 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/Sensitivity.hpp>
+#include <Optima/SensitivityBatch.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+void exportSensitivityBatch(py::module& m)
+{
+    auto get_xc   = [](SensitivityRef& s) -> MatrixRef { return s.xc; };
+    auto get_pc   = [](SensitivityRef& s) -> MatrixRef { return s.pc; };
+    auto get_yec  = [](SensitivityRef& s) -> MatrixRef { return s.yec; };
+    auto get_ygc  = [](SensitivityRef& s) -> MatrixRef { return s.ygc; };
+    auto get_zec  = [](SensitivityRef& s) -> MatrixRef { return s.zec; };
+    auto get_zgc  = [](SensitivityRef& s) -> MatrixRef { return s.zgc; };
+    auto get_sc   = [](SensitivityRef& s) -> MatrixRef { return s.sc; };
+    auto get_xbgc = [](SensitivityRef& s) -> MatrixRef { return s.xbgc; };
+    auto get_xhgc = [](SensitivityRef& s) -> MatrixRef { return s.xhgc; };
+
+    auto set_xc   = [](SensitivityRef& s, MatrixView4py xc)   { assignOrError(s.xc, xc); };
+    auto set_pc   = [](SensitivityRef& s, MatrixView4py pc)   { assignOrError(s.pc, pc); };
+    auto set_yec  = [](SensitivityRef& s, MatrixView4py yec)  { assignOrError(s.yec, yec); };
+    auto set_ygc  = [](SensitivityRef& s, MatrixView4py ygc)  { assignOrError(s.ygc, ygc); };
+    auto set_zec  = [](SensitivityRef& s, MatrixView4py zec)  { assignOrError(s.zec, zec); };
+    auto set_zgc  = [](SensitivityRef& s, MatrixView4py zgc)  { assignOrError(s.zgc, zgc); };
+    auto set_sc   = [](SensitivityRef& s, MatrixView4py sc)   { assignOrError(s.sc, sc); };
+    auto set_xbgc = [](SensitivityRef& s, MatrixView4py xbgc) { assignOrError(s.xbgc, xbgc); };
+    auto set_xhgc = [](SensitivityRef& s, MatrixView4py xhgc) { assignOrError(s.xhgc, xhgc); };
+
+    auto assign = [](SensitivityRef& s, const Sensitivity& other) { s = other; };
+
+    py::class_<SensitivityRef>(m, "SensitivityRef")
+        .def_readonly("dims", &SensitivityRef::dims)
+        .def_property("xc"  , get_xc  , set_xc)
+        .def_property("pc"  , get_pc  , set_pc)
+        .def_property("yec" , get_yec , set_yec)
+        .def_property("ygc" , get_ygc , set_ygc)
+        .def_property("zec" , get_zec , set_zec)
+        .def_property("zgc" , get_zgc , set_zgc)
+        .def_property("sc"  , get_sc  , set_sc)
+        .def_property("xbgc", get_xbgc, set_xbgc)
+        .def_property("xhgc", get_xhgc, set_xhgc)
+        .def("assign", assign)
+        .def("sensitivity", &SensitivityRef::sensitivity)
+        ;
+
+    py::class_<SensitivityBatch>(m, "SensitivityBatch")
+        .def(py::init<>())
+        .def(py::init<const Dims&, Index>())
+        .def(py::init<const Dims&, Index, const std::string&>())
+        .def("dims", &SensitivityBatch::dims)
+        .def("size", &SensitivityBatch::size)
+        .def("__len__", &SensitivityBatch::size)
+        .def("__getitem__", &SensitivityBatch::operator[], py::keep_alive<0, 1>())
+        .def("sensitivity", &SensitivityBatch::sensitivity)
+        .def("xc", &SensitivityBatch::xc, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("pc", &SensitivityBatch::pc, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("yec", &SensitivityBatch::yec, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("ygc", &SensitivityBatch::ygc, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("zec", &SensitivityBatch::zec, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("zgc", &SensitivityBatch::zgc, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("sc", &SensitivityBatch::sc, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("xbgc", &SensitivityBatch::xbgc, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("xhgc", &SensitivityBatch::xhgc, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("mapped", &SensitivityBatch::mapped)
+        .def("flush", &SensitivityBatch::flush)
+        .def("save", &SensitivityBatch::save)
+        ;
+}
@@ -23,16 +23,27 @@
 #include <Optima/Problem.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/Sensitivity.hpp>
+#include <Optima/SensitivityBatch.hpp>
 #include <Optima/Solver.hpp>
 #include <Optima/State.hpp>
+#include <Optima/StateBatch.hpp>
 using namespace Optima;
 
 void exportSolver(py::module& m)
 {
+    // The GIL is released during the calculations, so that the functions of the problem implemented in
+    // Python can be evaluated on worker threads (e.g., when the blocks of a decomposed problem are solved concurrently)
     py::class_<Solver>(m, "Solver")
         .def(py::init<>())
         .def("setOptions", &Solver::setOptions)
-        .def("solve", py::overload_cast<const Problem&, State&>(&Solver::solve))
-        .def("solve", py::overload_cast<const Problem&, State&, Sensitivity&>(&Solver::solve))
+        .def("solve", py::overload_cast<const Problem&, State&>(&Solver::solve), py::call_guard<py::gil_scoped_release>())
+        .def("solve", py::overload_cast<const Problem&, State&, Sensitivity&>(&Solver::solve), py::call_guard<py::gil_scoped_release>())
+        .def("solve", py::overload_cast<const Problem&, StateRef>(&Solver::solve), py::call_guard<py::gil_scoped_release>())
+        .def("solve", py::overload_cast<const Problem&, StateRef, SensitivityRef>(&Solver::solve), py::call_guard<py::gil_scoped_release>())
+        .def("begin", &Solver::begin, py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), py::call_guard<py::gil_scoped_release>())
+        .def("step", &Solver::step, py::call_guard<py::gil_scoped_release>())
+        .def("converged", &Solver::converged)
+        .def("finish", py::overload_cast<>(&Solver::finish), py::call_guard<py::gil_scoped_release>())
+        .def("finish", py::overload_cast<Sensitivity&>(&Solver::finish), py::call_guard<py::gil_scoped_release>())
         ;
 }
@@ -0,0 +1,106 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems.
+//
+// Copyright © 2020-2024 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include "pybind11.hxx"
+
+// Optima includes
+#include <Optima/State.hpp>
+#include <Optima/StateBatch.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+void exportStateBatch(py::module& m)
+{
+    auto get_x   = [](StateRef& s) -> VectorRef { return s.x; };
+    auto get_p   = [](StateRef& s) -> VectorRef { return s.p; };
+    auto get_ye  = [](StateRef& s) -> VectorRef { return s.ye; };
+    auto get_yg  = [](StateRef& s) -> VectorRef { return s.yg; };
+    auto get_ze  = [](StateRef& s) -> VectorRef { return s.ze; };
+    auto get_zg  = [](StateRef& s) -> VectorRef { return s.zg; };
+    auto get_s   = [](StateRef& s) -> VectorRef { return s.s; };
+    auto get_xbg = [](StateRef& s) -> VectorRef { return s.xbg; };
+    auto get_xhg = [](StateRef& s) -> VectorRef { return s.xhg; };
+    auto get_js  = [](StateRef& s) -> Indices { return s.js.view(); };
+    auto get_ju  = [](StateRef& s) -> Indices { return s.ju.view(); };
+    auto get_jlu = [](StateRef& s) -> Indices { return s.jlu.view(); };
+    auto get_juu = [](StateRef& s) -> Indices { return s.juu.view(); };
+    auto get_jb  = [](StateRef& s) -> Indices { return s.jb.view(); };
+    auto get_jn  = [](StateRef& s) -> Indices { return s.jn.view(); };
+
+    auto set_x   = [](StateRef& s, VectorView x)   { assignOrError(s.x, x); };
+    auto set_p   = [](StateRef& s, VectorView p)   { assignOrError(s.p, p); };
+    auto set_ye  = [](StateRef& s, VectorView ye)  { assignOrError(s.ye, ye); };
+    auto set_yg  = [](StateRef& s, VectorView yg)  { assignOrError(s.yg, yg); };
+    auto set_ze  = [](StateRef& s, VectorView ze)  { assignOrError(s.ze, ze); };
+    auto set_zg  = [](StateRef& s, VectorView zg)  { assignOrError(s.zg, zg); };
+    auto set_s   = [](StateRef& s, VectorView sv)  { assignOrError(s.s, sv); };
+    auto set_xbg = [](StateRef& s, VectorView xbg) { assignOrError(s.xbg, xbg); };
+    auto set_xhg = [](StateRef& s, VectorView xhg) { assignOrError(s.xhg, xhg); };
+    auto set_js  = [](StateRef& s, IndicesView js)  { s.js = js; };
+    auto set_ju  = [](StateRef& s, IndicesView ju)  { s.ju = ju; };
+    auto set_jlu = [](StateRef& s, IndicesView jlu) { s.jlu = jlu; };
+    auto set_juu = [](StateRef& s, IndicesView juu) { s.juu = juu; };
+    auto set_jb  = [](StateRef& s, IndicesView jb)  { s.jb = jb; };
+    auto set_jn  = [](StateRef& s, IndicesView jn)  { s.jn = jn; };
+
+    auto assign = [](StateRef& s, const State& other) { s = other; };
+
+    py::class_<StateRef>(m, "StateRef")
+        .def_readonly("dims", &StateRef::dims, "The dimensions of the variables and constraints in the optimization problem.")
+        .def_property("x"  , get_x  , set_x  , "The variables @eq{x} of the optimization problem.")
+        .def_property("p"  , get_p  , set_p  , "The parameter variables @eq{p} of the optimization problem.")
+        .def_property("ye" , get_ye , set_ye , "The Lagrange multipliers @eq{y_{@mathrm{e}} with respect to constraints @eq{A_{@mathrm{ex}}x+A_{@mathrm{ep}}p=b_{@mathrm{e}}}.")
+        .def_property("yg" , get_yg , set_yg , "The Lagrange multipliers @eq{y_{@mathrm{g}} with respect to constraints @eq{A_{@mathrm{gx}}x+A_{@mathrm{gp}}p@geq b_{@mathrm{g}}}.")
+        .def_property("ze" , get_ze , set_ze , "The Lagrange multipliers @eq{z_{@mathrm{e}} with respect to constraints @eq{h_{@mathrm{e}}(x)=0}.")
+        .def_property("zg" , get_zg , set_zg , "The Lagrange multipliers @eq{z_{@mathrm{g}} with respect to constraints @eq{h_{@mathrm{g}}(x)@geq0}.")
+        .def_property("s"  , get_s  , set_s  , "The stability measures of variables @eq{x}.")
+        .def_property("xbg", get_xbg, set_xbg, "The variables @eq{x_{b_{@mathrm{g}}}} in @eq{(x,x_{@mathrm{b_{g}}},x_{@mathrm{h_{g}}})} of the basic optimization problem.")
+        .def_property("xhg", get_xhg, set_xhg, "The variables @eq{x_{h_{@mathrm{g}}}} in @eq{(x,x_{@mathrm{b_{g}}},x_{@mathrm{h_{g}}})} of the basic optimization problem.")
+        .def_property("js" , get_js , set_js , "The indices of the stable variables in *x*.")
+        .def_property("ju" , get_ju , set_ju , "The indices of the unstable variables in *x*.")
+        .def_property("jlu", get_jlu, set_jlu, "The indices of the lower unstable variables in *x*.")
+        .def_property("juu", get_juu, set_juu, "The indices of the upper unstable variables in *x*.")
+        .def_property("jb" , get_jb , set_jb , "The indices of the basic variables in *x*.")
+        .def_property("jn" , get_jn , set_jn , "The indices of the non-basic variables in *x*.")
+        .def("assign", assign, "Assign a State object to this.")
+        .def("state", &StateRef::state, "Return a copy of the state in this view as a State object.")
+        ;
+
+    py::class_<StateBatch>(m, "StateBatch")
+        .def(py::init<>())
+        .def(py::init<const Dims&, Index>())
+        .def(py::init<const Dims&, Index, const std::string&>())
+        .def("dims", &StateBatch::dims)
+        .def("size", &StateBatch::size)
+        .def("__len__", &StateBatch::size)
+        .def("__getitem__", &StateBatch::operator[], py::keep_alive<0, 1>())
+        .def("state", &StateBatch::state)
+        .def("x", &StateBatch::x, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("p", &StateBatch::p, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("ye", &StateBatch::ye, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("yg", &StateBatch::yg, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("ze", &StateBatch::ze, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("zg", &StateBatch::zg, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("s", &StateBatch::s, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("xbg", &StateBatch::xbg, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("xhg", &StateBatch::xhg, PYBIND_ENSURE_MUTUAL_EXISTENCE)
+        .def("mapped", &StateBatch::mapped)
+        .def("flush", &StateBatch::flush)
+        .def("save", &StateBatch::save)
+        ;
+}
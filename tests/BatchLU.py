@@ -0,0 +1,70 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright © 2020-2024 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+
+
+# Tested number of variables in x
+tested_n = [1, 5, 20]
+
+# Tested number of matrices in the batch
+tested_m = [1, 4, 9, 33]
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("m", tested_m)
+def testBatchLU(n, m):
+
+    x = npy.linspace(1, n, n)
+
+    As = []
+    for k in range(m):
+        A = matrix_non_singular(n) + 0.1 * k * npy.eye(n)
+        # Make some of the matrices rank deficient
+        if k % 3 == 1 and n > 2:
+            A[2, :] = 2.0 * A[0, :]
+        As.append(A)
+
+    # The matrices are given in flattened column-major order, one per row
+    A = npy.array([Ak.flatten(order='F') for Ak in As])
+    B = npy.array([Ak @ x for Ak in As])
+
+    lu = BatchLU()
+    lu.decompose(A)
+
+    assert lu.size() == m
+    assert lu.dim() == n
+
+    X = B.copy()
+    lu.solve(X)
+
+    for k in range(m):
+        LUk = LU()
+        LUk.decompose(As[k])
+        xk = npy.zeros(n)
+        LUk.solve(B[k], xk)
+
+        # Same solution of each linear system as that of LU, whether solved with the others or on its own
+        assert_allclose(X[k], xk)
+
+        xk = B[k].copy()
+        lu.solve(k, xk)
+
+        assert_allclose(xk, X[k])
+        assert_allclose(As[k] @ xk, B[k])
@@ -0,0 +1,134 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright © 2020-2024 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+
+
+def testBatchSolver():
+
+    nx, ny, nz, n = 5, 2, 1, 16
+
+    Ax = npy.array([[1.0, 1.0, 1.0, 0.0, 0.0], [0.0, 1.0, 0.0, 1.0, 1.0]])
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f   = npy.sum(x * (npy.log(x) - 1.0))
+        res.fx  = npy.log(x)
+        res.fxx = npy.diag(1.0/x)
+        res.diagfxx = True
+
+    def constraintfn_h(res, x, p, c, opts):
+        res.val = npy.array([x[0]*x[1] - 0.1*x[2]])
+        res.ddx = npy.array([[x[1], x[0], -0.1, 0.0, 0.0]])
+
+    def objectivefn_fbatch(res, X, P, C, opts):
+        batch.fcalls += 1
+        res.f   = npy.sum(X * (npy.log(X) - 1.0), axis=1)
+        res.fx  = npy.log(X)
+        fxx = npy.zeros((X.shape[0], nx*nx))
+        for i in range(nx):
+            fxx[:, i + i*nx] = 1.0/X[:, i]  # column i + j*nx stores fxx(i, j) of every evaluation
+        res.fxx = fxx
+        res.diagfxx = True
+
+    def constraintfn_hbatch(res, X, P, C, opts):
+        res.val = (X[:, 0]*X[:, 1] - 0.1*X[:, 2]).reshape(-1, 1)
+        res.ddx = npy.column_stack([X[:, 1], X[:, 0], npy.full(X.shape[0], -0.1), npy.zeros((X.shape[0], 2))])
+
+    class Batch:
+        fcalls = 0
+
+    batch = Batch()
+
+    dims = Dims()
+    dims.x  = nx
+    dims.be = ny
+    dims.he = nz
+
+    problems = []
+    for k in range(n):
+        problem = Problem(dims)
+        problem.f = objectivefn_f
+        problem.he = constraintfn_h
+        problem.Aex = Ax
+        problem.be = npy.array([1.0 + 0.01*k, 2.0])
+        problem.xlower = npy.full(nx, 1e-12)
+        problems.append(problem)
+
+    # The expected states are those of calculations performed one problem at a time
+    expected = []
+    for problem in problems:
+        state = State(dims)
+        res = Solver().solve(problem, state)
+        assert res.succeeded
+        expected.append((state.x.copy(), res.iterations))
+
+    solver = BatchSolver()
+    solver.setObjectiveFunction(objectivefn_fbatch)
+    solver.setEqualityConstraintFunction(constraintfn_hbatch)
+
+    states = [State(dims) for k in range(n)]
+
+    results = solver.solve(problems, states)
+
+    for res, state, (xexpected, iterations) in zip(results, states, expected):
+        assert res.succeeded
+        assert res.iterations == iterations
+        assert_allclose(state.x, xexpected)
+
+    # The evaluations of the problems have been gathered in batches
+    assert batch.fcalls < sum(iterations for x, iterations in expected)
+
+    # The problems are solved in waves of at most options.batch.width calculations with the same states
+    options = Options()
+    options.batch.width = 5
+
+    solver.setOptions(options)
+
+    class Rows:
+        maxrows = 0
+
+    rows = Rows()
+
+    def objectivefn_fbatch_rows(res, X, P, C, opts):
+        rows.maxrows = max(rows.maxrows, X.shape[0])
+        objectivefn_fbatch(res, X, P, C, opts)
+
+    solver.setObjectiveFunction(objectivefn_fbatch_rows)
+
+    states = [State(dims) for k in range(n)]
+
+    results = solver.solve(problems, states)
+
+    for res, state, (xexpected, iterations) in zip(results, states, expected):
+        assert res.succeeded
+        assert res.iterations == iterations
+        assert_allclose(state.x, xexpected)
+
+    assert rows.maxrows == options.batch.width
+
+    # An exception in a batch function interrupts all calculations and is rethrown
+    def objectivefn_fbatch_failing(res, X, P, C, opts):
+        raise RuntimeError("failed batch evaluation")
+
+    solver.setObjectiveFunction(objectivefn_fbatch_failing)
+
+    states = [State(dims) for k in range(n)]
+
+    with pytest.raises(RuntimeError):
+        solver.solve(problems, states)
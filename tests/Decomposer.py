@@ -0,0 +1,150 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright © 2020-2024 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+
+
+def testDecomposer():
+
+    # The problem has two independent blocks of variables: x[0:4] and x[4:7], in which
+    # the first block has two linear constraints and the second has one linear
+    # and one nonlinear constraint. The Hessian matrix is block diagonal.
+    nx, ny, nz = 7, 3, 1
+
+    Ax = npy.array([
+        [1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0],
+        [0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0],
+        [0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 1.0],
+    ])
+
+    Jx = npy.array([[0.0, 0.0, 0.0, 0.0, 1.0, -1.0, 0.0]])
+
+    H = npy.zeros((nx, nx))
+    H[0:4, 0:4] = npy.array([
+        [2.0, 0.5, 0.0, 0.0],
+        [0.5, 2.0, 0.5, 0.0],
+        [0.0, 0.5, 2.0, 0.5],
+        [0.0, 0.0, 0.5, 2.0],
+    ])
+    H[4:7, 4:7] = npy.array([
+        [3.0, 1.0, 0.0],
+        [1.0, 3.0, 1.0],
+        [0.0, 1.0, 3.0],
+    ])
+
+    cx = npy.linspace(1, nx, nx)
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f   = 0.5 * (x - cx).T @ H @ (x - cx)
+        res.fx  = H @ (x - cx)
+        res.fxx = H
+        res.succeeded = True
+
+    def constraintfn_h(res, x, p, c, opts):
+        res.val = Jx @ x - 0.5
+        res.ddx = Jx
+        res.succeeded = True
+
+    dims = MasterDims(nx, 0, ny, nz)
+
+    problem = MasterProblem()
+    problem.dims = dims
+    problem.f = objectivefn_f
+    problem.h = constraintfn_h
+    problem.Ax = Ax
+    problem.Ap = npy.zeros((ny, 0))
+    problem.b = npy.array([3.0, 1.0, 4.0])
+    problem.xlower = npy.zeros(nx)
+    problem.xupper = npy.full(nx, npy.inf)
+    problem.plower = npy.zeros(0)
+    problem.pupper = npy.zeros(0)
+    problem.phi = None
+
+    # The decomposition uses only declared structures: the non-zero columns of Jx and the blocks of the Hessian matrix
+    problem.h.setNonZeroColumnsDdx([4, 5])
+    problem.f.setBlocksHessian([0, 0, 0, 0, 1, 1, 1])
+
+    u = MasterVector(dims)
+    u.x = npy.ones(nx)
+
+    decomposer = Decomposer()
+
+    # The decomposition is not active by default
+    decomposer.initialize(problem, u)
+
+    assert len(decomposer.blocks()) == 0
+
+    options = DecomposerOptions()
+    options.active = True
+    decomposer.setOptions(options)
+
+    decomposer.initialize(problem, u)
+
+    blocks = decomposer.blocks()
+
+    assert len(blocks) == 2
+    assert_array_equal(blocks[0].jx, [0, 1, 2, 3])
+    assert_array_equal(blocks[0].iy, [0, 1])
+    assert_array_equal(blocks[0].iz, [])
+    assert_array_equal(blocks[1].jx, [4, 5, 6])
+    assert_array_equal(blocks[1].iy, [2])
+    assert_array_equal(blocks[1].iz, [0])
+
+    # The solution with independent blocks is the same as the one of the entire problem
+    solver = MasterSolver()
+
+    state = MasterState()
+    state.u = MasterVector(dims)
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+
+    xexpected = state.u.x.copy()
+    wexpected = state.u.w.copy()
+
+    options = Options()
+    options.decomposer.active = True
+
+    solver.setOptions(options)
+
+    state = MasterState()
+    state.u = MasterVector(dims)
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+    assert_allclose(state.u.x, xexpected)
+    assert_allclose(state.u.w, wexpected)
+
+    # The blocks are also solved concurrently, with evaluations serialized or not
+    for threadsafe in [False, True]:
+        options.decomposer.threads = 2
+        options.decomposer.threadsafe = threadsafe
+
+        solver.setOptions(options)
+
+        state = MasterState()
+        state.u = MasterVector(dims)
+
+        res = solver.solve(problem, state)
+
+        assert res.succeeded
+        assert_allclose(state.u.x, xexpected)
+        assert_allclose(state.u.w, wexpected)
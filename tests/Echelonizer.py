@@ -121,6 +121,16 @@ def check_echelonizer(echelonizer, A):
 
     check_canonical_ordering(echelonizer, weights)
 
+    #---------------------------------------------------------------------------
+    # Alternate the weights so that many swaps are accumulated and the
+    # canonical form is eventually refactorized from matrix A
+    #---------------------------------------------------------------------------
+    for k in range(20):
+        wk = weights if k % 2 == 1 else npy.linspace(1, n, n)
+        echelonizer.updateWithPriorityWeights(wk)
+        check_canonical_form(echelonizer, A)
+        check_canonical_ordering(echelonizer, wk)
+
     #---------------------------------------------------------------------------
     # Check changing ordering of basic and non-basic variables work
     #---------------------------------------------------------------------------
@@ -181,3 +191,86 @@ def testEchelonizer(n, m, assembleA, jfixed):
     Qnew = npy.copy(echelonizer.Q())
 
     assert not npy.array_equal(R, Rnew)
+
+
+@pytest.mark.parametrize("n"        , tested_n)
+@pytest.mark.parametrize("m"        , tested_m)
+@pytest.mark.parametrize("assembleA", tested_assembleA)
+def testEchelonizerHysteresis(n, m, assembleA):
+
+    A = assembleA(m, n, npy.arange(0))
+
+    echelonizer = Echelonizer(A)
+
+    weights = npy.linspace(1, n, n)
+    echelonizer.updateWithPriorityWeights(weights)
+
+    ibasic = set(echelonizer.indicesBasicVariables())
+
+    # With a hysteresis factor above the largest ratio of weights, no swaps should take place
+    options = EchelonizerOptions()
+    options.hysteresis = n + 1.0
+    echelonizer.setOptions(options)
+
+    weights = npy.linspace(n, 1, n)
+    echelonizer.updateWithPriorityWeights(weights)
+
+    assert set(echelonizer.indicesBasicVariables()) == ibasic
+
+    check_canonical_form(echelonizer, A)
+    check_canonical_ordering(echelonizer, weights)
+
+
+@pytest.mark.parametrize("m", [5, 10, 20])
+@pytest.mark.parametrize("nl", [0, 2])
+def testEchelonizerWideMatrix(m, nl):
+
+    # A wide matrix, for which the basic columns are selected with tournament pivoting
+    n = 2000
+
+    A = rng.rand(m, n)
+    A[:, 1::3] = 0.0  # many zero entries, as in formula matrices of chemical systems
+    A[m - nl:, :] = A[:nl, :] + A[1:nl + 1, :]  # the last nl rows are linearly dependent on the others
+
+    echelonizer = Echelonizer(A)
+
+    assert echelonizer.numBasicVariables() == npy.linalg.matrix_rank(A)
+
+    check_canonical_form(echelonizer, A)
+
+    weights = rng.rand(n)
+    echelonizer.updateWithPriorityWeights(weights)
+
+    check_canonical_form(echelonizer, A)
+    check_canonical_ordering(echelonizer, weights)
+
+
+@pytest.mark.parametrize("m", [5, 10, 20])
+def testEchelonizerLeanMode(m):
+
+    n = 200
+
+    A = matrix_with_one_linearly_dependent_row(m, n)
+
+    echelonizer = Echelonizer(A)
+
+    lean = Echelonizer(A)
+    options = EchelonizerOptions()
+    options.lean = True
+    lean.setOptions(options)
+
+    assert lean.memoryFootprint() < echelonizer.memoryFootprint()
+
+    weights = rng.rand(n)
+    lean.updateWithPriorityWeights(weights)
+
+    check_canonical_form(lean, A)
+    check_canonical_ordering(lean, weights)
+
+    # In lean mode, the initial canonical form is recomputed from A on reset
+    lean.reset()
+    echelonizer.reset()
+
+    assert_array_equal(lean.Q(), echelonizer.Q())
+    assert_array_almost_equal(lean.R(), echelonizer.R())
+    assert_array_almost_equal(lean.S(), echelonizer.S())
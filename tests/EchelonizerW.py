@@ -62,3 +62,47 @@ def testMatrixRWQ(nx, np, ny, nz, nl):
     assert_almost_equal(Ibb, R @ W.Wx[:, jb])
     assert_almost_equal(Sbn, R @ W.Wx[:, jn])
     assert_almost_equal(Sbp, R @ W.Wp)
+
+
+@pytest.mark.parametrize("nx", tested_nx)
+@pytest.mark.parametrize("np", tested_np)
+@pytest.mark.parametrize("ny", tested_ny)
+@pytest.mark.parametrize("nz", tested_nz)
+@pytest.mark.parametrize("nl", tested_nl)
+def testMatrixRWQWithConstantJ(nx, np, ny, nz, nl):
+
+    params = MasterParams(nx, np, ny, nz, nl)
+
+    if params.invalid(): return
+
+    dims = params.dims
+
+    W = createMatrixViewW(params)
+
+    echelonizerW = EchelonizerW()
+    echelonizerW.initialize(dims, W.Ax, W.Ap)
+    echelonizerW.update(W.Jx, W.Jp, npy.ones(dims.nx))
+
+    # With Jx and Jp unchanged, only the priority weights are given in the next updates
+    for k in range(5):
+        weights = rng.rand(dims.nx)
+
+        echelonizerW.update(weights)
+
+        RWQ = echelonizerW.RWQ()
+
+        R   = RWQ.R
+        Sbn = RWQ.Sbn
+        Sbp = RWQ.Sbp
+        jb  = RWQ.jb
+        jn  = RWQ.jn
+
+        nb = len(jb)
+
+        Ibb = npy.eye(nb)
+
+        assert_almost_equal(Ibb, R @ W.Wx[:, jb])
+        assert_almost_equal(Sbn, R @ W.Wx[:, jn])
+        assert_almost_equal(Sbp, R @ W.Wp)
+
+        assert all(weights[jb][i] <= weights[jb][i - 1] for i in range(1, nb))
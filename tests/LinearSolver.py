@@ -27,12 +27,14 @@ tested_nz      = [0, 5]            # The tested number of z variables
 tested_nl      = [0, 2]            # The tested number of linearly dependent rows in Ax
 tested_nu      = [0, 2]            # The tested number of unstable variables
 tested_diagHxx = [False, True]     # The tested options for Hxx structure
+tested_Hxx4basicvars = [False, True]  # The tested options for Hxx having non-zero columns only for basic variables
 
 # Tested cases for the linear solver methods
 tested_methods = [
     LinearSolverMethod.Fullspace,
     LinearSolverMethod.Nullspace,
-    LinearSolverMethod.Rangespace
+    LinearSolverMethod.Rangespace,
+    LinearSolverMethod.SparseFullspace
 ]
 
 @pytest.mark.parametrize("nx"     , tested_nx)
@@ -42,10 +44,11 @@ tested_methods = [
 @pytest.mark.parametrize("nl"     , tested_nl)
 @pytest.mark.parametrize("nu"     , tested_nu)
 @pytest.mark.parametrize("diagHxx", tested_diagHxx)
+@pytest.mark.parametrize("Hxx4basicvars", tested_Hxx4basicvars)
 @pytest.mark.parametrize("method" , tested_methods)
-def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
+def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, Hxx4basicvars, method):
 
-    params = MasterParams(nx, np, ny, nz, nl, nu, diagHxx)
+    params = MasterParams(nx, np, ny, nz, nl, nu, diagHxx, Hxx4basicvars)
 
     if params.invalid(): return
 
@@ -56,7 +59,30 @@ def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
 
     M = createMasterMatrix(params)
 
-    nw = params.dims.nw
+    checkLinearSolver(M, method)
+
+    if method == LinearSolverMethod.Rangespace:
+        # Check also the case in which the basic variables are explicit (i.e., with large diagonal entries in Hxx)
+        Hxx = npy.array(M.H.Hxx) * 1e3
+        H = MatrixViewH(Hxx, M.H.Hxp, diagHxx, Hxx4basicvars)
+        M = MasterMatrix(dims, H, M.V, M.W, M.RWQ, M.js, M.ju)
+        checkLinearSolver(M, method)
+
+    if method == LinearSolverMethod.SparseFullspace:
+        # Check also that the sparsity pattern is kept when an entry of Hxx happens to be zero in a subsequent decomposition
+        linearsolver = checkLinearSolver(M, method)
+        Hxx = npy.array(M.H.Hxx)
+        Hxx[0, 0] = 0.0
+        H = MatrixViewH(Hxx, M.H.Hxp, diagHxx, Hxx4basicvars)
+        M = MasterMatrix(dims, H, M.V, M.W, M.RWQ, M.js, M.ju)
+        checkLinearSolver(M, method, linearsolver)
+
+
+def checkLinearSolver(M, method, linearsolver=None):
+
+    dims = M.dims
+
+    nx, np, nw = dims.nx, dims.np, dims.nw
 
     uexp = MasterVector(dims)
     uexp.x = npy.linspace(1, nx, nx)
@@ -72,8 +98,9 @@ def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
     options = LinearSolverOptions()
     options.method = method
 
-    linearsolver = LinearSolver()
-    linearsolver.setOptions(options)
+    if linearsolver is None:
+        linearsolver = LinearSolver()
+        linearsolver.setOptions(options)
 
     u = MasterVector(dims)
 
@@ -85,3 +112,5 @@ def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
     ju = M.ju  # the indices of the unstable variables in x
 
     assert all(u.x[ju] == a.x[ju])  # ensure ux[ju] == ax[ju]
+
+    return linearsolver
@@ -38,7 +38,7 @@ tested_diagHxx = [False, True]    # The tested diagonal structure of Hxx matrix
 @pytest.mark.parametrize("nul"    , tested_nul)
 @pytest.mark.parametrize("nuu"    , tested_nuu)
 @pytest.mark.parametrize("diagHxx", tested_diagHxx)
-def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
+def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx, tmp_path):
 
     nw = ny + nz
 
@@ -137,7 +137,7 @@ def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
 
     options = Options()
     options.output.active = True
-    options.output.filename = f"output-mastersolver-nx={nx}-np={np}-ny={ny}-nz={nz}-nl={nl}-nul={nul}-nuu={nuu}-diagHxx={diagHxx}.txt"
+    options.output.filename = str(tmp_path / f"output-mastersolver-nx={nx}-np={np}-ny={ny}-nz={nz}-nl={nl}-nul={nul}-nuu={nuu}-diagHxx={diagHxx}.txt")
 
     options.newtonstep.linearsolver.method = \
         LinearSolverMethod.Rangespace if diagHxx else \
@@ -177,3 +177,211 @@ def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
     res = solver.solve(problem, state, sensitivity)
 
     assert res.succeeded
+
+    #---------------------------------------------------------------------------
+    # Check the solver also converges with the residual-only line search active
+    #---------------------------------------------------------------------------
+    options.linesearch.active = True
+
+    solver.setOptions(options)
+
+    state = MasterState()
+    state.u = MasterVector(dims)
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+
+    xexpected = state.u.x.copy()
+
+    #---------------------------------------------------------------------------
+    # Check the solver converges to the same solution with the line search performed
+    # in every iteration with trial step lengths, evaluated one after another and on
+    # worker threads (the functions in Python are then called with the GIL acquired)
+    #---------------------------------------------------------------------------
+    options.linesearch.parallel_trials = 4
+    options.linesearch.trigger_when_current_error_is_greater_than_initial_error_by_factor = 0.0
+    options.linesearch.trigger_when_current_error_is_greater_than_previous_error_by_factor = 0.0
+
+    for threadsafe in [False, True]:
+        options.linesearch.threadsafe = threadsafe
+
+        solver.setOptions(options)
+
+        state = MasterState()
+        state.u = MasterVector(dims)
+
+        res = solver.solve(problem, state)
+
+        assert res.succeeded
+        assert_allclose(state.u.x, xexpected, rtol=1e-6, atol=1e-6)
+
+    options.linesearch = LineSearchOptions()
+
+    #---------------------------------------------------------------------------
+    # Check the solver converges to the same solution with the master problem scaled
+    #---------------------------------------------------------------------------
+    options.linesearch.active = False
+    options.scaler.active = True
+
+    solver.setOptions(options)
+
+    state = MasterState()
+    state.u = MasterVector(dims)
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+    assert_allclose(state.u.x, xexpected, rtol=1e-6, atol=1e-6)
+
+
+def testMasterSolverFailureReasons():
+
+    nx, ny = 4, 2
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f   = 0.5 * x.T @ x
+        res.fx  = x
+        res.fxx = npy.eye(nx)
+        res.succeeded = True
+
+    dims = MasterDims(nx, 0, ny, 0)
+
+    problem = MasterProblem()
+    problem.dims = dims
+    problem.f = objectivefn_f
+    problem.Ax = npy.ones((ny, nx))
+    problem.Ap = npy.zeros((ny, 0))
+    problem.xlower = npy.zeros(nx)
+    problem.xupper = npy.full(nx, npy.inf)
+    problem.plower = npy.zeros(0)
+    problem.pupper = npy.zeros(0)
+    problem.phi = None
+
+    solver = MasterSolver()
+
+    def solve(b):
+        problem.b = b
+        state = MasterState()
+        state.u = MasterVector(dims)
+        return solver.solve(problem, state)
+
+    res = solve(npy.array([1.0, 1.0]))
+
+    assert res.succeeded
+    assert res.failure_reason == ""
+
+    # The linear equality constraints are inconsistent, so no iteration is performed
+    res = solve(npy.array([1.0, 2.0]))
+
+    assert not res.succeeded
+    assert res.failure_reason == "infeasibility"
+    assert res.iterations == 0
+
+    # The linear equality constraints cannot be satisfied with x >= 0, so the calculation runs until the maximum number of iterations
+    res = solve(npy.array([-1.0, -1.0]))
+
+    assert not res.succeeded
+    assert res.failure_reason == "maxiters"
+
+    # The error stagnates in the same calculation, which stops earlier when the detection of stagnation is enabled
+    options = Options()
+    options.convergence.stagnation_iterations = 50
+
+    solver.setOptions(options)
+
+    res = solve(npy.array([-1.0, -1.0]))
+
+    assert not res.succeeded
+    assert res.failure_reason == "stagnation"
+    assert res.iterations < options.maxiters
+
+    # The calculation is cancelled before it starts, so no iteration is performed
+    options = Options()
+    options.cancellation.cancel()
+
+    solver.setOptions(options)
+
+    res = solve(npy.array([1.0, 1.0]))
+
+    assert not res.succeeded
+    assert res.failure_reason == "cancelled"
+    assert res.iterations == 0
+
+    options.cancellation.reset()
+
+    res = solve(npy.array([1.0, 1.0]))
+
+    assert res.succeeded
+
+
+def testMasterSolverStepper():
+
+    nx, ny = 4, 2
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f   = 0.5 * x.T @ x
+        res.fx  = x
+        res.fxx = npy.eye(nx)
+        res.succeeded = True
+
+    dims = MasterDims(nx, 0, ny, 0)
+
+    def createProblem(b):
+        problem = MasterProblem()
+        problem.dims = dims
+        problem.f = objectivefn_f
+        problem.Ax = npy.array([[1.0, 1.0, 0.0, 0.0], [0.0, 0.0, 1.0, 1.0]])
+        problem.Ap = npy.zeros((ny, 0))
+        problem.b = b
+        problem.xlower = npy.zeros(nx)
+        problem.xupper = npy.full(nx, npy.inf)
+        problem.plower = npy.zeros(0)
+        problem.pupper = npy.zeros(0)
+        problem.phi = None
+        return problem
+
+    problems = [createProblem(npy.array([1.0, 2.0])), createProblem(npy.array([3.0, 4.0]))]
+
+    # The expected states are those of calculations performed with solve
+    expected = []
+    for problem in problems:
+        state = MasterState()
+        state.u = MasterVector(dims)
+        res = MasterSolver().solve(problem, state)
+        assert res.succeeded
+        expected.append((state.u.x.copy(), res.iterations))
+
+    # The calculations advanced one iteration at a time in an interleaved way should produce the same states
+    solvers = [MasterSolver(), MasterSolver()]
+    states = [MasterState(), MasterState()]
+
+    for solver, problem, state in zip(solvers, problems, states):
+        state.u = MasterVector(dims)
+        solver.begin(problem, state)
+
+    running = [True, True]
+    while any(running):
+        for k, solver in enumerate(solvers):
+            if running[k]:
+                running[k] = solver.step()
+
+    for solver, state, (xexpected, iterations) in zip(solvers, states, expected):
+        assert solver.converged()
+        res = solver.finish()
+        assert res.succeeded
+        assert res.iterations == iterations
+        assert_allclose(state.u.x, xexpected)
+
+    # The calculation ended before convergence is reported as cancelled
+    state = MasterState()
+    state.u = MasterVector(dims)
+
+    solver = MasterSolver()
+    solver.begin(problems[0], state)
+
+    res = solver.finish()
+
+    assert not solver.converged()
+    assert not res.succeeded
+    assert res.failure_reason == "cancelled"
@@ -0,0 +1,80 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright © 2020-2024 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+
+
+def testPresolver():
+
+    # The linear equality constraints Aex*x = be, in which:
+    #  - the first row determines x[0] (singleton row);
+    #  - the second row, with x >= 0, forces x[1] = x[2] = 0 (bound tightening);
+    #  - the fourth row is linearly dependent on the third (redundant row).
+    Aex = npy.array([
+        [2.0, 0.0, 0.0, 0.0, 0.0, 0.0],
+        [0.0, 1.0, 1.0, 0.0, 0.0, 0.0],
+        [0.0, 0.0, 0.0, 1.0, 1.0, 1.0],
+        [0.0, 0.0, 0.0, 2.0, 2.0, 2.0],
+    ])
+    Aep = npy.zeros((4, 0))
+    be = npy.array([4.0, 0.0, 3.0, 6.0])
+
+    xlower = npy.zeros(6)
+    xupper = npy.full(6, npy.inf)
+
+    xlower[4] = xupper[4] = 1.0  # x[4] is fixed by its bounds
+
+    presolver = Presolver()
+
+    # The presolve stage is not active by default
+    presolver.update(Aex, Aep, be, xlower, xupper)
+
+    assert not presolver.reduced()
+    assert_array_equal(presolver.status().jx, range(6))
+    assert_array_equal(presolver.status().ie, range(4))
+
+    options = PresolverOptions()
+    options.active = True
+    presolver.setOptions(options)
+
+    presolver.update(Aex, Aep, be, xlower, xupper)
+
+    assert presolver.reduced()
+
+    status = presolver.status()
+
+    xf = dict(zip(status.jf, status.xf))
+
+    assert_array_equal(status.jx, [3, 5])
+    assert set(status.jf) == {0, 1, 2, 4}
+    assert xf[0] == approx(2.0)
+    assert xf[1] == approx(0.0)
+    assert xf[2] == approx(0.0)
+    assert xf[4] == approx(1.0)
+    assert len(status.ie) == 1
+    assert status.ie[0] in [2, 3]
+    assert status.xupper[3] == approx(2.0)  # tightened from x[3] + x[5] = 2
+    assert status.xupper[5] == approx(2.0)
+
+    # An inconsistent redundant row is not removed
+    be[3] = 7.0
+
+    presolver.update(Aex, Aep, be, xlower, xupper)
+
+    assert {2, 3} <= set(presolver.status().ie)
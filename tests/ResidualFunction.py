@@ -77,7 +77,10 @@ def testResidualFunction(nx, np, ny, nz, nl, nu, b1, b2, b3, b4, b5, b6, b7):
 
     cx[ju] = +1.0e4  # large positive number to ensure the variables with ju indices are indeed unstable!
 
+    numcalls = [0]  # the number of calls to the objective function
+
     def objectivefn_f(res, x, p, c, opts):
+        numcalls[0] += 1
         res.f   = 0.5 * (x.T @ Hxx @ x) + x.T @ Hxp @ p + cx.T @ x
         res.fx  = Hxx @ x + Hxp @ p + cx
         res.fxx = Hxx
@@ -175,3 +178,62 @@ def testResidualFunction(nx, np, ny, nz, nl, nu, b1, b2, b3, b4, b5, b6, b7):
 
     assert result.stabilitystatus.s == approx(g + Wx.T @ w)
 
+    #---------------------------------------------------------------------------
+    # Check that updates in which some stages are skipped because their inputs
+    # did not change (e.g., only w changes, or u does not change at all)
+    # produce the same result as a newly initialized residual function
+    #---------------------------------------------------------------------------
+    u.w = rng.rand(dims.nw)
+
+    F.update(u)
+    F.update(u)
+
+    Fnew = ResidualFunction()
+    Fnew.initialize(problem)
+    Fnew.update(u)
+
+    result = F.result()
+    resultnew = Fnew.result()
+
+    assert result.Fm.array() == approx(resultnew.Fm.array())
+    assert result.stabilitystatus.s == approx(resultnew.stabilitystatus.s)
+    assert set(result.Jm.js) == set(resultnew.Jm.js)
+
+    #---------------------------------------------------------------------------
+    # Check that evaluations at the same (x, p) as one of the last two
+    # evaluations are reused without calling the model functions again
+    #---------------------------------------------------------------------------
+    options = ResidualFunctionOptions()
+    options.evalcachesize = 2
+    F.setOptions(options)
+
+    uold = MasterVector(u)
+
+    F.update(uold)
+
+    u.x = (problem.xlower + problem.xupper) * 0.25
+
+    numcalls[0] = 0
+
+    F.update(u)     # evaluated at the new point
+    F.update(uold)  # reused from the evaluation cache
+    F.update(u)     # reused from the evaluation cache
+
+    assert numcalls[0] == 1
+
+    result = F.result()
+
+    Fnew.update(u)
+
+    resultnew = Fnew.result()
+
+    assert result.Fm.array() == approx(resultnew.Fm.array())
+
+    options.evalcachesize = 0
+    F.setOptions(options)
+
+    numcalls[0] = 0
+
+    F.update(u)
+
+    assert numcalls[0] == 1
@@ -37,7 +37,7 @@ tested_diagHxx = [False, True]    # The tested diagonal structure of Hxx matrix
 @pytest.mark.parametrize("nul"    , tested_nul)
 @pytest.mark.parametrize("nuu"    , tested_nuu)
 @pytest.mark.parametrize("diagHxx", tested_diagHxx)
-def testSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
+def testSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx, tmp_path):
 
     nw = ny + nz
 
@@ -190,7 +190,7 @@ def testSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
 
     options = Options()
     options.output.active = True
-    options.output.filename = f"output-solver-nx={nx}-np={np}-ny={ny}-nz={nz}-nl={nl}-nul={nul}-nuu={nuu}-diagHxx={diagHxx}.txt"
+    options.output.filename = str(tmp_path / f"output-solver-nx={nx}-np={np}-ny={ny}-nz={nz}-nl={nl}-nul={nul}-nuu={nuu}-diagHxx={diagHxx}.txt")
 
     options.newtonstep.linearsolver.method = \
         LinearSolverMethod.Rangespace if diagHxx else \
@@ -222,3 +222,127 @@ def testSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
 
     assert_array_almost_equal(Ax @ xc + Ap @ pc, bec)
 
+
+    #---------------------------------------------------------------------------
+    # Check the presolve stage produces the same solution and sensitivities
+    #---------------------------------------------------------------------------
+    options.presolver.active = True
+    solver.setOptions(options)
+
+    statepre = State(dims)
+    sensitivitypre = Sensitivity()
+
+    res = solver.solve(problem, statepre, sensitivitypre)
+
+    assert res.succeeded
+
+    assert_array_almost_equal(statepre.x, state.x)
+    assert_array_almost_equal(Ax @ sensitivitypre.xc + Ap @ sensitivitypre.pc, bec)
+
+
+def testSolverWithImpliedBounds():
+
+    # The solution of min 0.5*||x - xt||**2 subject to x0 + x1 = c, 0 <= x0 <= 1 and x1, x2 >= 0 is x = (1, c - 1, 1).
+    # Variable x1 lies on its lower bound x1 >= c - 1 implied by the linear equality constraint, which must not
+    # be imposed as an actual bound by the presolve stage: x1 is stable and it is x0 that is on its upper bound.
+    xt = npy.array([3.0, -1.0, 1.0])
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f = 0.5 * npy.sum((x - xt)**2)
+        res.fx = x - xt
+        res.fxx = npy.eye(3)
+        res.diagfxx = True
+
+    dims = Dims()
+    dims.x  = 3
+    dims.be = 1
+    dims.c  = 1
+
+    problem = Problem(dims)
+    problem.f = objectivefn_f
+    problem.Aex = npy.array([[1.0, 1.0, 0.0]])
+    problem.be = npy.array([2.0])
+    problem.bec = npy.array([[1.0]])
+    problem.c = npy.array([2.0])
+    problem.xlower = npy.zeros(3)
+    problem.xupper = npy.array([1.0, npy.inf, npy.inf])
+
+    for active in [False, True]:
+        options = Options()
+        options.presolver.active = active
+
+        solver = Solver()
+        solver.setOptions(options)
+
+        state = State(dims)
+        state.x = npy.full(3, 0.5)
+
+        sensitivity = Sensitivity()
+
+        res = solver.solve(problem, state, sensitivity)
+
+        assert res.succeeded
+        assert_array_almost_equal(state.x, [1.0, 1.0, 1.0])
+        assert_array_almost_equal(state.s, [-4.0, 0.0, 0.0])
+        assert_array_almost_equal(sensitivity.xc, [[0.0], [1.0], [0.0]])
+
+
+def testSolverWithPresolveAndConcurrentTrials():
+
+    # The solution of min sum(x*(log(x) - 1)) subject to sum(x) = 2 and 2*x1 = 0.4, with x3 fixed at 0.05, is
+    # computed with the presolve stage eliminating x1 and x3 and with trial step lengths in every line search,
+    # evaluated one after another and concurrently, so that the functions of the reduced problem are called
+    # from several threads at once.
+    n = 6
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f = npy.sum(x * (npy.log(x) - 1.0))
+        res.fx = npy.log(x)
+        res.fxx = npy.diag(1.0 / x)
+        res.diagfxx = True
+
+    dims = Dims()
+    dims.x  = n
+    dims.be = 2
+    dims.c  = 1
+
+    problem = Problem(dims)
+    problem.f = objectivefn_f
+    problem.Aex = npy.array([npy.ones(n), [0.0, 2.0, 0.0, 0.0, 0.0, 0.0]])
+    problem.be = npy.array([2.0, 0.4])
+    problem.bec = npy.array([[1.0], [0.0]])
+    problem.c = npy.array([2.0])
+    problem.xlower = npy.full(n, 1e-14)
+    problem.xupper = npy.full(n, npy.inf)
+    problem.xlower[3] = problem.xupper[3] = 0.05
+
+    xexpected = npy.full(n, (2.0 - 0.2 - 0.05) / (n - 2))
+    xexpected[1] = 0.2
+    xexpected[3] = 0.05
+
+    xcexpected = npy.full((n, 1), 1.0 / (n - 2))
+    xcexpected[1] = xcexpected[3] = 0.0
+
+    options = Options()
+    options.presolver.active = True
+    options.linesearch.active = True
+    options.linesearch.parallel_trials = 4
+    options.linesearch.trigger_when_current_error_is_greater_than_initial_error_by_factor = 0.0
+    options.linesearch.trigger_when_current_error_is_greater_than_previous_error_by_factor = 0.0
+
+    for threadsafe in [False, True]:
+        options.linesearch.threadsafe = threadsafe
+
+        solver = Solver()
+        solver.setOptions(options)
+
+        state = State(dims)
+        state.x = npy.full(n, 0.3)
+
+        sensitivity = Sensitivity()
+
+        res = solver.solve(problem, state, sensitivity)
+
+        assert res.succeeded
+        assert_array_almost_equal(state.x, xexpected)
+        assert_array_almost_equal(sensitivity.xc, xcexpected)
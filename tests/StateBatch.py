@@ -0,0 +1,96 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright © 2020-2024 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+
+
+def testStateBatch(tmp_path):
+
+    nx, ny, nz, n = 5, 2, 1, 4
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f   = npy.sum(x * (npy.log(x) - 1.0))
+        res.fx  = npy.log(x)
+        res.fxx = npy.diag(1.0/x)
+        res.diagfxx = True
+
+    def constraintfn_h(res, x, p, c, opts):
+        res.val = npy.array([x[0]*x[1] - 0.1*x[2]])
+        res.ddx = npy.array([[x[1], x[0], -0.1, 0.0, 0.0]])
+
+    dims = Dims()
+    dims.x  = nx
+    dims.be = ny
+    dims.he = nz
+    dims.c  = ny
+
+    problems = []
+    for k in range(n):
+        problem = Problem(dims)
+        problem.f = objectivefn_f
+        problem.he = constraintfn_h
+        problem.Aex = npy.array([[1.0, 1.0, 1.0, 0.0, 0.0], [0.0, 1.0, 0.0, 1.0, 1.0]])
+        problem.be = npy.array([1.0 + 0.1*k, 2.0])
+        problem.bec = npy.eye(ny)
+        problem.xlower = npy.full(nx, 1e-12)
+        problems.append(problem)
+
+    states = StateBatch(dims, n)
+    sensitivities = SensitivityBatch(dims, n)
+
+    assert len(states) == n
+
+    for k in range(n):
+        state = State(dims)
+        sensitivity = Sensitivity()
+        res = Solver().solve(problems[k], state, sensitivity)
+
+        assert res.succeeded
+
+        # The calculation reads from and writes to the cell of the batch directly
+        res = Solver().solve(problems[k], states[k], sensitivities[k])
+
+        assert res.succeeded
+
+        assert_allclose(states[k].x, state.x)
+        assert_allclose(states[k].ye, state.ye)
+        assert_allclose(states[k].s, state.s)
+        assert_array_equal(states[k].js, state.js)
+        assert_array_equal(states[k].jb, state.jb)
+        assert_allclose(sensitivities[k].xc, sensitivity.xc)
+
+        # The field of all cells is viewed as a matrix with one column per cell
+        assert_allclose(states.x()[:, k], state.x)
+
+    # The batch saved to a file is mapped in memory with the same contents
+    filename = str(tmp_path / "states.bin")
+
+    states.save(filename)
+
+    mapped = StateBatch(dims, n, filename)
+
+    assert mapped.mapped()
+    assert_allclose(mapped.x(), states.x())
+    assert_array_equal(mapped[n - 1].jb, states[n - 1].jb)
+
+    # The calculations of the batch solver write to the cells of the mapped batch directly
+    results = BatchSolver().solve(problems, mapped)
+
+    assert all(res.succeeded for res in results)
+    assert_allclose(mapped.x(), states.x())
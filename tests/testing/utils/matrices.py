@@ -21,7 +21,7 @@ from testing.optima import *
 class MasterParams:
     """Store the parameters used in tests involving master variables"""
 
-    def __init__(self, nx, np, ny, nz, nl=0, nu=0, diagHxx=False):
+    def __init__(self, nx, np, ny, nz, nl=0, nu=0, diagHxx=False, Hxx4basicvars=False):
         """Initialize the parameters used to test library components involving master variables
 
         Args:
@@ -32,6 +32,7 @@ class MasterParams:
             nl (int, optional): The number of linearly dependent rows in Ax. Defaults to 0
             nu (int, optional): The number of unstable variables among non-basic variables. Defaults to 0
             diagHxx (bool, optional): The flag indicating whether Hxx is diagonal. Defaults to False
+            Hxx4basicvars (bool, optional): The flag indicating whether Hxx is non-zero only on columns of basic variables. Defaults to False
         """
         self.nx = nx
         self.np = np
@@ -40,6 +41,7 @@ class MasterParams:
         self.nl = nl
         self.nu = nu
         self.diagHxx = diagHxx
+        self.Hxx4basicvars = Hxx4basicvars
         self.dims = MasterDims(nx, np, ny, nz)
 
 
@@ -195,6 +197,11 @@ def createMasterMatrix(params):
     js = jsu.stable()
     ju = jsu.unstable()
 
+    if params.Hxx4basicvars:
+        Hxx = npy.array(H.Hxx)
+        Hxx[:, RWQ.jn] = 0.0  # set to zero the columns of Hxx corresponding to non-basic variables
+        H = MatrixViewH(Hxx, H.Hxp, params.diagHxx, True)
+
     return MasterMatrix(dims, H, V, W, RWQ, js, ju)
 
 